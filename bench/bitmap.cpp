@@ -1,7 +1,9 @@
 #include <cmath>
+#include <iterator>
 #include <benchmark/benchmark.h>
 #include <rect.h>
 #include <bitmap.h>
+#include <bitmap_pool.h>
 #include <pixel_format.h>
 #include <transform.h>
 
@@ -82,6 +84,26 @@ static void BM_Create(benchmark::State& state) {
 
 BENCHMARK(BM_Create);
 
+static void BM_CreateDestroyWindows(benchmark::State& state) {
+	Bitmap::SetFormat(format);
+	// Sizes of a window opening: background, frame and contents
+	const std::pair<int, int> sizes[] = { { 320, 80 }, { 320, 80 }, { 304, 64 }, { 320, 240 }, { 304, 224 } };
+	BitmapPool::Clear();
+	auto start = BitmapPool::GetStats();
+	for (auto _: state) {
+		BitmapRef bms[std::size(sizes)];
+		for (size_t i = 0; i < std::size(sizes); ++i) {
+			bms[i] = Bitmap::Create(sizes[i].first, sizes[i].second);
+		}
+	}
+	auto stats = BitmapPool::GetStats();
+	state.counters["allocations"] = stats.allocations - start.allocations;
+	state.counters["reused"] = stats.reused - start.reused;
+	state.SetItemsProcessed(state.iterations() * std::size(sizes));
+}
+
+BENCHMARK(BM_CreateDestroyWindows);
+
 static void BM_Blit(benchmark::State& state) {
 	Bitmap::SetFormat(format);
 	auto dest = Bitmap::Create(320, 240);
@@ -106,6 +128,30 @@ static void BM_BlitFast(benchmark::State& state) {
 
 BENCHMARK(BM_BlitFast);
 
+static void BM_BlitCharset(benchmark::State& state) {
+	Bitmap::SetFormat(format);
+	auto dest = Bitmap::Create(320, 240);
+	auto src = Bitmap::Create(288, 256);
+	// Opaque figure in the middle of every cell, transparent around it
+	for (int y = 0; y < 256; y += 32) {
+		for (int x = 0; x < 288; x += 24) {
+			src->FillRect(Rect{ x + 4, y + 6, 16, 24 }, Color(255, 0, 0, 255));
+		}
+	}
+	if (state.range(0)) {
+		src->CheckPixels(Bitmap::Flag_ReadOnly);
+	}
+	for (auto _: state) {
+		for (int y = 0; y < 256; y += 32) {
+			for (int x = 0; x < 288; x += 24) {
+				dest->Blit(x, y / 2, *src, Rect{ x, y, 24, 32 }, opacity);
+			}
+		}
+	}
+}
+
+BENCHMARK(BM_BlitCharset)->Arg(0)->Arg(1);
+
 static void BM_TiledBlit(benchmark::State& state) {
 	Bitmap::SetFormat(format);
 	auto dest = Bitmap::Create(320, 240);
@@ -264,6 +310,26 @@ static void BM_HueChangeBlit(benchmark::State& state) {
 
 BENCHMARK(BM_HueChangeBlit);
 
+static void BM_HueChangeBlitMonster(benchmark::State& state) {
+	Bitmap::SetFormat(format);
+	auto dest = Bitmap::Create(320, 240);
+	auto src = Bitmap::Create(320, 240);
+	// Opaque figure with a palette of 256 colors on a transparent background
+	for (int y = 20; y < 220; ++y) {
+		for (int x = 40; x < 280; ++x) {
+			int i = (x / 4 + y / 4) % 256;
+			src->FillRect(Rect(x, y, 1, 1), Color(i, (i * 7) & 0xFF, (i * 13) & 0xFF, 255));
+		}
+	}
+	auto rect = src->GetRect();
+	double hue = 90.0;
+	for (auto _: state) {
+		dest->HueChangeBlit(0, 0, *src, rect, hue);
+	}
+}
+
+BENCHMARK(BM_HueChangeBlitMonster);
+
 static void BM_ToneBlit(benchmark::State& state) {
 	Bitmap::SetFormat(format);
 	auto dest = Bitmap::Create(320, 240);
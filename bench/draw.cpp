@@ -7,6 +7,8 @@
 #include <drawable_list.h>
 #include <drawable_mgr.h>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 constexpr int num_sprites = 5000;
 
@@ -45,4 +47,54 @@ static void BM_DrawSortLocality(benchmark::State& state) {
 
 BENCHMARK(BM_DrawSortLocality);
 
+constexpr int num_chara_sprites = 500;
+
+class BatchSprite : public Sprite {
+	public:
+		bool GetBatchBlit(BatchBlit& blit) override { return GetPlainBlit(blit); }
+};
+
+template <typename T>
+static void DrawCharaSprites(benchmark::State& state) {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	auto dst = Bitmap::Create(320, 240);
+	auto charset = Bitmap::Create(288, 256);
+	for (int y = 0; y < 256; y += 32) {
+		for (int x = 0; x < 288; x += 24) {
+			charset->FillRect(Rect{ x + 4, y + 6, 16, 24 }, Color(255, 0, 0, 255));
+		}
+	}
+	charset->CheckPixels(Bitmap::Flag_ReadOnly);
+
+	DrawableList list;
+	DrawableMgr::SetLocalList(&list);
+
+	std::vector<std::unique_ptr<T>> sprites;
+	for (int i = 0; i < num_chara_sprites; ++i) {
+		auto sprite = std::make_unique<T>();
+		sprite->SetBitmap(charset);
+		sprite->SetSrcRect(Rect{ (i % 12) * 24, (i / 12 % 8) * 32, 24, 32 });
+		sprite->SetX((i * 37) % 320);
+		sprite->SetY((i * 23) % 240);
+		sprite->SetOpacity(state.range(0) ? 255 : 160);
+		sprites.push_back(std::move(sprite));
+	}
+
+	for (auto _: state) {
+		list.Draw(*dst);
+	}
+}
+
+static void BM_DrawCharaSprites(benchmark::State& state) {
+	DrawCharaSprites<Sprite>(state);
+}
+
+BENCHMARK(BM_DrawCharaSprites)->Arg(0)->Arg(1);
+
+static void BM_DrawCharaSpritesBatched(benchmark::State& state) {
+	DrawCharaSprites<BatchSprite>(state);
+}
+
+BENCHMARK(BM_DrawCharaSpritesBatched)->Arg(0)->Arg(1);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,174 @@
+#include <cstring>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <png.h>
+#include <zlib.h>
+#include <bitmap.h>
+#include <pixel_format.h>
+
+// Images of the size of a RPG Maker picture, generated once
+constexpr int width = 320;
+constexpr int height = 240;
+
+static std::vector<uint8_t> MakeIndices() {
+	std::vector<uint8_t> indices(width * height);
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			// Transparent border around a figure
+			bool inside = x > 40 && x < 280 && y > 20 && y < 220;
+			indices[x + y * width] = inside ? static_cast<uint8_t>(1 + (x / 4 + y / 4) % 255) : 0;
+		}
+	}
+	return indices;
+}
+
+static std::vector<uint8_t> MakePalette() {
+	std::vector<uint8_t> palette(256 * 3);
+	for (int i = 0; i < 256 * 3; ++i) {
+		palette[i] = static_cast<uint8_t>(i * 7);
+	}
+	return palette;
+}
+
+static std::vector<uint8_t> MakeXyz() {
+	std::vector<uint8_t> raw = MakePalette();
+	auto indices = MakeIndices();
+	raw.insert(raw.end(), indices.begin(), indices.end());
+
+	uLongf size = compressBound(raw.size());
+	std::vector<uint8_t> data(8 + size);
+	memcpy(data.data(), "XYZ1", 4);
+	data[4] = width & 0xFF;
+	data[5] = width >> 8;
+	data[6] = height & 0xFF;
+	data[7] = height >> 8;
+	compress(&data[8], &size, raw.data(), raw.size());
+	data.resize(8 + size);
+	return data;
+}
+
+static std::vector<uint8_t> MakeBmp() {
+	auto put_4 = [](std::vector<uint8_t>& v, uint32_t x) {
+		for (int i = 0; i < 4; ++i) {
+			v.push_back((x >> (i * 8)) & 0xFF);
+		}
+	};
+	auto put_2 = [](std::vector<uint8_t>& v, uint16_t x) {
+		v.push_back(x & 0xFF);
+		v.push_back(x >> 8);
+	};
+
+	const uint32_t offset = 14 + 40 + 256 * 4;
+	std::vector<uint8_t> data = { 'B', 'M' };
+	put_4(data, offset + width * height);
+	put_4(data, 0);
+	put_4(data, offset);
+
+	put_4(data, 40);
+	put_4(data, width);
+	put_4(data, height);
+	put_2(data, 1);
+	put_2(data, 8);
+	put_4(data, 0);
+	put_4(data, width * height);
+	put_4(data, 0);
+	put_4(data, 0);
+	put_4(data, 256);
+	put_4(data, 0);
+
+	auto palette = MakePalette();
+	for (int i = 0; i < 256; ++i) {
+		data.push_back(palette[i * 3 + 2]);
+		data.push_back(palette[i * 3 + 1]);
+		data.push_back(palette[i * 3]);
+		data.push_back(0);
+	}
+
+	// Bottom-up rows
+	auto indices = MakeIndices();
+	for (int y = height - 1; y >= 0; --y) {
+		data.insert(data.end(), indices.begin() + y * width, indices.begin() + (y + 1) * width);
+	}
+	return data;
+}
+
+static void WriteData(png_structp png_ptr, png_bytep data, png_size_t length) {
+	auto* out = reinterpret_cast<std::vector<uint8_t>*>(png_get_io_ptr(png_ptr));
+	out->insert(out->end(), data, data + length);
+}
+
+static std::vector<uint8_t> MakePng(bool paletted) {
+	std::vector<uint8_t> data;
+
+	png_structp png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+	png_infop info_ptr = png_create_info_struct(png_ptr);
+	png_set_write_fn(png_ptr, &data, WriteData, nullptr);
+
+	auto indices = MakeIndices();
+	auto palette = MakePalette();
+
+	std::vector<uint8_t> pixels;
+	if (paletted) {
+		png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_PALETTE,
+			PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+		png_set_PLTE(png_ptr, info_ptr, reinterpret_cast<png_colorp>(palette.data()), 256);
+		pixels = indices;
+	} else {
+		png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_RGB_ALPHA,
+			PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+		for (auto idx: indices) {
+			pixels.push_back(palette[idx * 3]);
+			pixels.push_back(palette[idx * 3 + 1]);
+			pixels.push_back(palette[idx * 3 + 2]);
+			pixels.push_back(idx == 0 ? 0 : 255 - idx / 2);
+		}
+	}
+
+	const int pitch = paletted ? width : width * 4;
+	std::vector<png_bytep> rows;
+	for (int y = 0; y < height; ++y) {
+		rows.push_back(&pixels[y * pitch]);
+	}
+
+	png_write_info(png_ptr, info_ptr);
+	png_write_image(png_ptr, rows.data());
+	png_write_end(png_ptr, nullptr);
+	png_destroy_write_struct(&png_ptr, &info_ptr);
+
+	return data;
+}
+
+static void Decode(benchmark::State& state, const std::vector<uint8_t>& data) {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	for (auto _: state) {
+		auto bm = Bitmap::Create(data.data(), data.size(), true);
+		benchmark::DoNotOptimize(bm);
+	}
+	state.SetBytesProcessed(state.iterations() * width * height * 4);
+}
+
+static void BM_DecodeXYZ(benchmark::State& state) {
+	Decode(state, MakeXyz());
+}
+
+BENCHMARK(BM_DecodeXYZ);
+
+static void BM_DecodeBMP(benchmark::State& state) {
+	Decode(state, MakeBmp());
+}
+
+BENCHMARK(BM_DecodeBMP);
+
+static void BM_DecodePNGPaletted(benchmark::State& state) {
+	Decode(state, MakePng(true));
+}
+
+BENCHMARK(BM_DecodePNGPaletted);
+
+static void BM_DecodePNGRGBA(benchmark::State& state) {
+	Decode(state, MakePng(false));
+}
+
+BENCHMARK(BM_DecodePNGRGBA);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include "game_interpreter_map.h"
+#include "scene.h"
+#include "mock_game.h"
+
+using Cmd = lcf::rpg::EventCommand::Code;
+
+// Empty command at the end of every block
+constexpr auto End = static_cast<Cmd>(10);
+
+static lcf::rpg::EventCommand MakeCommand(Cmd code, int indent, std::vector<int32_t> params = {}) {
+	lcf::rpg::EventCommand com;
+	com.code = static_cast<int>(code);
+	com.indent = indent;
+	com.parameters = lcf::DBArray<int32_t>(params.begin(), params.end());
+	return com;
+}
+
+constexpr int loop_count = 50;
+
+// A loop which counts variable 1 up to loop_count and skips a branch with
+// body_size commands in every iteration
+static std::vector<lcf::rpg::EventCommand> MakeCommands(int body_size) {
+	std::vector<lcf::rpg::EventCommand> list;
+	list.push_back(MakeCommand(Cmd::Loop, 0));
+	list.push_back(MakeCommand(Cmd::ControlVars, 1, { 0, 1, 1, 1, 0, 1 }));
+	list.push_back(MakeCommand(Cmd::ConditionalBranch, 1, { 1, 1, 0, loop_count, 1, 0 }));
+	list.push_back(MakeCommand(Cmd::BreakLoop, 2));
+	list.push_back(MakeCommand(End, 2));
+	list.push_back(MakeCommand(Cmd::EndBranch, 1));
+	list.push_back(MakeCommand(Cmd::ConditionalBranch, 1, { 1, 1, 0, 0, 4, 0 }));
+	for (int i = 0; i < body_size; ++i) {
+		list.push_back(MakeCommand(Cmd::ControlVars, 2, { 0, 2, 2, 0, 0, i }));
+	}
+	list.push_back(MakeCommand(End, 2));
+	list.push_back(MakeCommand(Cmd::EndBranch, 1));
+	list.push_back(MakeCommand(End, 1));
+	list.push_back(MakeCommand(Cmd::EndLoop, 0));
+	list.push_back(MakeCommand(Cmd::ControlVars, 0, { 0, 1, 1, 0, 0, 0 }));
+	return list;
+}
+
+static void BM_InterpreterSkipBranch(benchmark::State& state) {
+	MockGame game(MockMap::ePass40x30);
+	Scene::instance = std::make_shared<Scene>();
+
+	// Parallel interpreter, runs the list once per update
+	Game_Interpreter_Map interpreter;
+	interpreter.Push(MakeCommands(state.range(0)), 0);
+
+	for (auto _: state) {
+		interpreter.Update();
+	}
+	state.SetItemsProcessed(state.iterations() * loop_count);
+
+	Scene::instance.reset();
+}
+
+BENCHMARK(BM_InterpreterSkipBranch)->Range(8, 512);
+
+static void BM_InterpreterPush(benchmark::State& state) {
+	MockGame game(MockMap::ePass40x30);
+
+	auto list = std::make_shared<const EventCommandList>(MakeCommands(256));
+	Game_Interpreter_Map interpreter;
+
+	for (auto _: state) {
+		if (state.range(0)) {
+			interpreter.Push(list, 0);
+		} else {
+			interpreter.Push(list->GetCommands(), 0);
+		}
+		interpreter.Clear();
+	}
+}
+
+// 0: copies the commands, 1: shares them
+BENCHMARK(BM_InterpreterPush)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+#include "game_map.h"
+#include "game_event.h"
+#include "mock_game.h"
+
+// Large maps are dominated by decorative events which never move
+static std::unique_ptr<lcf::rpg::Map> MakeMap(int num_events, MoveType move_type) {
+	auto map = MakeMockMap(MockMap::ePass40x30);
+	auto page = map->events.back().pages.back();
+	page.move_type = move_type;
+	page.character_name = "Chara";
+
+	map->events.clear();
+	for (int i = 0; i < num_events; ++i) {
+		map->events.push_back({});
+		auto& event = map->events.back();
+		event.ID = i + 1;
+		event.x = i % map->width;
+		event.y = (i / map->width) % map->height;
+		event.pages.push_back(page);
+	}
+
+	return map;
+}
+
+static void BM_MapEventsUpdate(benchmark::State& state, MoveType move_type) {
+	MockGame game(MakeMap(state.range(0), move_type));
+
+	for (auto _: state) {
+		Game_Map::UpdateProcessedFlags(false);
+		MapUpdateAsyncContext actx;
+		Game_Map::UpdateMapEvents(actx);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_MapEventsUpdateStationary(benchmark::State& state) {
+	BM_MapEventsUpdate(state, lcf::rpg::EventPage::MoveType_stationary);
+}
+
+BENCHMARK(BM_MapEventsUpdateStationary)->Range(10, 4000);
+
+static void BM_MapEventsUpdateRandom(benchmark::State& state) {
+	BM_MapEventsUpdate(state, lcf::rpg::EventPage::MoveType_random);
+}
+
+BENCHMARK(BM_MapEventsUpdateRandom)->Range(10, 4000);
+
+BENCHMARK_MAIN();
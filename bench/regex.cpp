@@ -0,0 +1,31 @@
+#include <regex>
+#include <string>
+#include <benchmark/benchmark.h>
+#include <regex_cache.h>
+
+// Typical Maniac string replacement executed every frame by an event
+static const std::string text = "HP: 123/456 MP: 78/90 Gold: 1000";
+static const std::string pattern = "(\\d+)/(\\d+)";
+
+static void BM_RegexCompileEachCall(benchmark::State& state) {
+	for (auto _: state) {
+		std::regex rexp(pattern);
+		auto result = std::regex_replace(text, rexp, "$2");
+		benchmark::DoNotOptimize(result);
+	}
+}
+
+BENCHMARK(BM_RegexCompileEachCall);
+
+static void BM_RegexCached(benchmark::State& state) {
+	RegexCache::Clear();
+	for (auto _: state) {
+		auto rexp = RegexCache::Get(pattern);
+		auto result = std::regex_replace(text, *rexp, "$2");
+		benchmark::DoNotOptimize(result);
+	}
+}
+
+BENCHMARK(BM_RegexCached);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,46 @@
+#include <string>
+#include <benchmark/benchmark.h>
+#include <game_strings.h>
+#include <game_variables.h>
+
+// A text file read with FromFile and processed line by line
+static std::string MakeText(int lines) {
+	std::string text;
+	for (int i = 0; i < lines; ++i) {
+		text += "Line " + std::to_string(i) + ": The quick brown fox jumps over the lazy dog\n";
+	}
+	return text;
+}
+
+static Game_Strings::Str_Params Params(int id) {
+	Game_Strings::Str_Params params;
+	params.string_id = id;
+	return params;
+}
+
+static void BM_PopLine(benchmark::State& state) {
+	auto text = MakeText(state.range(0));
+	for (auto _: state) {
+		Game_Strings strings;
+		strings.Asg(Params(1), text);
+		while (!strings.Get(1).empty()) {
+			strings.PopLine(Params(1), 0, 2);
+		}
+		benchmark::DoNotOptimize(strings.Get(2));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PopLine)->Range(64, 8192);
+
+static void BM_RangeAsg(benchmark::State& state) {
+	Game_Strings strings;
+	Game_Variables variables(Game_Variables::min_2k3, Game_Variables::max_2k3);
+	for (auto _: state) {
+		strings.RangeOp(Params(1), 1000, "abc", 0, nullptr, variables);
+	}
+}
+
+BENCHMARK(BM_RangeAsg);
+
+BENCHMARK_MAIN();
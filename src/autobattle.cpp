@@ -25,6 +25,7 @@
 #include "player.h"
 #include "output.h"
 #include "rand.h"
+#include "worker_pool.h"
 #include <lcf/reader_util.h>
 #include <lcf/data.h>
 
@@ -80,6 +81,16 @@ void RpgRtImproved::vSetAutoBattleAction(Game_Actor& source) {
 	SelectAutoBattleAction(source, Game_Battler::WeaponAll, Game_Battle::GetBattleCondition(), true, false, false, false);
 }
 
+// Below this amount of candidates handing the work to the workers costs more than it saves
+static constexpr int min_parallel_candidates = 8;
+
+#ifdef EP_DEBUG_AUTOBATTLE
+// The ranking logs, logging stays on the main thread
+static constexpr bool parallel_ranking = false;
+#else
+static constexpr bool parallel_ranking = true;
+#endif
+
 static int CalcSkillCostAutoBattle(const Game_Actor& source, const lcf::rpg::Skill& skill, bool emulate_bugs) {
 	// RPG_RT autobattle ignores half sp cost modifier
 	return emulate_bugs
@@ -159,7 +170,8 @@ double CalcSkillDmgAutoBattleTargetRank(const Game_Actor& source, const Game_Bat
 	return rank;
 }
 
-double CalcSkillAutoBattleRank(const Game_Actor& source, const lcf::rpg::Skill& skill, lcf::rpg::System::BattleCondition cond, bool apply_variance, bool emulate_bugs) {
+/** CalcSkillAutoBattleRank without the random bonus. Uses the RNG only when apply_variance is set. */
+static double CalcSkillAutoBattleBaseRank(const Game_Actor& source, const lcf::rpg::Skill& skill, lcf::rpg::System::BattleCondition cond, bool apply_variance, bool emulate_bugs) {
 	if (!source.IsSkillUsable(skill.ID)) {
 		return 0.0;
 	}
@@ -202,6 +214,11 @@ double CalcSkillAutoBattleRank(const Game_Actor& source, const lcf::rpg::Skill&
 			DebugLog("AUTOBATTLE: Actor {} Check Skill Self Rank : {}({}): {}", source.GetName(), skill.name, skill.ID, rank);
 			break;
 	}
+	return rank;
+}
+
+double CalcSkillAutoBattleRank(const Game_Actor& source, const lcf::rpg::Skill& skill, lcf::rpg::System::BattleCondition cond, bool apply_variance, bool emulate_bugs) {
+	double rank = CalcSkillAutoBattleBaseRank(source, skill, cond, apply_variance, emulate_bugs);
 	if (rank > 0.0) {
 		rank += Rand::GetRandomNumber(0, 99) / 100.0;
 	}
@@ -293,16 +310,45 @@ void SelectAutoBattleAction(Game_Actor& source,
 
 	// Find the highest ranking skill
 	if (do_skills) {
+		std::vector<lcf::rpg::Skill*> candidates;
 		for (auto& skill_id: source.GetSkills()) {
 			auto* candidate_skill = lcf::ReaderUtil::GetElement(lcf::Data::skills, skill_id);
 			if (candidate_skill) {
-				const auto rank = CalcSkillAutoBattleRank(source, *candidate_skill, cond, skill_variance, emulate_bugs);
-				DebugLog("AUTOBATTLE: Actor {} Check Skill Rank : {}({}): {}", source.GetName(), candidate_skill->name, candidate_skill->ID, rank);
-				if (rank > skill_rank) {
-					skill_rank = rank;
-					skill = candidate_skill;
+				candidates.push_back(candidate_skill);
+			}
+		}
+
+		const int num_candidates = static_cast<int>(candidates.size());
+		std::vector<double> ranks(num_candidates, 0.0);
+		if (parallel_ranking && !skill_variance) {
+			// The battlers are not modified until an action was selected,
+			// so all candidates are ranked against the same battle state.
+			// Without variance the ranking does not use the RNG.
+			WorkerPool::ParallelFor(num_candidates, [&](int i) {
+				ranks[i] = CalcSkillAutoBattleBaseRank(source, *candidates[i], cond, false, emulate_bugs);
+			}, min_parallel_candidates);
+
+			// Same random numbers in the same order as the serial ranking
+			for (auto& rank: ranks) {
+				if (rank > 0.0) {
+					rank += Rand::GetRandomNumber(0, 99) / 100.0;
 				}
 			}
+		} else {
+			// The variance draws random numbers while ranking
+			for (int i = 0; i < num_candidates; ++i) {
+				ranks[i] = CalcSkillAutoBattleRank(source, *candidates[i], cond, skill_variance, emulate_bugs);
+			}
+		}
+
+		for (int i = 0; i < num_candidates; ++i) {
+			auto* candidate_skill = candidates[i];
+			const auto rank = ranks[i];
+			DebugLog("AUTOBATTLE: Actor {} Check Skill Rank : {}({}): {}", source.GetName(), candidate_skill->name, candidate_skill->ID, rank);
+			if (rank > skill_rank) {
+				skill_rank = rank;
+				skill = candidate_skill;
+			}
 		}
 		DebugLog("AUTOBATTLE: Actor {} Best Skill Rank : {}({}): {}", source.GetName(), skill->name, skill->ID, skill_rank);
 	}
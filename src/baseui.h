@@ -224,6 +224,14 @@ public:
 	 */
 	void SetFrameLimit(int fps_limit);
 
+	/**
+	 * Returns how long uploading a frame to the display took on average
+	 * since the last call.
+	 *
+	 * @return average upload time, 0 when the UI does not measure it
+	 */
+	Game_Clock::duration TakeUploadTime();
+
 	/** Sets the scaling mode of the window */
 	virtual void SetScalingMode(ConfigEnum::ScalingMode) {};
 
@@ -251,6 +259,9 @@ public:
 	/** Turns vsync on or off */
 	virtual void ToggleVsync() {};
 
+	/** Toggles drawing directly into the display texture on or off */
+	virtual void ToggleDirectRender() {};
+
 	/** Turns a touch ui on or off. */
 	virtual void ToggleTouchUi() {};
 
@@ -322,6 +333,12 @@ protected:
 
 	/** Used by the F2 toggle: Remembers which configuration (ON or Overlay) was used */
 	ConfigEnum::ShowFps original_fps_show_state = ConfigEnum::ShowFps::OFF;
+
+	/** Time spent uploading frames since the last TakeUploadTime */
+	Game_Clock::duration upload_time = {};
+
+	/** Frames uploaded since the last TakeUploadTime */
+	int upload_count = 0;
 };
 
 /** Global DisplayUi variable. */
@@ -429,4 +446,11 @@ inline void BaseUi::SetFrameLimit(int fps_limit) {
 	frame_limit = (fps_limit == 0 ? Game_Clock::duration(0) : Game_Clock::TimeStepFromFps(fps_limit));
 }
 
+inline Game_Clock::duration BaseUi::TakeUploadTime() {
+	auto avg = upload_count > 0 ? upload_time / upload_count : Game_Clock::duration(0);
+	upload_time = {};
+	upload_count = 0;
+	return avg;
+}
+
 #endif
@@ -59,6 +59,9 @@ public:
 	/** @return true if the animation has finished **/
 	bool IsDone() const;
 
+	/** Unknown, the sprite is changed in Draw */
+	Bounds GetBounds(const Bitmap& dst) override { return Drawable::GetBounds(dst); }
+
 	/** @return true if the animation only plays audio and doesn't display **/
 	bool IsOnlySound() const;
 
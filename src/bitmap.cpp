@@ -16,6 +16,7 @@
  */
 
 // Headers
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
@@ -26,6 +27,7 @@
 #include "utils.h"
 #include "cache.h"
 #include "bitmap.h"
+#include "bitmap_pool.h"
 #include "filefinder.h"
 #include "options.h"
 #include <lcf/data.h>
@@ -100,6 +102,10 @@ Bitmap::Bitmap(Filesystem_Stream::InputStream stream, bool transparent, uint32_t
 	}
 
 	ImageOut image_out;
+	image_out.transparent = transparent;
+	if (CanDecodeInto(format)) {
+		image_out.target = this;
+	}
 
 	uint8_t data[4] = {};
 	size_t bytes = stream.read(reinterpret_cast<char*>(data),  4).gcount();
@@ -117,13 +123,15 @@ Bitmap::Bitmap(Filesystem_Stream::InputStream stream, bool transparent, uint32_t
 		Output::Warning("Unsupported image file {} (Magic: {:02X})", stream.GetName(), *reinterpret_cast<uint32_t*>(data));
 
 	if (!img_okay) {
-		free(image_out.pixels);
+		DiscardImage(image_out);
 		return;
 	}
 
-	Init(image_out.width, image_out.height, nullptr);
+	if (!image_out.target) {
+		Init(image_out.width, image_out.height, nullptr);
 
-	ConvertImage(image_out.width, image_out.height, image_out.pixels, transparent);
+		ConvertImage(image_out.width, image_out.height, image_out.pixels, transparent);
+	}
 
 	CheckPixels(flags);
 
@@ -137,6 +145,10 @@ Bitmap::Bitmap(const uint8_t* data, unsigned bytes, bool transparent, uint32_t f
 	pixman_format = find_format(format);
 
 	ImageOut image_out;
+	image_out.transparent = transparent;
+	if (CanDecodeInto(format)) {
+		image_out.target = this;
+	}
 
 	bool img_okay = false;
 
@@ -150,13 +162,15 @@ Bitmap::Bitmap(const uint8_t* data, unsigned bytes, bool transparent, uint32_t f
 		Output::Warning("Unsupported image (Magic: {:02X})", bytes >= 4 ? *reinterpret_cast<const uint32_t*>(data) : 0);
 
 	if (!img_okay) {
-		free(image_out.pixels);
+		DiscardImage(image_out);
 		return;
 	}
 
-	Init(image_out.width, image_out.height, nullptr);
+	if (!image_out.target) {
+		Init(image_out.width, image_out.height, nullptr);
 
-	ConvertImage(image_out.width, image_out.height, image_out.pixels, transparent);
+		ConvertImage(image_out.width, image_out.height, image_out.pixels, transparent);
+	}
 
 	original_bpp = image_out.bpp;
 
@@ -250,6 +264,30 @@ ImageOpacity Bitmap::ComputeImageOpacity(Rect rect) const {
 		ImageOpacity::Alpha_8Bit;
 }
 
+Rect Bitmap::ComputeVisibleRect() const {
+	auto* p = reinterpret_cast<const uint32_t*>(pixels());
+	const int stride = pitch() / sizeof(uint32_t);
+	const auto mask = pixel_format.rgba_to_uint32_t(0, 0, 0, 0xFF);
+
+	int x0 = width(), y0 = height(), x1 = -1, y1 = -1;
+	for (int y = 0; y < height(); ++y) {
+		const auto* row = p + y * stride;
+		for (int x = 0; x < width(); ++x) {
+			if (row[x] & mask) {
+				x0 = std::min(x0, x);
+				x1 = std::max(x1, x);
+				y0 = std::min(y0, y);
+				y1 = y;
+			}
+		}
+	}
+
+	if (x1 < 0) {
+		return {};
+	}
+	return { x0, y0, x1 - x0 + 1, y1 - y0 + 1 };
+}
+
 void Bitmap::CheckPixels(uint32_t flags) {
 	if (flags & Flag_System) {
 		DynamicFormat format(32,8,24,8,16,8,8,8,0,PF::Alpha);
@@ -281,6 +319,40 @@ void Bitmap::CheckPixels(uint32_t flags) {
 		read_only = true;
 
 		image_opacity = ComputeImageOpacity();
+
+		// Charsets, faces and pictures are mostly of this kind. The spans
+		// let Blit copy the opaque parts instead of blending every pixel.
+		if (image_opacity == ImageOpacity::Alpha_1Bit && width() <= UINT16_MAX) {
+			ComputeOpacitySpans();
+		}
+	}
+}
+
+void Bitmap::ComputeOpacitySpans() {
+	opacity_spans = {};
+
+	auto* p = reinterpret_cast<const uint32_t*>(pixels());
+	const int stride = pitch() / sizeof(uint32_t);
+	const auto mask = pixel_format.rgba_to_uint32_t(0, 0, 0, 0xFF);
+	const int w = width();
+
+	for (int y = 0; y < height(); ++y) {
+		opacity_spans.AddRow();
+
+		const uint32_t* row = p + y * stride;
+		int x = 0;
+		while (x < w) {
+			while (x < w && (row[x] & mask) == 0) {
+				++x;
+			}
+			int start = x;
+			while (x < w && (row[x] & mask) != 0) {
+				++x;
+			}
+			if (x > start) {
+				opacity_spans.Add(start, x - start);
+			}
+		}
 	}
 }
 
@@ -318,15 +390,31 @@ void Bitmap::HueChangeBlit(int x, int y, Bitmap const& src, Rect const& src_rect
 	Bitmap bmp(reinterpret_cast<void*>(&pixels.front()), src_rect.width, src_rect.height, src_rect.width * 4, format);
 	bmp.Blit(0, 0, src, src_rect, Opacity::Opaque());
 
-	for (std::vector<uint32_t>::iterator p = pixels.begin(); p != pixels.end(); ++p) {
-		uint32_t pixel = *p;
-		uint8_t r = (pixel>>24) & 0xFF;
-		uint8_t g = (pixel>>16) & 0xFF;
-		uint8_t b = (pixel>> 8) & 0xFF;
-		uint8_t a = pixel & 0xFF;
-		if (a > 0)
+	// Monster graphics use few colors, the result of the HSL conversion is
+	// remembered per color. Key is the RGB part, ~0 marks unused entries.
+	struct HueEntry {
+		uint32_t key = ~0u;
+		uint32_t rgb = 0;
+	};
+	std::array<HueEntry, 1024> hue_cache;
+
+	for (auto& pixel: pixels) {
+		uint32_t a = pixel & 0xFF;
+		if (a == 0) {
+			continue;
+		}
+
+		const uint32_t key = pixel >> 8;
+		auto& entry = hue_cache[(key * 2654435761u) >> 22];
+		if (entry.key != key) {
+			uint8_t r = (pixel>>24) & 0xFF;
+			uint8_t g = (pixel>>16) & 0xFF;
+			uint8_t b = (pixel>> 8) & 0xFF;
 			RGB_adjust_HSL(r, g, b, hue);
-		*p = ((uint32_t) r << 24) | ((uint32_t) g << 16) | ((uint32_t) b << 8) | (uint32_t) a;
+			entry.key = key;
+			entry.rgb = ((uint32_t) r << 24) | ((uint32_t) g << 16) | ((uint32_t) b << 8);
+		}
+		pixel = entry.rgb | a;
 	}
 
 	Blit(dst_rect.x, dst_rect.y, bmp, bmp.GetRect(), Opacity::Opaque());
@@ -497,6 +585,10 @@ static void destroy_func(pixman_image_t * /* image */, void *data) {
 	free(data);
 }
 
+static void pool_destroy_func(pixman_image_t * /* image */, void *data) {
+	BitmapPool::Free(data);
+}
+
 static pixman_indexed_t palette;
 static bool palette_initialized = false;
 
@@ -511,6 +603,14 @@ static void initialize_palette() {
 }
 
 void Bitmap::Init(int width, int height, void* data, int pitch, bool destroy) {
+	bool pooled = false;
+	if (data == NULL && width > 0 && height > 0) {
+		// Same stride pixman uses for images it allocates itself
+		pitch = (width * format.bits + 31) / 32 * 4;
+		data = BitmapPool::Allocate(static_cast<size_t>(pitch) * height);
+		pooled = (data != NULL);
+	}
+
 	if (!pitch)
 		pitch = width * format.bytes;
 
@@ -525,10 +625,99 @@ void Bitmap::Init(int width, int height, void* data, int pitch, bool destroy) {
 		pixman_image_set_indexed(bitmap.get(), &palette);
 	}
 
-	if (data != NULL && destroy)
+	if (pooled)
+		pixman_image_set_destroy_function(bitmap.get(), pool_destroy_func, data);
+	else if (data != NULL && destroy)
 		pixman_image_set_destroy_function(bitmap.get(), destroy_func, data);
 }
 
+bool Bitmap::CanDecodeInto(const DynamicFormat& format) {
+	// Other formats take the RGBA path and are converted by pixman
+	return format.bits == 32 && format.r.bits == 8 && format.g.bits == 8 && format.b.bits == 8 &&
+		(format.a.bits == 8 || format.a.bits == 0);
+}
+
+void Bitmap::DiscardImage(ImageOut& image_out) {
+	if (image_out.target) {
+		// Partially decoded, Create reports the failure when there are no pixels
+		bitmap.reset();
+	} else {
+		free(image_out.pixels);
+	}
+	image_out.pixels = nullptr;
+}
+
+bool ImageOut::Allocate(int w, int h) {
+	width = w;
+	height = h;
+
+	if (target) {
+		target->Init(w, h, nullptr);
+		pixels = target->pixels();
+		pitch = target->pitch();
+	} else {
+		pixels = malloc(w * h * 4);
+		pitch = w * 4;
+	}
+
+	// Indices past the end of a short palette are opaque black
+	for (int i = 0; i < 256; ++i) {
+		SetPaletteColor(i, 0, 0, 0, 255);
+	}
+
+	return pixels != nullptr;
+}
+
+uint32_t* ImageOut::Row(int y) {
+	return reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels) + y * pitch);
+}
+
+void ImageOut::SetPaletteColor(int index, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+	assert(index >= 0 && index < 256);
+
+	if (target) {
+		Bitmap::MultiplyAlpha(r, g, b, a);
+		if (!transparent) {
+			a = 255;
+		}
+		palette[index] = target->format.rgba_to_uint32_t(r, g, b, a);
+	} else {
+		uint8_t rgba[4] = { r, g, b, a };
+		memcpy(&palette[index], rgba, sizeof(rgba));
+	}
+}
+
+void ImageOut::WriteIndexed(int y, const uint8_t* indices) {
+	uint32_t* dst = Row(y);
+	for (int x = 0; x < width; ++x) {
+		dst[x] = palette[indices[x]];
+	}
+}
+
+void ImageOut::WriteRGBA(int y, const uint8_t* rgba) {
+	uint32_t* dst = Row(y);
+
+	if (!target) {
+		memcpy(dst, rgba, width * 4);
+		return;
+	}
+
+	const auto& format = target->format;
+	for (int x = 0; x < width; ++x, rgba += 4) {
+		uint8_t r = rgba[0];
+		uint8_t g = rgba[1];
+		uint8_t b = rgba[2];
+		uint8_t a = rgba[3];
+		if (a != 255) {
+			Bitmap::MultiplyAlpha(r, g, b, a);
+			if (!transparent) {
+				a = 255;
+			}
+		}
+		dst[x] = format.rgba_to_uint32_t(r, g, b, a);
+	}
+}
+
 void Bitmap::ConvertImage(int& width, int& height, void*& pixels, bool transparent) {
 	const DynamicFormat& img_format = transparent ? image_format : opaque_image_format;
 
@@ -610,6 +799,11 @@ void Bitmap::Blit(int x, int y, Bitmap const& src, Rect const& src_rect, Opacity
 		return;
 	}
 
+	if (opacity.IsOpaque() && (blend_mode == BlendMode::Default || blend_mode == BlendMode::Normal)
+			&& BlitSpans(x, y, src, src_rect)) {
+		return;
+	}
+
 	auto mask = CreateMask(opacity, src_rect);
 
 	pixman_image_composite32(src.GetOperator(mask.get(), blend_mode),
@@ -621,6 +815,41 @@ void Bitmap::Blit(int x, int y, Bitmap const& src, Rect const& src_rect, Opacity
 							 src_rect.width, src_rect.height);
 }
 
+void Bitmap::BlitBatch(Bitmap const& src, std::vector<BlitItem> const& items, Opacity const& opacity, Bitmap::BlendMode blend_mode) {
+	if (opacity.IsTransparent() || items.empty()) {
+		return;
+	}
+
+	if (opacity.IsSplit()) {
+		// The mask depends on the height of every item
+		for (const auto& item: items) {
+			Blit(item.x, item.y, src, item.src_rect, opacity, blend_mode);
+		}
+		return;
+	}
+
+	if (opacity.IsOpaque() && (blend_mode == BlendMode::Default || blend_mode == BlendMode::Normal)
+			&& BlitSpans(items.front().x, items.front().y, src, items.front().src_rect)) {
+		for (size_t i = 1; i < items.size(); ++i) {
+			BlitSpans(items[i].x, items[i].y, src, items[i].src_rect);
+		}
+		return;
+	}
+
+	auto mask = CreateMask(opacity, Rect());
+	const auto op = src.GetOperator(mask.get(), blend_mode);
+
+	for (const auto& item: items) {
+		pixman_image_composite32(op,
+								 src.bitmap.get(),
+								 mask.get(), bitmap.get(),
+								 item.src_rect.x, item.src_rect.y,
+								 0, 0,
+								 item.x, item.y,
+								 item.src_rect.width, item.src_rect.height);
+	}
+}
+
 void Bitmap::BlitFast(int x, int y, Bitmap const & src, Rect const & src_rect, Opacity const & opacity) {
 	if (opacity.IsTransparent()) {
 		return;
@@ -635,6 +864,43 @@ void Bitmap::BlitFast(int x, int y, Bitmap const & src, Rect const & src_rect, O
 		src_rect.width, src_rect.height);
 }
 
+bool Bitmap::BlitSpans(int x, int y, Bitmap const& src, Rect src_rect) {
+	if (src.opacity_spans.Empty() || &src == this || pixman_format != src.pixman_format) {
+		return false;
+	}
+
+	// Pixels outside of the source are transparent, same as in pixman
+	Rect dst_rect(x, y, src_rect.width, src_rect.height);
+	if (!Rect::AdjustRectangles(src_rect, dst_rect, src.GetRect())
+			|| !Rect::AdjustRectangles(dst_rect, src_rect, GetRect())) {
+		return true;
+	}
+
+	const int bytes = bpp();
+	const int src_end = src_rect.x + src_rect.width;
+	const auto* src_pixels = reinterpret_cast<const uint8_t*>(src.pixels());
+	auto* dst_pixels = reinterpret_cast<uint8_t*>(pixels());
+
+	for (int i = 0; i < src_rect.height; ++i) {
+		const uint8_t* src_row = src_pixels + (src_rect.y + i) * src.pitch();
+		uint8_t* dst_row = dst_pixels + (dst_rect.y + i) * pitch() + (dst_rect.x - src_rect.x) * bytes;
+
+		const auto* end = src.opacity_spans.RowEnd(src_rect.y + i);
+		for (const auto* span = src.opacity_spans.RowBegin(src_rect.y + i); span != end; ++span) {
+			if (span->x >= src_end) {
+				break;
+			}
+			const int x0 = std::max<int>(span->x, src_rect.x);
+			const int x1 = std::min<int>(span->x + span->width, src_end);
+			if (x0 < x1) {
+				memcpy(dst_row + x0 * bytes, src_row + x0 * bytes, (x1 - x0) * bytes);
+			}
+		}
+	}
+
+	return true;
+}
+
 PixmanImagePtr Bitmap::GetSubimage(Bitmap const& src, const Rect& src_rect) {
 	uint8_t* pixels = (uint8_t*) src.pixels() + src_rect.x * src.bpp() + src_rect.y * src.pitch();
 	return PixmanImagePtr{ pixman_image_create_bits(src.pixman_format, src_rect.width, src_rect.height,
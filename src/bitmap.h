@@ -38,6 +38,7 @@
 #include "string_view.h"
 
 struct Transform;
+struct ImageOut;
 
 /**
  * Base Bitmap class.
@@ -306,6 +307,26 @@ public:
 	void Blit(int x, int y, Bitmap const& src, Rect const& src_rect,
 		Opacity const& opacity, BlendMode blend_mode = BlendMode::Default);
 
+	/** Destination position and source rect of a blit in BlitBatch */
+	struct BlitItem {
+		int x;
+		int y;
+		Rect src_rect;
+	};
+
+	/**
+	 * Blits several parts of the same source bitmap with the same opacity
+	 * and blend mode. Equivalent to calling Blit for every item but the
+	 * operator and the opacity mask are only prepared once.
+	 *
+	 * @param src source bitmap.
+	 * @param items blits in drawing order.
+	 * @param opacity opacity for blending with bitmap.
+	 * @param blend_mode Blend mode to use.
+	 */
+	void BlitBatch(Bitmap const& src, std::vector<BlitItem> const& items,
+		Opacity const& opacity, BlendMode blend_mode = BlendMode::Default);
+
 	/**
 	 * Blits source bitmap to this one ignoring alpha (faster)
 	 *
@@ -609,11 +630,19 @@ public:
 	ImageOpacity ComputeImageOpacity() const;
 	ImageOpacity ComputeImageOpacity(Rect rect) const;
 
+	/**
+	 * @return smallest rectangle containing all pixels which are not fully
+	 * transparent, empty when the bitmap is transparent
+	 */
+	Rect ComputeVisibleRect() const;
+
 protected:
 	DynamicFormat format;
 
 	ImageOpacity image_opacity = ImageOpacity::Alpha_8Bit;
 	TileOpacity tile_opacity;
+	/** Opaque runs of every row, only for read-only images with 1 Bit Alpha */
+	OpacitySpans opacity_spans;
 	Color bg_color, sh_color;
 	FontRef font;
 
@@ -628,8 +657,32 @@ protected:
 
 	void Init(int width, int height, void* data, int pitch = 0, bool destroy = true);
 	void ConvertImage(int& width, int& height, void*& pixels, bool transparent);
+	void DiscardImage(ImageOut& image_out);
 
 	static PixmanImagePtr GetSubimage(Bitmap const& src, const Rect& src_rect);
+
+	/**
+	 * Blits a source with opacity spans by copying the opaque spans and
+	 * skipping the transparent pixels. Equivalent to an opaque Normal blit.
+	 *
+	 * @param x x position.
+	 * @param y y position.
+	 * @param src source bitmap.
+	 * @param src_rect source bitmap rect.
+	 * @return false when the source has no spans or the formats differ
+	 */
+	bool BlitSpans(int x, int y, Bitmap const& src, Rect src_rect);
+
+	void ComputeOpacitySpans();
+
+	/** Decoders initialize and fill the bitmap directly */
+	friend struct ImageOut;
+
+	/**
+	 * @param format pixel format of a bitmap
+	 * @return Whether ImageOut can write decoded images in this format
+	 */
+	static bool CanDecodeInto(const DynamicFormat& format);
 	static inline void MultiplyAlpha(uint8_t &r, uint8_t &g, uint8_t &b, const uint8_t &a) {
 		r = (uint8_t)((int)r * a / 0xFF);
 		g = (uint8_t)((int)g * a / 0xFF);
@@ -659,11 +712,68 @@ protected:
 	bool read_only = false;
 };
 
+/**
+ * Receives the pixels of an image decoder.
+ *
+ * Without a target the decoder result is a malloc'd RGBA buffer in pixels.
+ * With a target the rows are written premultiplied and in the pixel format
+ * of the target bitmap, which avoids converting the whole image afterwards.
+ */
 struct ImageOut {
 	int width = 0;
 	int height = 0;
 	void* pixels = nullptr;
 	int bpp = 0;
+
+	/** Bitmap to decode into, must have a format supported by Bitmap::CanDecodeInto */
+	Bitmap* target = nullptr;
+
+	/** When false the alpha is dropped like the opaque conversion of Bitmap::ConvertImage */
+	bool transparent = true;
+
+	/**
+	 * Allocates the pixels for an image of the given size.
+	 * Resets the palette to opaque black.
+	 *
+	 * @param width image width
+	 * @param height image height
+	 * @return false when out of memory
+	 */
+	bool Allocate(int width, int height);
+
+	/**
+	 * Sets a palette entry used by WriteIndexed.
+	 *
+	 * @param index palette index
+	 * @param r red
+	 * @param g green
+	 * @param b blue
+	 * @param a alpha
+	 */
+	void SetPaletteColor(int index, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+	/**
+	 * Writes a row of palette indices.
+	 *
+	 * @param y row
+	 * @param indices width palette indices
+	 */
+	void WriteIndexed(int y, const uint8_t* indices);
+
+	/**
+	 * Writes a row of RGBA pixels (not premultiplied).
+	 *
+	 * @param y row
+	 * @param rgba width RGBA pixels
+	 */
+	void WriteRGBA(int y, const uint8_t* rgba);
+
+private:
+	/** Palette converted to the output format */
+	uint32_t palette[256] = {};
+	int pitch = 0;
+
+	uint32_t* Row(int y);
 };
 
 inline ImageOpacity Bitmap::GetImageOpacity() const {
@@ -0,0 +1,176 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bitmap_pool.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#ifdef HAVE_THREADS
+#  include <mutex>
+#endif
+
+namespace {
+	// A 96x96 surface, smaller buffers are allocated directly
+	constexpr size_t min_pooled_bytes = 96 * 96 * 4;
+	// A 1920x1080 surface
+	constexpr size_t max_pooled_bytes = 1920 * 1080 * 4;
+	constexpr size_t max_buffers_per_class = 4;
+	constexpr size_t max_cached_bytes = 32 * 1024 * 1024;
+
+	// Stored in front of every buffer, keeps the alignment of malloc
+	union Header {
+		size_t capacity;
+		std::max_align_t align;
+	};
+
+	struct Pool {
+		// Key is the capacity of the size class
+		std::unordered_map<size_t, std::vector<Header*>> classes;
+		BitmapPool::Stats stats;
+#ifdef HAVE_THREADS
+		std::mutex mutex;
+#endif
+	};
+
+	// Never destroyed: Bitmaps in static storage can be released after
+	// the static objects of this file are gone.
+	Pool& GetPool() {
+		static Pool* pool = new Pool;
+		return *pool;
+	}
+
+#ifdef HAVE_THREADS
+	std::unique_lock<std::mutex> Lock() {
+		return std::unique_lock<std::mutex>(GetPool().mutex);
+	}
+#else
+	struct NoLock {
+		~NoLock() {}
+	};
+
+	NoLock Lock() {
+		return {};
+	}
+#endif
+
+	/** Rounds up to the next of four size classes per power of two */
+	size_t GetClassCapacity(size_t bytes) {
+		size_t pow2 = 1;
+		while (pow2 <= bytes / 2) {
+			pow2 *= 2;
+		}
+		size_t step = pow2 / 4;
+		return (bytes + step - 1) / step * step;
+	}
+
+	bool IsPooled(size_t capacity) {
+		return capacity >= min_pooled_bytes && capacity <= max_pooled_bytes;
+	}
+}
+
+void* BitmapPool::Allocate(size_t bytes) {
+	auto& pool = GetPool();
+	size_t capacity = bytes;
+	if (IsPooled(bytes)) {
+		capacity = GetClassCapacity(bytes);
+
+		auto lk = Lock();
+		++pool.stats.allocations;
+
+		auto it = pool.classes.find(capacity);
+		if (it != pool.classes.end() && !it->second.empty()) {
+			Header* header = it->second.back();
+			it->second.pop_back();
+			++pool.stats.reused;
+			--pool.stats.cached_buffers;
+			pool.stats.cached_bytes -= capacity;
+			lk.unlock();
+
+			memset(header + 1, 0, bytes);
+			return header + 1;
+		}
+	} else {
+		auto lk = Lock();
+		++pool.stats.allocations;
+	}
+
+	auto* header = static_cast<Header*>(calloc(1, sizeof(Header) + capacity));
+	if (!header) {
+		return nullptr;
+	}
+	header->capacity = capacity;
+	return header + 1;
+}
+
+void BitmapPool::Free(void* data) {
+	if (!data) {
+		return;
+	}
+
+	auto& pool = GetPool();
+
+	Header* header = static_cast<Header*>(data) - 1;
+	size_t capacity = header->capacity;
+
+	{
+		auto lk = Lock();
+		++pool.stats.releases;
+
+		if (IsPooled(capacity) && pool.stats.cached_bytes + capacity <= max_cached_bytes) {
+			auto& buffers = pool.classes[capacity];
+			if (buffers.size() < max_buffers_per_class) {
+				buffers.push_back(header);
+				++pool.stats.cached_buffers;
+				pool.stats.cached_bytes += capacity;
+				return;
+			}
+		}
+
+		if (IsPooled(capacity)) {
+			++pool.stats.discarded;
+		}
+	}
+
+	free(header);
+}
+
+BitmapPool::Stats BitmapPool::GetStats() {
+	auto& pool = GetPool();
+	auto lk = Lock();
+	return pool.stats;
+}
+
+void BitmapPool::Clear() {
+	auto& pool = GetPool();
+	std::vector<Header*> buffers;
+	{
+		auto lk = Lock();
+		for (auto& cls: pool.classes) {
+			buffers.insert(buffers.end(), cls.second.begin(), cls.second.end());
+		}
+		pool.classes.clear();
+		pool.stats.cached_buffers = 0;
+		pool.stats.cached_bytes = 0;
+	}
+
+	for (auto* header: buffers) {
+		free(header);
+	}
+}
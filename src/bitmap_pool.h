@@ -0,0 +1,72 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_BITMAP_POOL_H
+#define EP_BITMAP_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Recycles the pixel storage of Bitmaps.
+ *
+ * Windows, planes, screen effects and transitions create and destroy
+ * surfaces of the same few sizes all the time. Released buffers are kept in
+ * size classes (four classes per power of two) and handed out again instead
+ * of going through malloc for every Bitmap.
+ *
+ * Small buffers are not pooled, the system allocator is fast enough for them.
+ */
+namespace BitmapPool {
+	struct Stats {
+		/** Buffers requested */
+		uint64_t allocations = 0;
+		/** Requests served from the pool */
+		uint64_t reused = 0;
+		/** Buffers returned */
+		uint64_t releases = 0;
+		/** Returned buffers freed because the pool was full */
+		uint64_t discarded = 0;
+		/** Buffers currently kept in the pool */
+		size_t cached_buffers = 0;
+		/** Memory currently kept in the pool */
+		size_t cached_bytes = 0;
+	};
+
+	/**
+	 * Allocates a zero-filled buffer.
+	 *
+	 * @param bytes size of the buffer
+	 * @return buffer, must be released with Free
+	 */
+	void* Allocate(size_t bytes);
+
+	/**
+	 * Returns a buffer to the pool.
+	 *
+	 * @param data buffer obtained from Allocate, nullptr is ignored
+	 */
+	void Free(void* data);
+
+	/** @return allocation counters */
+	Stats GetStats();
+
+	/** Frees all buffers kept in the pool. */
+	void Clear();
+}
+
+#endif
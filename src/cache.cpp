@@ -36,6 +36,7 @@
 #include <lcf/data.h>
 #include "game_clock.h"
 #include "translation.h"
+#include "text.h"
 
 using namespace std::chrono_literals;
 
@@ -85,6 +86,10 @@ namespace {
 	using effect_key_type = std::tuple<std::string, bool, Rect, bool, bool, Tone, Color>;
 	std::map<effect_key_type, std::weak_ptr<Bitmap>> cache_effects;
 
+	// hue
+	using hue_key_type = std::tuple<std::string, bool, int>;
+	std::map<hue_key_type, std::weak_ptr<Bitmap>> cache_hue;
+
 	std::string system_name;
 
 	std::string system2_name;
@@ -515,8 +520,29 @@ BitmapRef Cache::SpriteEffect(const BitmapRef& src_bitmap, const Rect& rect, boo
 	} else { return it->second.lock(); }
 }
 
+BitmapRef Cache::HueChange(const BitmapRef& src_bitmap, int hue) {
+	const hue_key_type key {
+		src_bitmap->GetId(),
+		src_bitmap->GetTransparent(),
+		hue
+	};
+
+	assert(!src_bitmap->GetId().empty());
+
+	auto& entry = cache_hue[key];
+	auto bitmap = entry.lock();
+	if (!bitmap) {
+		bitmap = Bitmap::Create(src_bitmap->GetWidth(), src_bitmap->GetHeight());
+		bitmap->HueChangeBlit(0, 0, *src_bitmap, src_bitmap->GetRect(), hue);
+		entry = bitmap;
+	}
+	return bitmap;
+}
+
 void Cache::Clear() {
+	Text::ClearCache();
 	cache_effects.clear();
+	cache_hue.clear();
 	cache.clear();
 	cache_size = 0;
 
@@ -556,7 +582,12 @@ BitmapRef Cache::System() {
 }
 
 BitmapRef Cache::SysBlack() {
-	static auto system_black = Bitmap::Create(160, 80, false);
+	static auto system_black = []() {
+		auto bmp = Bitmap::Create(160, 80, false);
+		// Allows caching of text drawn with it
+		bmp->SetId("SysBlack");
+		return bmp;
+	}();
 	return system_black;
 }
 
@@ -58,6 +58,16 @@ namespace Cache {
 	BitmapRef Tile(StringView filename, int tile_id);
 	BitmapRef SpriteEffect(const BitmapRef& src_bitmap, const Rect& rect, bool flip_x, bool flip_y, const Tone& tone, const Color& blend);
 
+	/**
+	 * Returns the bitmap with rotated hue. Shared with every other user of the
+	 * same bitmap and hue while it is alive.
+	 *
+	 * @param src_bitmap bitmap with an id
+	 * @param hue hue rotation in degrees
+	 * @return hue changed copy of the bitmap
+	 */
+	BitmapRef HueChange(const BitmapRef& src_bitmap, int hue);
+
 	void Clear();
 	void ClearAll();
 
@@ -22,6 +22,10 @@
 #include "platform.h"
 #include "player.h"
 #include <lcf/reader_util.h>
+#include <cstdlib>
+#include <ctime>
+#include <istream>
+#include <ostream>
 
 //#define EP_DEBUG_DIRECTORYTREE
 #ifdef EP_DEBUG_DIRECTORYTREE
@@ -38,6 +42,26 @@ namespace {
 	std::string make_key(StringView n) {
 		return lcf::ReaderUtil::Normalize(n);
 	};
+
+	constexpr StringView index_header = "EasyRPG Player Directory Index 2";
+
+	bool IsBelow(StringView key, StringView root_key) {
+		if (root_key.empty() || key == root_key) {
+			return true;
+		}
+		return key.starts_with(root_key) && (root_key.back() == '/' || key[root_key.size()] == '/');
+	}
+
+	char TypeToIndexChar(DirectoryTree::FileType type) {
+		switch (type) {
+			case DirectoryTree::FileType::Regular:
+				return 'f';
+			case DirectoryTree::FileType::Directory:
+				return 'd';
+			default:
+				return 'o';
+		}
+	}
 }
 
 std::unique_ptr<DirectoryTree> DirectoryTree::Create() {
@@ -68,8 +92,7 @@ DirectoryTree::DirectoryListType* DirectoryTree::ListDirectory(StringView path)
 		return &file_it->second;
 	}
 
-	auto dir_missing_it = std::find(dir_missing_cache.begin(), dir_missing_cache.end(), dir_key);
-	if (dir_missing_it != dir_missing_cache.end()) {
+	if (dir_missing_cache.find(dir_key) != dir_missing_cache.end()) {
 		// Cached and known to be missing
 		DebugLog("ListDirectory Cache Hit Dir Missing: {}", dir_key);
 		return nullptr;
@@ -77,6 +100,22 @@ DirectoryTree::DirectoryListType* DirectoryTree::ListDirectory(StringView path)
 
 	assert(Find(fs_cache, dir_key) == fs_cache.end());
 
+	auto index_it = index_cache.find(dir_key);
+	if (index_it != index_cache.end()) {
+		IndexEntry index_entry = std::move(index_it->second);
+		index_cache.erase(index_it);
+
+		// Two stats instead of reading the whole directory
+		if (GetDirStamp(index_entry.path) == index_entry.stamp) {
+			DebugLog("ListDirectory Index Hit: {}", dir_key);
+			dir_stamp_cache[dir_key] = index_entry.stamp;
+			InsertSorted(dir_cache, dir_key, std::move(index_entry.path));
+			InsertSorted(fs_cache, dir_key, std::move(index_entry.entries));
+			return &Find(fs_cache, dir_key)->second;
+		}
+		DebugLog("ListDirectory Index Outdated: {}", dir_key);
+	}
+
 	if (!fs->Exists(fs_path)) {
 		std::string parent_dir, child_dir;
 		std::tie(parent_dir, child_dir) = FileFinder::GetPathAndFilename(fs_path);
@@ -84,7 +123,7 @@ DirectoryTree::DirectoryListType* DirectoryTree::ListDirectory(StringView path)
 		if (parent_dir == fs_path) {
 			// When the path stays we are in a non-existant root -> give up
 			DebugLog("ListDirectory Bad root: {} | {}", fs_path, parent_dir);
-			dir_missing_cache.push_back(make_key(parent_dir));
+			dir_missing_cache.insert(make_key(parent_dir));
 			return nullptr;
 		}
 
@@ -92,7 +131,7 @@ DirectoryTree::DirectoryListType* DirectoryTree::ListDirectory(StringView path)
 		auto* parent_tree = ListDirectory(parent_dir);
 		if (!parent_tree) {
 			DebugLog("ListDirectory No parent: {} | {}", fs_path, parent_dir);
-			dir_missing_cache.push_back(make_key(parent_dir));
+			dir_missing_cache.insert(make_key(parent_dir));
 			return nullptr;
 		}
 
@@ -106,19 +145,36 @@ DirectoryTree::DirectoryListType* DirectoryTree::ListDirectory(StringView path)
 			fs_path = FileFinder::MakePath(parent_it->second, child_it->second.name);
 		} else {
 			DebugLog("ListDirectory Child not in Parent: {} | {} | {}", fs_path, parent_dir, child_dir);
-			dir_missing_cache.push_back(FileFinder::MakePath(parent_key, child_key));
+			dir_missing_cache.insert(FileFinder::MakePath(parent_key, child_key));
 			return nullptr;
 		}
 	}
 
+	// Queried before reading the directory: A change while reading makes the
+	// index entry outdated instead of silently missing the change
+	DirStamp stamp;
+	if (IsIndexed(dir_key)) {
+		stamp = GetDirStamp(fs_path);
+		// The modification time has a resolution of one second: A change in the
+		// same second as this listing would go unnoticed, so do not index it
+		if (stamp.mtime >= static_cast<int64_t>(std::time(nullptr)) - 2) {
+			DebugLog("ListDirectory Too recent for Index: {}", dir_key);
+			stamp = {};
+		}
+	}
+
 	if (!fs->GetDirectoryContent(fs_path, entries)) {
 		DebugLog("ListDirectory GetDirectoryContent Failed: {}", fs_path);
-		dir_missing_cache.push_back(make_key(fs_path));
+		dir_missing_cache.insert(make_key(fs_path));
 		return nullptr;
 	}
 
 	InsertSorted(dir_cache, dir_key, std::move(fs_path));
 
+	if (stamp.mtime >= 0) {
+		dir_stamp_cache[dir_key] = stamp;
+	}
+
 	DirectoryListType fs_cache_entry;
 
 #ifdef EP_DEBUG_DIRECTORYTREE
@@ -163,6 +219,8 @@ void DirectoryTree::ClearCache(StringView path) const {
 		fs_cache.clear();
 		dir_cache.clear();
 		dir_missing_cache.clear();
+		index_cache.clear();
+		dir_stamp_cache.clear();
 		return;
 	}
 
@@ -175,9 +233,153 @@ void DirectoryTree::ClearCache(StringView path) const {
 	if (dir_it != dir_cache.end()) {
 		dir_cache.erase(dir_it);
 	}
-	dir_missing_cache.erase(std::remove_if(dir_missing_cache.begin(), dir_missing_cache.end(), [&path] (const auto& dir) {
-		return StringView(dir).starts_with(path);
-	}), dir_missing_cache.end());
+	for (auto it = dir_missing_cache.begin(); it != dir_missing_cache.end();) {
+		if (StringView(*it).starts_with(path)) {
+			it = dir_missing_cache.erase(it);
+		} else {
+			++it;
+		}
+	}
+	index_cache.erase(dir_key);
+	dir_stamp_cache.erase(dir_key);
+}
+
+bool DirectoryTree::IsIndexed(StringView dir_key) const {
+	return std::any_of(index_roots.begin(), index_roots.end(), [&](const auto& root_key) {
+		return IsBelow(dir_key, root_key);
+	});
+}
+
+DirectoryTree::DirStamp DirectoryTree::GetDirStamp(StringView path) const {
+	return { fs->GetModificationTime(path), fs->GetFilesize(path) };
+}
+
+bool DirectoryTree::LoadIndex(std::istream& is, StringView root) const {
+	auto root_key = make_key(root);
+	if (std::find(index_roots.begin(), index_roots.end(), root_key) == index_roots.end()) {
+		index_roots.push_back(root_key);
+
+		// Directories listed before have no stamp and would be missing in the
+		// next index: Forget them to read them again
+		auto unstamped = [&](const auto& e) {
+			return IsBelow(e.first, root_key) && dir_stamp_cache.find(e.first) == dir_stamp_cache.end();
+		};
+		fs_cache.erase(std::remove_if(fs_cache.begin(), fs_cache.end(), unstamped), fs_cache.end());
+		dir_cache.erase(std::remove_if(dir_cache.begin(), dir_cache.end(), unstamped), dir_cache.end());
+	}
+
+	std::string line;
+	if (!std::getline(is, line) || line != index_header) {
+		return false;
+	}
+	if (!std::getline(is, line) || StringView(line) != root) {
+		return false;
+	}
+
+	std::unordered_map<std::string, IndexEntry> new_index;
+	IndexEntry* current = nullptr;
+
+	while (std::getline(is, line)) {
+		if (line.size() < 2 || line[1] != ' ') {
+			return false;
+		}
+
+		StringView value = StringView(line).substr(2);
+
+		if (line[0] == '>') {
+			// > mtime size relative/path/of/dir
+			char* end = nullptr;
+			const auto mtime = static_cast<int64_t>(std::strtoll(line.c_str() + 2, &end, 10));
+			if (end == line.c_str() + 2 || mtime < 0) {
+				return false;
+			}
+			const char* size_start = end;
+			const auto size = static_cast<int64_t>(std::strtoll(size_start, &end, 10));
+			if (end == size_start) {
+				return false;
+			}
+			auto rel_path = value.substr(end - line.c_str() - 2);
+			if (rel_path.starts_with(" ")) {
+				rel_path = rel_path.substr(1);
+			}
+
+			std::string path = FileFinder::MakePath(root, rel_path);
+			auto key = make_key(path);
+			current = &new_index[key];
+			current->path = std::move(path);
+			current->stamp = { mtime, size };
+			continue;
+		}
+
+		if (!current) {
+			return false;
+		}
+
+		FileType type;
+		switch (line[0]) {
+			case 'f':
+				type = FileType::Regular;
+				break;
+			case 'd':
+				type = FileType::Directory;
+				break;
+			case 'o':
+				type = FileType::Other;
+				break;
+			default:
+				return false;
+		}
+		current->entries.emplace_back(make_key(value), Entry(ToString(value), type));
+	}
+
+	for (auto& index_entry : new_index) {
+		auto& list = index_entry.second.entries;
+		std::sort(list.begin(), list.end(), [](auto& left, auto& right) {
+			return left.first < right.first;
+		});
+		index_cache[index_entry.first] = std::move(index_entry.second);
+	}
+
+	DebugLog("LoadIndex: {} directories for {}", new_index.size(), root);
+
+	return true;
+}
+
+void DirectoryTree::WriteIndex(std::ostream& os, StringView root) const {
+	auto root_key = make_key(root);
+	auto root_it = Find(dir_cache, root_key);
+	if (root_it == dir_cache.end()) {
+		return;
+	}
+	const auto& root_path = root_it->second;
+
+	os << index_header << "\n" << root << "\n";
+
+	for (const auto& dir : fs_cache) {
+		if (!IsBelow(dir.first, root_key)) {
+			continue;
+		}
+
+		auto stamp_it = dir_stamp_cache.find(dir.first);
+		if (stamp_it == dir_stamp_cache.end() || stamp_it->second.mtime < 0) {
+			continue;
+		}
+
+		// The format is line based
+		const auto& list = dir.second;
+		if (std::any_of(list.begin(), list.end(), [](const auto& e) { return e.second.name.find('\n') != std::string::npos; })) {
+			continue;
+		}
+
+		auto dir_it = Find(dir_cache, dir.first);
+		assert(dir_it != dir_cache.end());
+
+		const auto& stamp = stamp_it->second;
+		os << "> " << stamp.mtime << " " << stamp.size << " " << FileFinder::GetPathInsidePath(root_path, dir_it->second) << "\n";
+		for (const auto& e : list) {
+			os << TypeToIndexChar(e.second.type) << " " << e.second.name << "\n";
+		}
+	}
 }
 
 std::string DirectoryTree::FindFile(StringView filename, const Span<const StringView> exts) const {
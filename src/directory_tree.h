@@ -18,10 +18,13 @@
 #ifndef EP_DIRECTORY_TREE_H
 #define EP_DIRECTORY_TREE_H
 
+#include <cstdint>
+#include <iosfwd>
 #include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "span.h"
 #include "string_view.h"
@@ -34,6 +37,7 @@ class FilesystemView;
  * and its subdirectories.
  * Translation support can be enabled via advanced arguments.
  * For performance reasons the entries are cached.
+ * The cache can be persisted in a directory index to speed up the next start.
  */
 class DirectoryTree {
 public:
@@ -128,11 +132,34 @@ public:
 
 	void ClearCache(StringView path) const;
 
+	/**
+	 * Loads a directory index written by WriteIndex.
+	 * A directory of the index is used instead of reading the directory from
+	 * the filesystem when its modification time and size did not change.
+	 * Directories below root which are listed afterwards are remembered for
+	 * the next WriteIndex call. This also happens when the index is invalid
+	 * or empty. Directories below root which were listed before are read
+	 * again on the next access.
+	 *
+	 * @param is stream to read the index from
+	 * @param root path the index belongs to
+	 * @return whether the index is valid
+	 */
+	bool LoadIndex(std::istream& is, StringView root) const;
+
+	/**
+	 * Writes all directories below root which were listed since LoadIndex was
+	 * called to a directory index.
+	 *
+	 * @param os stream to write the index to
+	 * @param root path the index belongs to
+	 */
+	void WriteIndex(std::ostream& os, StringView root) const;
+
 private:
 	Filesystem* fs = nullptr;
 
 	// Cache vectors are sorted for a binary search
-	// Except dir_missing_cache as this vector will be (almost) empty usually
 
 	/** lowered dir (full path from root) -> <list of> lowered file -> Entry */
 	using fs_cache_pair = std::pair<std::string, DirectoryListType>;
@@ -143,7 +170,38 @@ private:
 	mutable std::vector<dir_cache_pair> dir_cache;
 
 	/** lowered dir (full path from root) of missing directories */
-	mutable std::vector<std::string> dir_missing_cache;
+	mutable std::unordered_set<std::string> dir_missing_cache;
+
+	/** Modification time and size of a directory when it was listed */
+	struct DirStamp {
+		int64_t mtime = -1;
+		int64_t size = -1;
+
+		bool operator==(const DirStamp& o) const {
+			return mtime == o.mtime && size == o.size;
+		}
+	};
+
+	/** A directory listing loaded from a directory index */
+	struct IndexEntry {
+		/** real dir (full path from root) */
+		std::string path;
+		DirStamp stamp;
+		DirectoryListType entries;
+	};
+
+	/** lowered dir -> listing from a directory index which was not used yet */
+	mutable std::unordered_map<std::string, IndexEntry> index_cache;
+
+	/** lowered dir -> stamp, only tracked below index_roots */
+	mutable std::unordered_map<std::string, DirStamp> dir_stamp_cache;
+
+	/** lowered roots of the loaded directory indexes */
+	mutable std::vector<std::string> index_roots;
+
+	bool IsIndexed(StringView dir_key) const;
+
+	DirStamp GetDirStamp(StringView path) const;
 
 	template<class T>
 	auto Find(T& cache, StringView what) const {
@@ -20,6 +20,8 @@
 
 #include <cstdint>
 #include <memory>
+#include "opacity.h"
+#include "rect.h"
 
 class Bitmap;
 class Drawable;
@@ -48,6 +50,29 @@ public:
 		Default = None
 	};
 
+	/** Area of the screen a drawable paints on */
+	struct Bounds {
+		/** Affected area of the destination bitmap, empty when nothing is drawn */
+		Rect rect;
+		/** Whether rect is known. Unknown drawables are always drawn and hide nothing. */
+		bool known = false;
+		/** Opacity of the drawn pixels, Opaque when every pixel of rect is replaced */
+		ImageOpacity opacity = ImageOpacity::Alpha_8Bit;
+	};
+
+	/** A plain blit which can be combined with the blits of neighbouring drawables */
+	struct BatchBlit {
+		/** Source bitmap, nullptr when nothing is drawn. Must stay valid until the next Draw or GetBatchBlit call. */
+		const Bitmap* src = nullptr;
+		Rect src_rect;
+		/** Destination position */
+		int x = 0;
+		int y = 0;
+		int opacity = 255;
+		/** Bitmap::BlendMode */
+		int blend_mode = 0;
+	};
+
 	Drawable(Z_t z, Flags flags = Flags::Default);
 
 	Drawable(const Drawable&) = delete;
@@ -57,6 +82,27 @@ public:
 
 	virtual void Draw(Bitmap& dst) = 0;
 
+	/**
+	 * Reports where the following Draw call will paint. Used by DrawableList
+	 * to skip drawables which are off-screen or hidden behind opaque ones.
+	 * Called once per frame before Draw, the drawable may prepare its state
+	 * for Draw here.
+	 *
+	 * @param dst bitmap which will be drawn on
+	 * @return affected area, unknown by default
+	 */
+	virtual Bounds GetBounds(const Bitmap& dst);
+
+	/**
+	 * Called instead of Draw when the drawable paints a single untransformed
+	 * image. DrawableList combines consecutive blits of the same bitmap with
+	 * equal opacity and blend mode into one Bitmap::BatchBlit call.
+	 *
+	 * @param blit receives the blit when returning true
+	 * @return false when Draw must be called, the default
+	 */
+	virtual bool GetBatchBlit(BatchBlit& blit);
+
 	Z_t GetZ() const;
 
 	void SetZ(Z_t z);
@@ -142,6 +188,14 @@ inline Drawable::Drawable(Z_t z, Flags flags)
 {
 }
 
+inline bool Drawable::GetBatchBlit(BatchBlit&) {
+	return false;
+}
+
+inline Drawable::Bounds Drawable::GetBounds(const Bitmap&) {
+	return {};
+}
+
 inline Drawable::Z_t Drawable::GetZ() const {
 	return _z;
 }
@@ -18,6 +18,7 @@
 // Headers
 #include "drawable_list.h"
 #include "drawable_mgr.h"
+#include "bitmap.h"
 #include <algorithm>
 #include <cassert>
 
@@ -90,6 +91,17 @@ void DrawableList::TakeFrom(DrawableList& other) noexcept {
 	other.SetClean();
 }
 
+namespace {
+	// Reused by Draw to avoid allocations, drawing happens on the main thread only
+	std::vector<Bitmap::BlitItem> batch_items;
+}
+
+static bool Contains(const Rect& outer, const Rect& inner) {
+	return inner.x >= outer.x && inner.y >= outer.y &&
+		inner.x + inner.width <= outer.x + outer.width &&
+		inner.y + inner.height <= outer.y + outer.height;
+}
+
 void DrawableList::Draw(Bitmap& dst, Drawable::Z_t min_z, Drawable::Z_t max_z) {
 	if (IsDirty()) {
 		Sort();
@@ -97,17 +109,88 @@ void DrawableList::Draw(Bitmap& dst, Drawable::Z_t min_z, Drawable::Z_t max_z) {
 		assert(IsSorted());
 	}
 
-	for (auto* drawable : _list) {
-		auto z = drawable->GetZ();
-		if (z < min_z) {
+	_stats = {};
+
+	auto first = std::find_if(_list.begin(), _list.end(), [&](Drawable* d) { return d->GetZ() >= min_z; });
+	auto last = std::find_if(first, _list.end(), [&](Drawable* d) { return d->GetZ() > max_z; });
+
+	const Rect screen = dst.GetRect();
+	const size_t count = last - first;
+
+	_skip.assign(count, false);
+	_occluders.clear();
+
+	// From top to bottom: Opaque drawables hide everything below them
+	for (size_t i = count; i-- > 0;) {
+		auto* drawable = *(first + i);
+		if (!drawable->IsVisible()) {
+			_skip[i] = true;
+			continue;
+		}
+
+		auto bounds = drawable->GetBounds(dst);
+		if (!bounds.known) {
+			continue;
+		}
+
+		bounds.rect.Adjust(screen);
+		if (bounds.rect.IsEmpty() || bounds.opacity == ImageOpacity::Transparent) {
+			_skip[i] = true;
+			++_stats.offscreen;
 			continue;
 		}
-		if (z > max_z) {
-			break;
+
+		auto covered = std::any_of(_occluders.begin(), _occluders.end(), [&](const Rect& r) { return Contains(r, bounds.rect); });
+		if (covered) {
+			_skip[i] = true;
+			++_stats.occluded;
+			continue;
+		}
+
+		if (bounds.opacity == ImageOpacity::Opaque) {
+			_occluders.push_back(bounds.rect);
 		}
-		if (drawable->IsVisible()) {
+	}
+
+	// Consecutive blits of the same bitmap are combined
+	Drawable::BatchBlit batch;
+	batch_items.clear();
+
+	auto flush = [&]() {
+		if (batch_items.empty()) {
+			return;
+		}
+		dst.BlitBatch(*batch.src, batch_items, Opacity(batch.opacity), static_cast<Bitmap::BlendMode>(batch.blend_mode));
+		++_stats.batches;
+		batch_items.clear();
+	};
+
+	for (size_t i = 0; i < count; ++i) {
+		if (_skip[i]) {
+			continue;
+		}
+
+		auto* drawable = *(first + i);
+		++_stats.drawn;
+
+		Drawable::BatchBlit blit;
+		if (!drawable->GetBatchBlit(blit)) {
+			flush();
 			drawable->Draw(dst);
+			continue;
+		}
+
+		if (!blit.src) {
+			continue;
 		}
+
+		if (blit.src != batch.src || blit.opacity != batch.opacity || blit.blend_mode != batch.blend_mode) {
+			flush();
+			batch = blit;
+		}
+		batch_items.push_back({ blit.x, blit.y, blit.src_rect });
+		++_stats.batched;
 	}
-}
 
+	flush();
+}
@@ -37,6 +37,20 @@ class DrawableList {
 		/** Iterator type */
 		using iterator = std::vector<Drawable*>::const_iterator;
 
+		/** Statistics of a Draw call */
+		struct DrawStats {
+			/** Drawables which were drawn */
+			int drawn = 0;
+			/** Drawables skipped because they are outside of the destination */
+			int offscreen = 0;
+			/** Drawables skipped because opaque drawables above hide them */
+			int occluded = 0;
+			/** Drawn drawables which were combined into batched blits */
+			int batched = 0;
+			/** Number of batched blits */
+			int batches = 0;
+		};
+
 		/** Sorts the drawables and clears the dirty flag.  */
 		void Sort();
 
@@ -131,10 +145,18 @@ class DrawableList {
 		 */
 		void Draw(Bitmap& dst, Drawable::Z_t min_z, Drawable::Z_t max_z);
 
+		/** @return statistics of the last Draw call */
+		const DrawStats& GetDrawStats() const;
+
 	private:
 		std::vector<Drawable*> _list;
 		bool _dirty = false;
 
+		DrawStats _stats;
+		// Reused by Draw to avoid allocations
+		std::vector<bool> _skip;
+		std::vector<Rect> _occluders;
+
 		void SetClean();
 };
 
@@ -187,6 +209,10 @@ inline void DrawableList::SetClean() {
 	_dirty = false;
 }
 
+inline const DrawableList::DrawStats& DrawableList::GetDrawStats() const {
+	return _stats;
+}
+
 inline void DrawableList::Draw(Bitmap& dst) {
 	Draw(dst, std::numeric_limits<Drawable::Z_t>::min(), std::numeric_limits<Drawable::Z_t>::max());
 }
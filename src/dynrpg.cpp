@@ -24,9 +24,10 @@
 #include "output.h"
 #include "player.h"
 
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
-#include <map>
+#include <unordered_map>
 
 #include "dynrpg_easyrpg.h"
 #include "dynrpg_textplugin.h"
@@ -39,7 +40,7 @@ enum DynRpg_ParseMode {
 	ParseMode_Token
 };
 
-typedef std::map<std::string, dynfunc> dyn_rpg_func;
+typedef std::unordered_map<std::string, dynfunc> dyn_rpg_func;
 
 namespace {
 	bool init = false;
@@ -49,10 +50,34 @@ namespace {
 
 	// DynRpg Function table
 	dyn_rpg_func dyn_rpg_functions;
+
+	struct DynArg {
+		/** Argument or the token of a reference */
+		std::string text;
+		/** N?V* prefix of a variable or actor reference, empty for plain arguments */
+		std::string var_part;
+		/** Number following var_part */
+		int number = 0;
+	};
+
+	struct DynCommand {
+		/** Empty when the command is invalid */
+		std::string function_name;
+		/** Registered function, nullptr when unsupported */
+		dynfunc func = nullptr;
+		std::vector<DynArg> args;
+	};
+
+	// Parsed comment commands, key is the command text.
+	// Events with DynRPG comments usually run them every frame.
+	std::unordered_map<std::string, DynCommand> parsed_commands;
+	constexpr size_t max_parsed_commands = 1024;
 }
 
 void DynRpg::RegisterFunction(const std::string& name, dynfunc func) {
 	dyn_rpg_functions[name] = func;
+	// Invalidates the cached function handles
+	parsed_commands.clear();
 }
 
 bool DynRpg::HasFunction(const std::string& name) {
@@ -113,74 +138,61 @@ std::string DynRpg::ParseVarArg(StringView func_name, dyn_arg_list args, int ind
 }
 
 
-static std::string ParseToken(const std::string& token, const std::string& function_name) {
-	std::string::iterator text_index, end;
-	std::string text = token;
-	text_index = text.begin();
-	end = text.end();
-
-	char chr = *text_index;
-
-	bool first = true;
+static DynArg ParseToken(const std::string& token) {
+	// If a token is (regex) N?V+[0-9]+ it is a reference to a var or an actor
+	DynArg arg;
+	std::string var_part;
+	std::string number_part;
 
 	bool number_encountered = false;
 
-	std::stringstream var_part;
-	std::stringstream number_part;
+	for (size_t i = 0; i < token.size(); ++i) {
+		char chr = token[i];
 
-	for (;;) {
-		if (text_index != end) {
-			chr = *text_index;
+		if (number_encountered || (chr >= '0' && chr <= '9')) {
+			number_encountered = true;
+			number_part += chr;
+		} else if (chr == 'V' || (chr == 'N' && i == 0)) {
+			var_part += chr;
+		} else {
+			// Normal token
+			arg.text = Utils::LowerCase(token);
+			return arg;
 		}
+	}
 
-		if (text_index == end) {
-			// Variable reference
-			std::string tmp = number_part.str();
-			int number = atoi(tmp.c_str());
-			tmp = var_part.str();
-			if (tmp.empty()) {
-				return token;
-			}
+	arg.text = token;
+	if (!var_part.empty()) {
+		arg.var_part = std::move(var_part);
+		arg.number = atoi(number_part.c_str());
+	}
+	return arg;
+}
 
-			// Convert backwards
-			for (std::string::reverse_iterator it = tmp.rbegin(); it != tmp.rend(); ++it) {
-				if (*it == 'N') {
-					if (!Main_Data::game_actors->ActorExists(number)) {
-						Output::Warning("{}: Invalid actor id {} in {}", function_name, number, token);
-						return "";
-					}
+static std::string ResolveArg(const DynArg& arg, const std::string& function_name) {
+	if (arg.var_part.empty()) {
+		return arg.text;
+	}
 
-					// N is last
-					return ToString(Main_Data::game_actors->GetActor(number)->GetName());
-				} else {
-					// Variable
-					number = Main_Data::game_variables->Get(number);
-				}
-			}
+	int number = arg.number;
 
-			number_part.str("");
-			number_part << number;
-			return number_part.str();
-		} else if (number_encountered || (chr >= '0' && chr <= '9')) {
-			number_encountered = true;
-			number_part << chr;
-		} else if (chr == 'N') {
-			if (!first) {
-				break;
+	// Convert backwards
+	for (auto it = arg.var_part.rbegin(); it != arg.var_part.rend(); ++it) {
+		if (*it == 'N') {
+			if (!Main_Data::game_actors->ActorExists(number)) {
+				Output::Warning("{}: Invalid actor id {} in {}", function_name, number, arg.text);
+				return "";
 			}
-			var_part << chr;
-		} else if (chr == 'V') {
-			var_part << chr;
+
+			// N is last
+			return ToString(Main_Data::game_actors->GetActor(number)->GetName());
 		} else {
-			break;
+			// Variable
+			number = Main_Data::game_variables->Get(number);
 		}
-
-		++text_index;
-		first = false;
 	}
 
-	// Normal token
-	return Utils::LowerCase(token);
+	return std::to_string(number);
 }
 
 void create_all_plugins() {
@@ -194,28 +206,26 @@ void create_all_plugins() {
 	init = true;
 }
 
-std::string DynRpg::ParseCommand(const std::string& command, std::vector<std::string>& args) {
+static bool ParseCommandText(const std::string& command, DynCommand& cmd) {
 	if (command.empty()) {
 		// Not a DynRPG function (empty comment)
-		return "";
+		return false;
 	}
 
-	std::string::iterator text_index, end;
-	std::string text = command;
-	text_index = text.begin();
-	end = text.end();
+	auto text_index = command.begin();
+	auto end = command.end();
 
 	char chr = *text_index;
 
 	if (chr != '@') {
 		// Not a DynRPG function, normal comment
-		return "";
+		return false;
 	}
 
 	DynRpg_ParseMode mode = ParseMode_Function;
-	std::string function_name;
-	std::string tmp;
-	std::stringstream token;
+	std::string& function_name = cmd.function_name;
+	auto& args = cmd.args;
+	std::string token;
 
 	++text_index;
 
@@ -224,6 +234,7 @@ std::string DynRpg::ParseCommand(const std::string& command, std::vector<std::st
 	// Number is a valid float number
 	// Tokens are Strings without "" and with Whitespace stripped o_O
 	// If a token is (regex) N?V+[0-9]+ it is resolved to a var or an actor
+	// on every invocation
 
 	// All arguments are passed as string to the DynRpg functions and are
 	// converted to int or float on demand.
@@ -237,11 +248,12 @@ std::string DynRpg::ParseCommand(const std::string& command, std::vector<std::st
 			switch (mode) {
 				case ParseMode_Function:
 					// End of function token
-					function_name = Utils::LowerCase(token.str());
+					function_name = Utils::LowerCase(token);
 					if (function_name.empty()) {
 						// empty function name
 						Output::Warning("Empty DynRPG function name");
-						return "";
+						function_name.clear();
+						return false;
 					}
 					break;
 				case ParseMode_WaitForComma:
@@ -250,16 +262,15 @@ std::string DynRpg::ParseCommand(const std::string& command, std::vector<std::st
 				case ParseMode_WaitForArg:
 					if (!args.empty()) {
 						// Found , but no token -> empty arg
-						args.emplace_back("");
+						args.emplace_back();
 					}
 					break;
 				case ParseMode_String:
 					// Unterminated literal, handled like a terminated literal
-					args.emplace_back(token.str());
+					args.push_back({ token });
 					break;
 				case ParseMode_Token:
-					tmp = ParseToken(token.str(), function_name);
-					args.emplace_back(tmp);
+					args.push_back(ParseToken(token));
 					break;
 			}
 
@@ -268,13 +279,14 @@ std::string DynRpg::ParseCommand(const std::string& command, std::vector<std::st
 			switch (mode) {
 				case ParseMode_Function:
 					// End of function token
-					function_name = Utils::LowerCase(token.str());
+					function_name = Utils::LowerCase(token);
 					if (function_name.empty()) {
 						// empty function name
 						Output::Warning("Empty DynRPG function name");
-						return "";
+						function_name.clear();
+						return false;
 					}
-					token.str("");
+					token.clear();
 
 					mode = ParseMode_WaitForArg;
 					break;
@@ -283,7 +295,7 @@ std::string DynRpg::ParseCommand(const std::string& command, std::vector<std::st
 					// no-op
 					break;
 				case ParseMode_String:
-					token << chr;
+					token += chr;
 					break;
 				case ParseMode_Token:
 					// Skip whitespace
@@ -293,15 +305,16 @@ std::string DynRpg::ParseCommand(const std::string& command, std::vector<std::st
 			switch (mode) {
 				case ParseMode_Function:
 					// End of function token
-					function_name = Utils::LowerCase(token.str());
+					function_name = Utils::LowerCase(token);
 					if (function_name.empty()) {
 						// empty function name
 						Output::Warning("Empty DynRPG function name");
-						return "";
+						function_name.clear();
+						return false;
 					}
-					token.str("");
+					token.clear();
 					// Empty arg
-					args.emplace_back("");
+					args.emplace_back();
 					mode = ParseMode_WaitForArg;
 					break;
 				case ParseMode_WaitForComma:
@@ -309,28 +322,28 @@ std::string DynRpg::ParseCommand(const std::string& command, std::vector<std::st
 					break;
 				case ParseMode_WaitForArg:
 					// Empty arg
-					args.emplace_back("");
+					args.emplace_back();
 					break;
 				case ParseMode_String:
-					token << chr;
+					token += chr;
 					break;
 				case ParseMode_Token:
-					tmp = ParseToken(token.str(), function_name);
-					args.emplace_back(tmp);
+					args.push_back(ParseToken(token));
 					// already on a comma
 					mode = ParseMode_WaitForArg;
-					token.str("");
+					token.clear();
 					break;
 			}
 		} else {
 			// Anything else that isn't special purpose
 			switch (mode) {
 				case ParseMode_Function:
-					token << chr;
+					token += chr;
 					break;
 				case ParseMode_WaitForComma:
 					Output::Warning("{}: Expected \",\", got token", function_name);
-					return "";
+					function_name.clear();
+					return false;
 				case ParseMode_WaitForArg:
 					if (chr == '"') {
 						mode = ParseMode_String;
@@ -338,7 +351,7 @@ std::string DynRpg::ParseCommand(const std::string& command, std::vector<std::st
 					}
 					else {
 						mode = ParseMode_Token;
-						token << chr;
+						token += chr;
 					}
 					break;
 				case ParseMode_String:
@@ -346,23 +359,23 @@ std::string DynRpg::ParseCommand(const std::string& command, std::vector<std::st
 						// Test for "" -> append "
 						// otherwise end of string
 						if (std::distance(text_index, end) > 1 && *std::next(text_index, 1) == '"') {
-							token << '"';
+							token += '"';
 							++text_index;
 						}
 						else {
 							// End of string
-							args.emplace_back(token.str());
+							args.push_back({ token });
 
 							mode = ParseMode_WaitForComma;
-							token.str("");
+							token.clear();
 						}
 					}
 					else {
-						token << chr;
+						token += chr;
 					}
 					break;
 				case ParseMode_Token:
-					token << chr;
+					token += chr;
 					break;
 			}
 		}
@@ -370,7 +383,17 @@ std::string DynRpg::ParseCommand(const std::string& command, std::vector<std::st
 		++text_index;
 	}
 
-	return function_name;
+	return true;
+}
+
+std::string DynRpg::ParseCommand(const std::string& command, std::vector<std::string>& args) {
+	DynCommand cmd;
+	ParseCommandText(command, cmd);
+
+	for (const auto& arg: cmd.args) {
+		args.push_back(ResolveArg(arg, cmd.function_name));
+	}
+	return cmd.function_name;
 }
 
 bool DynRpg::Invoke(const std::string& command) {
@@ -378,14 +401,48 @@ bool DynRpg::Invoke(const std::string& command) {
 		create_all_plugins();
 	}
 
-	std::vector<std::string> args;
-	std::string function_name = ParseCommand(command, args);
+	if (command.empty() || command[0] != '@') {
+		// Not a DynRPG function
+		return true;
+	}
 
-	if (function_name.empty()) {
+	auto it = parsed_commands.find(command);
+	if (it == parsed_commands.end()) {
+		if (parsed_commands.size() >= max_parsed_commands) {
+			parsed_commands.clear();
+		}
+
+		DynCommand cmd;
+		if (ParseCommandText(command, cmd)) {
+			auto fit = dyn_rpg_functions.find(cmd.function_name);
+			if (fit != dyn_rpg_functions.end()) {
+				cmd.func = fit->second;
+			}
+		}
+		it = parsed_commands.emplace(command, std::move(cmd)).first;
+	}
+
+	const DynCommand& cmd = it->second;
+
+	if (cmd.function_name.empty()) {
 		return true;
 	}
 
-	return Invoke(function_name, args);
+	if (!cmd.func) {
+		// Not a supported function
+		Output::Warning("Unsupported DynRPG function: {}", cmd.function_name);
+		return true;
+	}
+
+	std::vector<std::string> args;
+	args.reserve(cmd.args.size());
+	for (const auto& arg: cmd.args) {
+		args.push_back(ResolveArg(arg, cmd.function_name));
+	}
+
+	// The cache can change while the function runs
+	dynfunc func = cmd.func;
+	return func(args);
 }
 
 bool DynRpg::Invoke(const std::string& func, dyn_arg_list args) {
@@ -399,7 +456,7 @@ bool DynRpg::Invoke(const std::string& func, dyn_arg_list args) {
 		return true;
 	}
 
-	return dyn_rpg_functions[func](args);
+	return dyn_rpg_functions.find(func)->second(args);
 }
 
 std::string get_filename(int slot) {
@@ -532,5 +589,6 @@ void DynRpg::Update() {
 void DynRpg::Reset() {
 	init = false;
 	dyn_rpg_functions.clear();
+	parsed_commands.clear();
 	plugins.clear();
 }
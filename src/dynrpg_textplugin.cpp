@@ -56,16 +56,16 @@ public:
 	}
 
 	void AddLine(const std::string& text) {
-		texts.push_back(text);
+		texts.push_back(ReplaceCommandCodes(text));
 
 		Refresh();
 	}
 
 	void AddText(const std::string& text) {
 		if (texts.empty()) {
-			texts.push_back(text);
+			texts.push_back(ReplaceCommandCodes(text));
 		} else {
-			texts.back() += text;
+			texts.back() = ReplaceCommandCodes(texts.back() + text);
 		}
 
 		Refresh();
@@ -108,7 +108,13 @@ public:
 	}
 
 	void Draw(Bitmap& dst) override {
-		if (!bitmap) {
+		if (needs_render) {
+			needs_render = false;
+			canvas.Render(texts, color);
+		}
+
+		const auto& bitmap = canvas.GetBitmap();
+		if (!bitmap || texts.empty()) {
 			return;
 		}
 
@@ -123,9 +129,9 @@ public:
 
 		// For unknown reasons the official plugin has an y-offset of 2
 		if (fixed) {
-			dst.Blit(x - Game_Map::GetDisplayX() / 16, y - Game_Map::GetDisplayY() / 16 + 2, *bitmap, bitmap->GetRect(), sprite->GetOpacity());
+			dst.Blit(x - Game_Map::GetDisplayX() / 16, y - Game_Map::GetDisplayY() / 16 + 2, *bitmap, canvas.GetRect(), sprite->GetOpacity());
 		} else {
-			dst.Blit(x, y + 2, *bitmap, bitmap->GetRect(), sprite->GetOpacity());
+			dst.Blit(x, y + 2, *bitmap, canvas.GetRect(), sprite->GetOpacity());
 		}
 	};
 
@@ -218,40 +224,22 @@ public:
 	}
 
 private:
-	void Refresh() {
-		if (texts.empty()) {
-			bitmap.reset();
-			return;
-		}
-
-		int width = 0;
-		int height = 0;
-
-		const FontRef& font = Font::Default();
-
-		for (auto& t : texts) {
-			PendingMessage pm(CommandCodeInserter);
-			pm.PushLine(t);
-			t = pm.GetLines().front();
-
-			Rect r = Text::GetSize(*font, t);
-			width = std::max(width, r.width);
-			height += r.height + 2;
-		}
-
-		bitmap = Bitmap::Create(width, height, true);
+	static std::string ReplaceCommandCodes(const std::string& text) {
+		PendingMessage pm(CommandCodeInserter);
+		pm.PushLine(text);
+		return pm.GetLines().front();
+	}
 
-		height = 0;
-		for (auto& t : texts) {
-			bitmap->TextDraw(0, height, color, t);
-			height += Text::GetSize(*font, t).height + 2;
-		}
+	void Refresh() {
+		// Rendered on the next Draw, texts are often changed several times per frame
+		needs_render = true;
 
 		SetPictureId(pic_id);
 	}
 
 	std::vector<std::string> texts;
-	BitmapRef bitmap;
+	DynRpg::TextBitmap canvas;
+	bool needs_render = false;
 	int pic_id = 1;
 	int x = 0;
 	int y = 0;
@@ -259,6 +247,78 @@ private:
 	bool fixed = false;
 };
 
+std::vector<int> DynRpg::TextBitmap::Render(const std::vector<std::string>& texts, int color) {
+	const FontRef& font = Font::Default();
+
+	std::vector<Line> layout;
+	layout.reserve(texts.size());
+
+	int width = 0;
+	int height = 0;
+
+	for (size_t i = 0; i < texts.size(); ++i) {
+		Line line;
+		line.text = texts[i];
+		line.color = color;
+		line.y = height;
+		if (i < lines.size() && lines[i].text == line.text) {
+			line.size = lines[i].size;
+		} else {
+			line.size = Text::GetSize(*font, line.text);
+		}
+
+		width = std::max(width, line.size.width);
+		height += line.size.height + 2;
+		layout.push_back(std::move(line));
+	}
+
+	rect = { 0, 0, width, height };
+
+	if (texts.empty()) {
+		lines.clear();
+		return {};
+	}
+
+	if (!bitmap || bitmap->width() < width || bitmap->height() < height) {
+		int new_width = bitmap ? std::max(bitmap->width(), width) : width;
+		int new_height = bitmap ? std::max(bitmap->height(), height) : height;
+		bitmap = Bitmap::Create(new_width, new_height, true);
+		lines.clear();
+	}
+
+	auto is_same = [](const Line& l, const Line& r) {
+		return l.y == r.y && l.color == r.color && l.size.height == r.size.height && l.text == r.text;
+	};
+
+	auto clear_line = [&](const Line& line) {
+		bitmap->ClearRect({ 0, line.y, bitmap->width(), line.size.height + 2 });
+	};
+
+	for (size_t i = 0; i < std::max(layout.size(), lines.size()); ++i) {
+		if (i < layout.size() && i < lines.size() && is_same(layout[i], lines[i])) {
+			continue;
+		}
+		if (i < lines.size()) {
+			clear_line(lines[i]);
+		}
+		if (i < layout.size()) {
+			clear_line(layout[i]);
+		}
+	}
+
+	std::vector<int> drawn;
+	for (size_t i = 0; i < layout.size(); ++i) {
+		if (i < lines.size() && is_same(layout[i], lines[i])) {
+			continue;
+		}
+		bitmap->TextDraw(0, layout[i].y, color, layout[i].text);
+		drawn.push_back(static_cast<int>(i));
+	}
+
+	lines = std::move(layout);
+	return drawn;
+}
+
 static bool WriteText(dyn_arg_list args) {
 	auto func = "write_text";
 	bool okay;
@@ -19,8 +19,47 @@
 #define EP_DYNRPG_TEXTPLUGIN_H
 
 #include "dynrpg.h"
+#include "memory_management.h"
+#include "rect.h"
 
 namespace DynRpg {
+	/**
+	 * Bitmap with the lines of a DynRPG text. Only lines which changed since
+	 * the last call of Render are drawn again.
+	 */
+	class TextBitmap {
+	public:
+		/**
+		 * Draws the lines which changed since the last call.
+		 * The bitmap is only recreated when it is too small for the text.
+		 *
+		 * @param texts lines of the text
+		 * @param color text color
+		 * @return indices of the lines which were drawn
+		 */
+		std::vector<int> Render(const std::vector<std::string>& texts, int color);
+
+		/** @return bitmap with the text, nullptr before the first text was rendered */
+		const BitmapRef& GetBitmap() const;
+
+		/** @return area of the bitmap covered by the text */
+		const Rect& GetRect() const;
+
+	private:
+		/** A line as it was drawn into the bitmap */
+		struct Line {
+			std::string text;
+			int color = 0;
+			int y = 0;
+			Rect size;
+		};
+
+		/** Lines drawn into the bitmap */
+		std::vector<Line> lines;
+		BitmapRef bitmap;
+		Rect rect;
+	};
+
 	class TextPlugin : public DynRpgPlugin {
 	public:
 		TextPlugin() : DynRpgPlugin("DynTextPlugin") {}
@@ -31,6 +70,14 @@ namespace DynRpg {
 		void Load(const std::vector<uint8_t>&) override;
 		std::vector<uint8_t> Save() override;
 	};
+
+	inline const BitmapRef& TextBitmap::GetBitmap() const {
+		return bitmap;
+	}
+
+	inline const Rect& TextBitmap::GetRect() const {
+		return rect;
+	}
 }
 
 #endif
@@ -26,6 +26,7 @@
 #include "player.h"
 #include "output.h"
 #include "rand.h"
+#include "worker_pool.h"
 #include <lcf/reader_util.h>
 #include <lcf/data.h>
 
@@ -44,6 +45,9 @@ static void DebugLog(const char*, Args&&...) {}
 constexpr decltype(RpgRtCompat::name) RpgRtCompat::name;
 constexpr decltype(RpgRtImproved::name) RpgRtImproved::name;
 
+// Below this amount of actions handing the work to the workers costs more than it saves
+static constexpr int min_parallel_actions = 8;
+
 static std::shared_ptr<Game_BattleAlgorithm::AlgorithmBase> MakeAttack(Game_Enemy& enemy, int hits) {
 	return std::make_shared<Game_BattleAlgorithm::Normal>(&enemy, Main_Data::game_party->GetRandomActiveBattler(), hits);
 }
@@ -318,13 +322,20 @@ void SelectEnemyAiActionRpgRtCompat(Game_Enemy& source, bool emulate_bugs) {
 		}
 	}
 
+	// The target checks only read the battle state and are independent of each other
+	std::vector<char> effective(actions.size(), true);
+	WorkerPool::ParallelFor(static_cast<int>(actions.size()), [&](int i) {
+		const auto& action = actions[i];
+		if (action.kind == lcf::rpg::EnemyAction::Kind_skill && prios[i] > 0) {
+			effective[i] = IsSkillEffectiveOnAnyTarget(source, action.skill_id, emulate_bugs);
+		}
+	}, min_parallel_actions);
+
 	for (int i = 0; i < static_cast<int>(actions.size()); ++i) {
 		const auto& action = actions[i];
-		if (action.kind == lcf::rpg::EnemyAction::Kind_skill) {
-			if (prios[i] > 0 && !IsSkillEffectiveOnAnyTarget(source, action.skill_id, emulate_bugs)) {
-				DebugLog("ENEMYAI: Enemy {}({}) Discard Action id={} kind={} basic={}, rating={}: No effective targets!", source.GetName(), source.GetTroopMemberId(), action.ID, action.kind, action.basic, action.rating);
-				prios[i] = 0;
-			}
+		if (!effective[i]) {
+			DebugLog("ENEMYAI: Enemy {}({}) Discard Action id={} kind={} basic={}, rating={}: No effective targets!", source.GetName(), source.GetTroopMemberId(), action.ID, action.kind, action.basic, action.rating);
+			prios[i] = 0;
 		}
 	}
 
@@ -0,0 +1,137 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "event_command_list.h"
+
+#include <algorithm>
+#ifdef HAVE_THREADS
+#  include <mutex>
+#endif
+
+namespace {
+	/** Slots of the command codes, filled when a code is seen first */
+	std::unordered_map<int, int> code_slots;
+
+#ifdef HAVE_THREADS
+	std::mutex code_slots_mutex;
+
+	std::unique_lock<std::mutex> Lock() {
+		return std::unique_lock<std::mutex>(code_slots_mutex);
+	}
+#else
+	struct NoLock {
+		~NoLock() {}
+	};
+
+	NoLock Lock() {
+		return {};
+	}
+#endif
+
+	int GetCodeSlotLocked(int code) {
+		return code_slots.emplace(code, static_cast<int>(code_slots.size())).first->second;
+	}
+}
+
+EventCommandList::EventCommandList(std::vector<lcf::rpg::EventCommand> commands)
+	: commands(std::move(commands))
+{
+	const auto& list = this->commands;
+	const int size = static_cast<int>(list.size());
+
+	// Walk backwards and keep the candidates with decreasing indentation.
+	// The first candidate with a lower indentation ends the block.
+	block_end.resize(size);
+	std::vector<int> candidates;
+	for (int i = size - 1; i >= 0; --i) {
+		while (!candidates.empty() && list[candidates.back()].indent >= list[i].indent) {
+			candidates.pop_back();
+		}
+		block_end[i] = candidates.empty() ? size : candidates.back();
+		candidates.push_back(i);
+	}
+
+	slots.resize(size);
+	{
+		auto lock = Lock();
+		for (int i = 0; i < size; ++i) {
+			slots[i] = GetCodeSlotLocked(list[i].code);
+		}
+	}
+
+	for (int i = 0; i < size; ++i) {
+		const auto code = static_cast<Cmd>(list[i].code);
+		if (code == Cmd::Label && !list[i].parameters.empty()) {
+			labels.emplace(list[i].parameters[0], i);
+		} else if (code == Cmd::EndLoop) {
+			loop_begin.emplace(i, ScanLoopBegin(i, list[i].indent));
+		}
+	}
+}
+
+int EventCommandList::FindNext(int index, std::initializer_list<Cmd> codes, int indent) const {
+	const int size = static_cast<int>(commands.size());
+
+	int idx = index + 1;
+	while (idx < size) {
+		const auto& com = commands[idx];
+		if (com.indent > indent) {
+			// Everything up to the end of the block is nested even deeper
+			idx = block_end[idx];
+			continue;
+		}
+		if (std::find(codes.begin(), codes.end(), static_cast<Cmd>(com.code)) != codes.end()) {
+			break;
+		}
+		++idx;
+	}
+
+	return std::min(idx, size);
+}
+
+int EventCommandList::FindLabel(int label_id) const {
+	auto it = labels.find(label_id);
+	return it != labels.end() ? it->second : -1;
+}
+
+int EventCommandList::FindLoopBegin(int index, int indent) const {
+	if (index >= 0 && index < static_cast<int>(commands.size()) && commands[index].indent == indent) {
+		auto it = loop_begin.find(index);
+		if (it != loop_begin.end()) {
+			return it->second;
+		}
+	}
+	return ScanLoopBegin(index, indent);
+}
+
+int EventCommandList::ScanLoopBegin(int index, int indent) const {
+	for (int idx = index; idx >= 0; idx--) {
+		if (commands[idx].indent > indent)
+			continue;
+		if (commands[idx].indent < indent)
+			return -1;
+		if (static_cast<Cmd>(commands[idx].code) != Cmd::Loop)
+			continue;
+		return idx;
+	}
+	return index;
+}
+
+int EventCommandList::GetCodeSlot(int code) {
+	auto lock = Lock();
+	return GetCodeSlotLocked(code);
+}
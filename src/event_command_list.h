@@ -0,0 +1,112 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_EVENT_COMMAND_LIST_H
+#define EP_EVENT_COMMAND_LIST_H
+
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+#include <lcf/rpg/eventcommand.h>
+
+/**
+ * Immutable event commands executed by the interpreter.
+ *
+ * Conditional branches, choices and loops jump over nested commands by
+ * scanning the list. The nesting is decoded once when the list is created,
+ * so the jumps skip whole blocks instead of visiting every command.
+ *
+ * The command codes are sparse, every code gets a dense slot which the
+ * interpreter uses as the index into its table of command handlers.
+ */
+class EventCommandList {
+public:
+	using Cmd = lcf::rpg::EventCommand::Code;
+
+	EventCommandList() = default;
+
+	/** @param commands event commands, the list never changes afterwards */
+	explicit EventCommandList(std::vector<lcf::rpg::EventCommand> commands);
+
+	/** @return event commands */
+	const std::vector<lcf::rpg::EventCommand>& GetCommands() const;
+
+	/**
+	 * Finds the next command with one of the codes which is not nested
+	 * deeper than indent.
+	 *
+	 * @param index search starts after this command
+	 * @param codes command codes to search for
+	 * @param indent maximum indentation
+	 * @return index of the command or the size of the list when not found
+	 */
+	int FindNext(int index, std::initializer_list<Cmd> codes, int indent) const;
+
+	/**
+	 * @param label_id id of the label
+	 * @return index of the first label command with the id or -1
+	 */
+	int FindLabel(int label_id) const;
+
+	/**
+	 * Finds the loop command an end loop command jumps back to.
+	 *
+	 * @param index index of the end loop command
+	 * @param indent indentation of the loop
+	 * @return index of the loop command, -1 when a command of a lower
+	 * indentation comes first or index when there is no loop command
+	 */
+	int FindLoopBegin(int index, int indent) const;
+
+	/**
+	 * @param index index of the command
+	 * @return slot of the command code, see GetCodeSlot
+	 */
+	int GetSlot(int index) const;
+
+	/**
+	 * Assigns a slot to a command code. Different codes get different slots
+	 * and a code always gets the same slot.
+	 *
+	 * @param code command code
+	 * @return slot of the code
+	 */
+	static int GetCodeSlot(int code);
+
+private:
+	int ScanLoopBegin(int index, int indent) const;
+
+	std::vector<lcf::rpg::EventCommand> commands;
+	/** Index of the first command after i with a lower indentation than i */
+	std::vector<int> block_end;
+	/** Slot of the code of every command */
+	std::vector<int> slots;
+	/** Result of FindLoopBegin for the end loop commands */
+	std::unordered_map<int, int> loop_begin;
+	/** Index of the first label command for every label id */
+	std::unordered_map<int, int> labels;
+};
+
+inline const std::vector<lcf::rpg::EventCommand>& EventCommandList::GetCommands() const {
+	return commands;
+}
+
+inline int EventCommandList::GetSlot(int index) const {
+	return slots[index];
+}
+
+#endif
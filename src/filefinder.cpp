@@ -43,6 +43,7 @@
 #include "fileext_guesser.h"
 #include "output.h"
 #include "player.h"
+#include "game_config.h"
 #include "registry.h"
 #include "main_data.h"
 #include <lcf/reader_util.h>
@@ -61,6 +62,14 @@ namespace {
 	std::shared_ptr<Filesystem> root_fs;
 	FilesystemView game_fs;
 	FilesystemView save_fs;
+
+	std::vector<FilesystemView> indexed_fs;
+	constexpr StringView directory_index_dir = "DirectoryIndex";
+
+	std::string GetDirectoryIndexName(const FilesystemView& fs) {
+		std::istringstream ss(fs.GetFullPath());
+		return fmt::format("{:08x}.idx", Utils::CRC32(ss));
+	}
 }
 
 FilesystemView FileFinder::Game() {
@@ -291,9 +300,67 @@ bool FileFinder::IsSupportedArchiveExtension(std::string path) {
 }
 
 void FileFinder::Quit() {
+	indexed_fs.clear();
 	root_fs.reset();
 }
 
+void FileFinder::LoadDirectoryIndex(const FilesystemView& fs) {
+	if (!fs || !Player::player_config.directory_index.Get()) {
+		return;
+	}
+
+	// Archives do not provide modification times, they are in memory anyway
+	if (fs.GetModificationTime("") < 0) {
+		return;
+	}
+
+	const auto full_path = fs.GetFullPath();
+	if (std::any_of(indexed_fs.begin(), indexed_fs.end(), [&](const auto& ifs) { return ifs.GetFullPath() == full_path; })) {
+		return;
+	}
+	indexed_fs.push_back(fs);
+
+	auto cfg_fs = Game_Config::GetGlobalConfigFilesystem();
+	if (!cfg_fs) {
+		return;
+	}
+
+	auto is = cfg_fs.OpenFile(directory_index_dir, GetDirectoryIndexName(fs));
+	if (!is) {
+		// Still registers the filesystem: The index is written on shutdown
+		std::istringstream no_index;
+		fs.LoadDirectoryIndex(no_index);
+		Output::Debug("No directory index of {} yet", full_path);
+		return;
+	}
+
+	if (fs.LoadDirectoryIndex(is)) {
+		Output::Debug("Loaded directory index of {}", full_path);
+	} else {
+		Output::Debug("Directory index of {} is invalid", full_path);
+	}
+}
+
+void FileFinder::SaveDirectoryIndexes() {
+	if (indexed_fs.empty()) {
+		return;
+	}
+
+	auto cfg_fs = Game_Config::GetGlobalConfigFilesystem();
+	if (!cfg_fs || !cfg_fs.MakeDirectory(directory_index_dir, true)) {
+		return;
+	}
+
+	for (const auto& fs : indexed_fs) {
+		auto os = cfg_fs.OpenOutputStream(FileFinder::MakePath(directory_index_dir, GetDirectoryIndexName(fs)));
+		if (!os) {
+			Output::Debug("Could not write directory index of {}", fs.GetFullPath());
+			continue;
+		}
+		fs.WriteDirectoryIndex(os);
+	}
+}
+
 bool FileFinder::IsValidProject(const FilesystemView& fs) {
 	return IsRPG2kProject(fs) || IsEasyRpgProject(fs) || IsRPG2kProjectWithRenames(fs);
 }
@@ -552,7 +619,7 @@ std::vector<FilesystemView> FileFinder::FindGames(FilesystemView fs, int recursi
 			if (entry.type == DirectoryTree::FileType::Directory) {
 				find_recursive(subfs.Subtree(entry.name), rec_limit - 1);
 			} else if (entry.type == DirectoryTree::FileType::Regular && IsSupportedArchiveExtension(entry.name)) {
-				find_recursive(fs.Create(entry.name), rec_limit - 1);
+				find_recursive(subfs.Create(entry.name), rec_limit - 1);
 			}
 		}
 	};
@@ -80,6 +80,24 @@ namespace FileFinder {
 	 */
 	void SetSaveFilesystem(FilesystemView filesystem);
 
+	/**
+	 * Loads the persistent directory index of the filesystem from the config
+	 * directory when the directory index is enabled in the settings.
+	 * Directories which did not change since the index was written are not
+	 * read again from the disk.
+	 * Without an index file the filesystem is indexed for the next start.
+	 * Only filesystems which report modification times are supported.
+	 *
+	 * @param fs filesystem (game, RTP, ...) the index belongs to
+	 */
+	void LoadDirectoryIndex(const FilesystemView& fs);
+
+	/**
+	 * Writes the directory indexes of all filesystems passed to
+	 * LoadDirectoryIndex to the config directory.
+	 */
+	void SaveDirectoryIndexes();
+
 	/**
 	 * Finds an image file in the current RPG Maker game.
 	 *
@@ -182,6 +182,8 @@ void FileFinder_RTP::AddPath(StringView p) {
 	using namespace FileFinder;
 	auto fs = FileFinder::Root().Create(FileFinder::MakeCanonical(p));
 	if (fs) {
+		FileFinder::LoadDirectoryIndex(fs);
+
 		auto files = fs.ListDirectory();
 		if (files->size() == 0) {
 			Output::Debug("RTP path {} is empty, not adding", p);
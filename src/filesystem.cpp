@@ -84,6 +84,14 @@ void Filesystem::ClearCache(StringView path) const {
 	tree->ClearCache(path);
 }
 
+bool Filesystem::LoadDirectoryIndex(std::istream& is, StringView path) const {
+	return tree->LoadIndex(is, path);
+}
+
+void Filesystem::WriteDirectoryIndex(std::ostream& os, StringView path) const {
+	tree->WriteIndex(os, path);
+}
+
 FilesystemView Filesystem::Create(StringView path) const {
 	// Determine the proper file system to use
 
@@ -238,6 +246,16 @@ void FilesystemView::ClearCache() const {
 	fs->ClearCache(GetSubPath());
 }
 
+bool FilesystemView::LoadDirectoryIndex(std::istream& is) const {
+	assert(fs);
+	return fs->LoadDirectoryIndex(is, GetSubPath());
+}
+
+void FilesystemView::WriteDirectoryIndex(std::ostream& os) const {
+	assert(fs);
+	fs->WriteDirectoryIndex(os, GetSubPath());
+}
+
 std::string FilesystemView::FindFile(StringView name, const Span<const StringView> exts) const {
 	assert(fs);
 	std::string found = fs->FindFile(MakePath(name), exts);
@@ -317,6 +335,11 @@ int64_t FilesystemView::GetFilesize(StringView path) const {
 	return fs->GetFilesize(MakePath(path));
 }
 
+int64_t FilesystemView::GetModificationTime(StringView path) const {
+	assert(fs);
+	return fs->GetModificationTime(MakePath(path));
+}
+
 DirectoryTree::DirectoryListType* FilesystemView::ListDirectory(StringView path) const {
 	assert(fs);
 	return fs->ListDirectory(MakePath(path));
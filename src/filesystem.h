@@ -127,6 +127,25 @@ public:
 	 */
 	void ClearCache(StringView path) const;
 
+	/**
+	 * Loads a persistent directory index for the path.
+	 *
+	 * @see DirectoryTree::LoadIndex
+	 * @param is stream to read the index from
+	 * @param path Path the index belongs to
+	 * @return whether the index is valid
+	 */
+	bool LoadDirectoryIndex(std::istream& is, StringView path) const;
+
+	/**
+	 * Writes a persistent directory index for the path.
+	 *
+	 * @see DirectoryTree::WriteIndex
+	 * @param os stream to write the index to
+	 * @param path Path the index belongs to
+	 */
+	void WriteDirectoryIndex(std::ostream& os, StringView path) const;
+
 	/**
 	 * Creates a new appropriate filesystem from the specified path.
 	 * The path is processed to initialize the proper virtual filesystem handler.
@@ -219,6 +238,7 @@ public:
 	virtual bool IsDirectory(StringView path, bool follow_symlinks) const = 0;
 	virtual bool Exists(StringView path) const = 0;
 	virtual int64_t GetFilesize(StringView path) const = 0;
+	virtual int64_t GetModificationTime(StringView path) const;
 	virtual bool MakeDirectory(StringView dir, bool follow_symlinks) const;
 	virtual bool IsFeatureSupported(Feature f) const;
 	virtual std::string Describe() const = 0;
@@ -288,6 +308,23 @@ public:
 	 */
 	void ClearCache() const;
 
+	/**
+	 * Loads a persistent directory index for the view.
+	 *
+	 * @see DirectoryTree::LoadIndex
+	 * @param is stream to read the index from
+	 * @return whether the index is valid
+	 */
+	bool LoadDirectoryIndex(std::istream& is) const;
+
+	/**
+	 * Writes a persistent directory index for the view.
+	 *
+	 * @see DirectoryTree::WriteIndex
+	 * @param os stream to write the index to
+	 */
+	void WriteDirectoryIndex(std::ostream& os) const;
+
 	/**
 	 * Does a case insensitive search for the file.
 	 *
@@ -381,6 +418,16 @@ public:
 	 */
 	int64_t GetFilesize(StringView path) const;
 
+	/**
+	 * Retrieves the last modification time of a file.
+	 * Archive filesystems do not provide this, their content does not change
+	 * while the Player runs.
+	 *
+	 * @param path Path to check
+	 * @return Modification time in seconds since the epoch or -1 when unknown.
+	 */
+	int64_t GetModificationTime(StringView path) const;
+
 	/**
 	 * Enumerates a directory.
 	 *
@@ -505,6 +552,10 @@ inline bool Filesystem::IsFeatureSupported(Filesystem::Feature) const {
 	return false;
 }
 
+inline int64_t Filesystem::GetModificationTime(StringView) const {
+	return -1;
+}
+
 inline std::streambuf* Filesystem::CreateOutputStreambuffer(StringView, std::ios_base::openmode) const {
 	assert(!IsFeatureSupported(Feature::Write) && "Write supported but CreateOutputStreambuffer not implemented");
 	return nullptr;
@@ -54,6 +54,10 @@ int64_t NativeFilesystem::GetFilesize(StringView path) const {
 	return Platform::File(ToString(path)).GetSize();
 }
 
+int64_t NativeFilesystem::GetModificationTime(StringView path) const {
+	return Platform::File(ToString(path)).GetModificationTime();
+}
+
 std::streambuf* NativeFilesystem::CreateInputStreambuffer(StringView path, std::ios_base::openmode mode) const {
 #ifdef USE_CUSTOM_FILEBUF
 	(void)mode;
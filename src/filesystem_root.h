@@ -64,6 +64,7 @@ protected:
 	bool IsDirectory(StringView path, bool follow_symlinks) const override;
 	bool Exists(StringView path) const override;
 	int64_t GetFilesize(StringView path) const override;
+	int64_t GetModificationTime(StringView path) const override;
 	std::streambuf* CreateInputStreambuffer(StringView path, std::ios_base::openmode mode) const override;
 	std::streambuf* CreateOutputStreambuffer(StringView path, std::ios_base::openmode mode) const override;
 	bool GetDirectoryContent(StringView path, std::vector<DirectoryTree::Entry>& entries) const override;
@@ -45,6 +45,7 @@
 #include "filefinder.h"
 #include "output.h"
 #include "font.h"
+#include "text.h"
 #include "bitmap.h"
 #include "utils.h"
 #include "cache.h"
@@ -615,7 +616,14 @@ FontRef Font::DefaultBitmapFont(bool use_mincho) {
 	}
 }
 
+uint32_t Font::GetUniqueId() const {
+	return unique_id;
+}
+
 void Font::SetDefault(FontRef new_default, bool use_mincho) {
+	// The fallback font of the new default is not part of the text cache key
+	Text::ClearCache();
+
 	if (use_mincho) {
 		default_mincho = new_default;
 	} else {
@@ -694,6 +702,9 @@ void Font::Dispose() {
 Font::Font(StringView name, int size, bool bold, bool italic)
 	: name(ToString(name))
 {
+	static uint32_t next_id = 0;
+	unique_id = ++next_id;
+
 	original_style.size = size;
 	original_style.bold = bold;
 	original_style.italic = italic;
@@ -812,8 +823,7 @@ bool Font::RenderImpl(Bitmap& dest, int const x, int const y, const Bitmap& sys,
 				dest.MaskedBlit(rect, *gret.bitmap, 0, 0, *sys_large, src_x, src_y);
 			} else {
 				auto col = sys.GetColorAt(current_style.color_offset.x + src_x, current_style.color_offset.y + src_y);
-				auto col_bm = Bitmap::Create(gret.bitmap->width(), gret.bitmap->height(), col);
-				dest.MaskedBlit(rect, *gret.bitmap, 0, 0, *col_bm, 0, 0);
+				dest.MaskedBlit(rect, *gret.bitmap, 0, 0, col);
 			}
 		} else {
 			// Color glyphs, emojis etc.
@@ -851,8 +861,7 @@ bool Font::RenderImpl(Bitmap& dest, int const x, int const y, const Bitmap& sys,
 			dest.MaskedBlit(rect, *gret.bitmap, 0, 0, sys, src_x, src_y);
 		} else {
 			auto col = sys.GetColorAt(current_style.color_offset.x + src_x, current_style.color_offset.y + src_y);
-			auto col_bm = Bitmap::Create(gret.bitmap->width(), gret.bitmap->height(), col);
-			dest.MaskedBlit(rect, *gret.bitmap, 0, 0, *col_bm, 0, 0);
+			dest.MaskedBlit(rect, *gret.bitmap, 0, 0, col);
 		}
 	} else {
 		// Color glyphs, emojis etc.
@@ -238,6 +238,14 @@ class Font {
 
 	static FontRef exfont;
 
+	/**
+	 * Identifies the font in caches. Unlike the address it is never reused
+	 * by another font.
+	 *
+	 * @return unique identifier of the font
+	 */
+	uint32_t GetUniqueId() const;
+
 	enum SystemColor {
 		ColorShadow = -1,
 		ColorDefault = 0,
@@ -264,6 +272,8 @@ class Font {
 	FontRef fallback_font;
 
 private:
+	uint32_t unique_id = 0;
+
 	bool RenderImpl(Bitmap& dest, int const x, int const y, const Bitmap& sys, int color, const GlyphRet& gret) const;
 };
 
@@ -18,12 +18,14 @@
 #include <sstream>
 
 #include "fps_overlay.h"
+#include "baseui.h"
 #include "game_clock.h"
 #include "bitmap.h"
 #include "utils.h"
 #include "input.h"
 #include "font.h"
 #include "drawable_mgr.h"
+#include "drawable_list.h"
 
 using namespace std::chrono_literals;
 
@@ -40,6 +42,21 @@ FpsOverlay::FpsOverlay() :
 void FpsOverlay::UpdateText() {
 	auto fps = Utils::RoundTo<int>(Game_Clock::GetFPS());
 	text = "FPS: " + std::to_string(fps);
+
+	// Only measured by some UIs
+	auto upload_time = DisplayUi ? DisplayUi->TakeUploadTime() : Game_Clock::duration(0);
+	if (upload_time > Game_Clock::duration(0)) {
+		auto ms = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(upload_time).count();
+		text += fmt::format(" Upload: {:.2f}ms", ms);
+	}
+
+	if (auto* list = DrawableMgr::GetLocalListPtr()) {
+		const auto& stats = list->GetDrawStats();
+		int skipped = stats.offscreen + stats.occluded;
+		if (skipped > 0) {
+			text += fmt::format(" Skipped: {}/{}", skipped, stats.drawn + skipped);
+		}
+	}
 	fps_dirty = true;
 }
 
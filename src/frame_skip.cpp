@@ -0,0 +1,71 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "frame_skip.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std::chrono_literals;
+
+namespace {
+	// Drawing may take up to 1/draw_share of the time
+	constexpr int draw_share = 10;
+
+	// Never wait longer than this for the next drawn frame
+	constexpr auto max_frame_time = 100ms;
+
+	// Weight of the newest measurement is 1/smoothing
+	constexpr int smoothing = 8;
+
+	void AddSample(Game_Clock::duration& avg, Game_Clock::duration dt) {
+		if (avg == Game_Clock::duration()) {
+			avg = dt;
+		} else {
+			avg += (dt - avg) / smoothing;
+		}
+	}
+}
+
+void FrameSkip::AddStepTime(Game_Clock::duration dt) {
+	AddSample(step_time, dt);
+}
+
+void FrameSkip::AddDrawTime(Game_Clock::duration dt) {
+	AddSample(draw_time, dt);
+}
+
+int FrameSkip::GetStepsPerFrame(float speed) const {
+	// Steps for two frames at the requested speed, the headroom catches up
+	// when a frame took a bit longer
+	int steps = std::max(static_cast<int>(std::ceil(speed * 2.0f)), 1);
+
+	if (step_time <= Game_Clock::duration()) {
+		return steps;
+	}
+
+	int draw_steps = static_cast<int>(draw_time * (draw_share - 1) / step_time) + 1;
+	int max_steps = static_cast<int>(std::chrono::duration_cast<Game_Clock::duration>(max_frame_time) / step_time);
+
+	return std::max(steps, std::min(draw_steps, max_steps));
+}
+
+void FrameSkip::Reset() {
+	step_time = {};
+	draw_time = {};
+}
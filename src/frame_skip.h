@@ -0,0 +1,77 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_FRAME_SKIP_H
+#define EP_FRAME_SKIP_H
+
+// Headers
+#include "game_clock.h"
+
+/**
+ * Decides how many logic steps run between two drawn frames while fast
+ * forwarding.
+ *
+ * When the device cannot simulate the requested speed, drawing every frame
+ * wastes time that is missing for the game logic. The number of steps per
+ * drawn frame is increased until drawing only takes a small share of the
+ * time, based on the measured cost of a step and of a drawn frame.
+ */
+class FrameSkip {
+public:
+	/**
+	 * Records the duration of one logic step.
+	 *
+	 * @param dt time the step took
+	 */
+	void AddStepTime(Game_Clock::duration dt);
+
+	/**
+	 * Records the duration of drawing and presenting one frame.
+	 *
+	 * @param dt time the frame took
+	 */
+	void AddDrawTime(Game_Clock::duration dt);
+
+	/**
+	 * @param speed game speed factor
+	 * @return maximum amount of logic steps before the next frame is drawn
+	 */
+	int GetStepsPerFrame(float speed) const;
+
+	/** Forgets all measurements. */
+	void Reset();
+
+	/** @return average duration of a logic step */
+	Game_Clock::duration GetStepTime() const;
+
+	/** @return average duration of a drawn frame */
+	Game_Clock::duration GetDrawTime() const;
+
+private:
+	Game_Clock::duration step_time = {};
+	Game_Clock::duration draw_time = {};
+};
+
+inline Game_Clock::duration FrameSkip::GetStepTime() const {
+	return step_time;
+}
+
+inline Game_Clock::duration FrameSkip::GetDrawTime() const {
+	return draw_time;
+}
+
+#endif
@@ -851,6 +851,35 @@ bool Game_Character::IsSpinning() const {
 	return GetAnimationType() == lcf::rpg::EventPage::AnimType_spin;
 }
 
+bool Game_Character::IsAnimationSettled() const {
+	// Mirrors the conditions of UpdateAnimation() for a stopped character
+	if (IsSpinning()) {
+		return false;
+	}
+
+	if (IsAnimPaused()) {
+		return GetAnimCount() == 0
+			&& (GetAnimationType() == lcf::rpg::EventPage::AnimType_fixed_graphic
+				|| GetAnimFrame() == lcf::rpg::EventPage::Frame_middle);
+	}
+
+	if (!IsAnimated()) {
+		return true;
+	}
+
+	if (IsContinuous() || GetStopCount() == 0) {
+		return false;
+	}
+
+	const auto speed = Utils::Clamp(GetMoveSpeed(), 1, 6);
+	const auto anim_frame = GetAnimFrame();
+
+	return anim_frame != lcf::rpg::EventPage::Frame_left
+		&& anim_frame != lcf::rpg::EventPage::Frame_right
+		&& GetAnimCount() >= GetStationaryAnimFrames(speed) - 1
+		&& GetAnimCount() < GetContinuousAnimFrames(speed);
+}
+
 int Game_Character::GetBushDepth() const {
 	if ((GetLayer() != lcf::rpg::EventPage::Layers_same) || IsJumping() || IsFlying()) {
 		return 0;
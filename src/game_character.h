@@ -872,6 +872,14 @@ public:
 	 */
 	bool IsSpinning() const;
 
+	/**
+	 * Tests if the step animation reached a state where UpdateAnimation()
+	 * does not change anything anymore while the character is not moving.
+	 *
+	 * @return Whether the animation of a stopped character is settled
+	 */
+	bool IsAnimationSettled() const;
+
 	/**
 	 * Gets the bush depth of the tile where this character is standing
 	 *
@@ -70,6 +70,18 @@ public:
 	 */
 	static void SetMaxGameTimePerFrame(duration dt);
 
+	/**
+	 * Disables the limit set by SetMaxGameTimePerFrame. The caller must limit
+	 * the simulation steps per frame itself and call DiscardGameTime when it
+	 * cannot keep up, otherwise the game time that was not simulated piles up.
+	 *
+	 * @param uncapped whether the limit is disabled
+	 */
+	static void SetUncapped(bool uncapped);
+
+	/** Drops the game time which was not simulated yet. */
+	static void DiscardGameTime();
+
 	/** Set the speed up or slowdown factor we'll use to run the game. */
 	static void SetGameSpeedFactor(float speed);
 
@@ -117,6 +129,7 @@ private:
 		float speed = 1.0;
 		float fps = 0.0;
 		int frame = 0;
+		bool uncapped = false;
 	};
 	static Data data;
 };
@@ -172,6 +185,14 @@ inline void Game_Clock::SetMaxGameTimePerFrame(duration dt) {
 	data.max_frame_accumulator = std::max(dt, GetTargetGameTimeStep());
 }
 
+inline void Game_Clock::SetUncapped(bool uncapped) {
+	data.uncapped = uncapped;
+}
+
+inline void Game_Clock::DiscardGameTime() {
+	data.frame_accumulator = {};
+}
+
 inline void Game_Clock::SetGameSpeedFactor(float s) {
 	data.speed = s;
 }
@@ -19,9 +19,12 @@
 #include "game_commonevent.h"
 #include "game_map.h"
 #include "game_switches.h"
+#include "game_variables.h"
 #include "game_interpreter_map.h"
 #include "main_data.h"
+#include "player.h"
 #include <lcf/reader_util.h>
+#include <algorithm>
 #include <cassert>
 
 Game_CommonEvent::Game_CommonEvent(int common_event_id) :
@@ -33,9 +36,82 @@ Game_CommonEvent::Game_CommonEvent(int common_event_id) :
 			&& !ce->event_commands.empty()) {
 		interpreter.reset(new Game_Interpreter_Map());
 		interpreter->Push(this);
+		access = AnalyzeAccess(ce->event_commands);
 	}
+}
+
+Game_CommonEvent::Access Game_CommonEvent::AnalyzeAccess(const std::vector<lcf::rpg::EventCommand>& commands) {
+	using Cmd = lcf::rpg::EventCommand::Code;
+
+	Access access;
+
+	auto add = [](std::vector<int>& ids, int id) {
+		if (id <= 0) {
+			return false;
+		}
+		ids.push_back(id);
+		return true;
+	};
+
+	for (const auto& com : commands) {
+		const auto& p = com.parameters;
+		bool supported = false;
+
+		switch (static_cast<Cmd>(com.code)) {
+			case Cmd::END:
+			case Cmd::Comment_2:
+			case Cmd::Label:
+			case Cmd::JumpToLabel:
+			case Cmd::BreakLoop:
+			case Cmd::ElseBranch:
+			case Cmd::EndBranch:
+			case Cmd::EndEventProcessing:
+				supported = true;
+				break;
+			case Cmd::Comment:
+				// Could be a DynRPG command
+				supported = com.string.empty() || com.string[0] != '@';
+				break;
+			case Cmd::Loop:
+			case Cmd::EndLoop:
+				// Infinite loop, Maniac loops read variables
+				supported = p.size() < 5 || p[0] == 0;
+				break;
+			case Cmd::Wait:
+				// Constant time, not waiting for a key
+				supported = p.size() == 1 || (p.size() >= 2 && p[1] == 0 && (p.size() == 2 || p[2] == 0));
+				break;
+			case Cmd::ControlVars:
+				// Single variable with a constant or a variable operand.
+				// Ranges always refresh the map and the other operands read game state.
+				if (p.size() >= 6 && p[0] == 0 && (p[4] == 0 || p[4] == 1) &&
+						p[3] >= 0 && (p[3] <= 5 || (p[3] <= 10 && Player::IsPatchManiac()))) {
+					supported = add(access.var_writes, p[1]) && (p[4] == 0 || add(access.var_reads, p[5]));
+				}
+				break;
+			case Cmd::ConditionalBranch:
+				if (p.size() >= 3 && p[0] == 0) {
+					supported = add(access.switch_reads, p[1]);
+				} else if (p.size() >= 5 && p[0] == 1 && (p[2] == 0 || p[2] == 1)) {
+					supported = add(access.var_reads, p[1]) && (p[2] == 0 || add(access.var_reads, p[3]));
+				}
+				break;
+			default:
+				break;
+		}
 
+		if (!supported) {
+			return {};
+		}
+	}
+
+	for (auto* ids : { &access.switch_reads, &access.var_reads, &access.var_writes }) {
+		std::sort(ids->begin(), ids->end());
+		ids->erase(std::unique(ids->begin(), ids->end()), ids->end());
+	}
+	access.independent = true;
 
+	return access;
 }
 
 void Game_CommonEvent::SetSaveData(const lcf::rpg::SaveEventExecState& data) {
@@ -46,6 +122,7 @@ void Game_CommonEvent::SetSaveData(const lcf::rpg::SaveEventExecState& data) {
 			interpreter.reset(new Game_Interpreter_Map());
 		}
 		interpreter->SetState(data);
+		runs_other_commands = data.stack.size() != 1 || data.stack.front().commands != GetList();
 	}
 }
 
@@ -63,6 +140,22 @@ AsyncOp Game_CommonEvent::Update(bool resume_async) {
 	return {};
 }
 
+const Game_CommonEvent::Access& Game_CommonEvent::GetAccess() const {
+	return access;
+}
+
+bool Game_CommonEvent::CanUpdateConcurrently() const {
+	if (!access.independent || !interpreter || runs_other_commands) {
+		return false;
+	}
+
+	// Accessing invalid IDs prints warnings and writes grow the storage
+	auto max_id = [](const std::vector<int>& ids) { return ids.empty() ? 0 : ids.back(); };
+	return max_id(access.switch_reads) <= Main_Data::game_switches->GetSizeWithLimit() &&
+		max_id(access.var_reads) <= Main_Data::game_variables->GetSizeWithLimit() &&
+		max_id(access.var_writes) <= Main_Data::game_variables->GetSize();
+}
+
 int Game_CommonEvent::GetIndex() const {
 	return common_event_id;
 }
@@ -89,6 +182,13 @@ std::vector<lcf::rpg::EventCommand>& Game_CommonEvent::GetList() {
 	return lcf::ReaderUtil::GetElement(lcf::Data::commonevents, common_event_id)->event_commands;
 }
 
+Game_Interpreter::CommandList Game_CommonEvent::GetSharedList() {
+	if (!shared_list) {
+		shared_list = std::make_shared<const EventCommandList>(GetList());
+	}
+	return shared_list;
+}
+
 lcf::rpg::SaveEventExecState Game_CommonEvent::GetSaveData() {
 	lcf::rpg::SaveEventExecState state;
 	if (interpreter) {
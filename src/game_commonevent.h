@@ -32,6 +32,31 @@
  */
 class Game_CommonEvent {
 public:
+	/** Switches and variables accessed by the commands of a common event */
+	struct Access {
+		/**
+		 * All commands only change the interpreter state or read and write
+		 * switches and variables with constant IDs.
+		 * Such events can run concurrently to each other, see Game_Map::UpdateCommonEvents.
+		 */
+		bool independent = false;
+		/** Switches read by conditions, sorted */
+		std::vector<int> switch_reads;
+		/** Variables read, sorted */
+		std::vector<int> var_reads;
+		/** Variables written, sorted */
+		std::vector<int> var_writes;
+	};
+
+	/**
+	 * Determines the switches and variables accessed by event commands.
+	 *
+	 * @param commands event commands
+	 * @return accessed switches and variables, independent is false when any
+	 *   other state is read or written or an ID is only known at runtime
+	 */
+	static Access AnalyzeAccess(const std::vector<lcf::rpg::EventCommand>& commands);
+
 	/**
 	 * Constructor.
 	 *
@@ -54,6 +79,19 @@ public:
 	 */
 	AsyncOp Update(bool resume_async);
 
+	/** @return switches and variables accessed by the parallel interpreter */
+	const Access& GetAccess() const;
+
+	/**
+	 * Checks whether the interpreter can be updated on a worker thread in
+	 * this frame: The event is independent, runs the commands of the
+	 * database and all accessed switches and variables exist.
+	 * Must be called from the main thread.
+	 *
+	 * @return true if Update may be called concurrently
+	 */
+	bool CanUpdateConcurrently() const;
+
 	/**
 	 * Gets common event index.
 	 *
@@ -96,6 +134,14 @@ public:
 	 */
 	std::vector<lcf::rpg::EventCommand>& GetList();
 
+	/**
+	 * Returns the event commands for the interpreter.
+	 * The commands are copied once and then shared by all frames running them.
+	 *
+	 * @return event commands
+	 */
+	Game_Interpreter::CommandList GetSharedList();
+
 	lcf::rpg::SaveEventExecState GetSaveData();
 
 	/** @return true if waiting for foreground execution */
@@ -113,6 +159,15 @@ private:
 	/** Interpreter for parallel common events. */
 	std::unique_ptr<Game_Interpreter_Map> interpreter;
 
+	/** Shared event commands, created on first use */
+	Game_Interpreter::CommandList shared_list;
+
+	/** Accessed switches and variables of parallel events */
+	Access access;
+
+	/** Set when a savegame replaced the commands of the interpreter */
+	bool runs_other_commands = false;
+
 	friend class Scene_Debug;
 };
 
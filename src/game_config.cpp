@@ -64,6 +64,7 @@ void Game_ConfigVideo::Hide() {
 	scaling_mode.SetOptionVisible(false);
 	stretch.SetOptionVisible(false);
 	touch_ui.SetOptionVisible(false);
+	direct_render.SetOptionVisible(false);
 	pause_when_focus_lost.SetOptionVisible(false);
 	game_resolution.SetOptionVisible(false);
 }
@@ -444,6 +445,7 @@ void Game_Config::LoadFromStream(Filesystem_Stream::InputStream& is) {
 	video.window_zoom.FromIni(ini);
 	video.scaling_mode.FromIni(ini);
 	video.stretch.FromIni(ini);
+	video.direct_render.FromIni(ini);
 	video.touch_ui.FromIni(ini);
 	video.pause_when_focus_lost.FromIni(ini);
 	video.game_resolution.FromIni(ini);
@@ -511,11 +513,14 @@ void Game_Config::LoadFromStream(Filesystem_Stream::InputStream& is) {
 	input.gamepad_swap_ab_and_xy.FromIni(ini);
 	input.speed_modifier_a.FromIni(ini);
 	input.speed_modifier_b.FromIni(ini);
+	input.speed_modifier_turbo.FromIni(ini);
 
 	/** PLAYER SECTION */
 	player.settings_autosave.FromIni(ini);
 	player.settings_in_title.FromIni(ini);
 	player.settings_in_menu.FromIni(ini);
+	player.directory_index.FromIni(ini);
+	player.parallel_common_events.FromIni(ini);
 	player.show_startup_logos.FromIni(ini);
 	player.font1.FromIni(ini);
 	player.font1_size.FromIni(ini);
@@ -534,6 +539,7 @@ void Game_Config::WriteToStream(Filesystem_Stream::OutputStream& os) const {
 	video.window_zoom.ToIni(os);
 	video.scaling_mode.ToIni(os);
 	video.stretch.ToIni(os);
+	video.direct_render.ToIni(os);
 	video.touch_ui.ToIni(os);
 	video.pause_when_focus_lost.ToIni(os);
 	video.game_resolution.ToIni(os);
@@ -590,6 +596,7 @@ void Game_Config::WriteToStream(Filesystem_Stream::OutputStream& os) const {
 	input.gamepad_swap_ab_and_xy.ToIni(os);
 	input.speed_modifier_a.ToIni(os);
 	input.speed_modifier_b.ToIni(os);
+	input.speed_modifier_turbo.ToIni(os);
 
 	os << "\n";
 
@@ -601,6 +608,8 @@ void Game_Config::WriteToStream(Filesystem_Stream::OutputStream& os) const {
 	player.settings_autosave.ToIni(os);
 	player.settings_in_title.ToIni(os);
 	player.settings_in_menu.ToIni(os);
+	player.directory_index.ToIni(os);
+	player.parallel_common_events.ToIni(os);
 	player.show_startup_logos.ToIni(os);
 	player.font1.ToIni(os);
 	player.font1_size.ToIni(os);
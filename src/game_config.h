@@ -80,6 +80,8 @@ struct Game_ConfigPlayer {
 	BoolConfigParam settings_autosave{ "Save settings on exit", "Automatically save the settings on exit", "Player", "SettingsAutosave", false };
 	BoolConfigParam settings_in_title{ "Show settings on title screen", "Display settings menu item on the title screen", "Player", "SettingsInTitle", false };
 	BoolConfigParam settings_in_menu{ "Show settings in menu", "Display settings menu item on the menu screen", "Player", "SettingsInMenu", false };
+	BoolConfigParam directory_index{ "Directory index", "Remember the folder contents between runs. Speeds up the start on slow drives", "Player", "DirectoryIndex", false };
+	BoolConfigParam parallel_common_events{ "Parallel common events", "Run independent parallel common events on multiple threads (Experimental)", "Player", "ParallelCommonEvents", false };
 	EnumConfigParam<ConfigEnum::StartupLogos, 3> show_startup_logos{
 		"Startup Logos", "Logos that are displayed on startup", "Player", "StartupLogos", ConfigEnum::StartupLogos::Custom,
 		Utils::MakeSvArray("None", "Custom", "All"),
@@ -111,6 +113,7 @@ struct Game_ConfigVideo {
 	BoolConfigParam stretch{ "Stretch", "Stretch to the width of the window/screen", "Video", "Stretch", false };
 	BoolConfigParam pause_when_focus_lost{ "Pause when focus lost", "Pause the program when it is in the background", "Video", "PauseWhenFocusLost", true };
 	BoolConfigParam touch_ui{ "Touch Ui", "Display the touch ui", "Video", "TouchUi", true };
+	BoolConfigParam direct_render{ "Direct Rendering", "Draw directly into the texture of the renderer (Experimental)", "Video", "DirectRender", false };
 	EnumConfigParam<ConfigEnum::GameResolution, 3> game_resolution{ "Resolution", "Game resolution. Changes require a restart.", "Video", "GameResolution", ConfigEnum::GameResolution::Original,
 		Utils::MakeSvArray("Original (Recommended)", "Widescreen (Experimental)", "Ultrawide (Experimental)"),
 		Utils::MakeSvArray("original", "widescreen", "ultrawide"),
@@ -140,6 +143,7 @@ struct Game_ConfigAudio {
 struct Game_ConfigInput {
 	RangeConfigParam<int> speed_modifier_a{ "Fast Forward A: Speed", "Set fast forward A speed", "Input", "SpeedModifierA", 3, 2, 100 };
 	RangeConfigParam<int> speed_modifier_b{ "Fast Forward B: Speed", "Set fast forward B speed", "Input", "SpeedModifierB", 10, 2, 100 };
+	BoolConfigParam speed_modifier_turbo{ "Fast Forward: Skip frames", "Draw less frames when the device is too slow for the speed", "Input", "SpeedModifierTurbo", false };
 	BoolConfigParam gamepad_swap_analog{ "Gamepad: Swap Analog Sticks", "Swap left and right stick", "Input", "GamepadSwapAnalog", false };
 	BoolConfigParam gamepad_swap_dpad_with_buttons{ "Gamepad: Swap D-Pad with buttons", "Swap D-Pad with ABXY-Buttons", "Input", "GamepadSwapDpad", false };
 	BoolConfigParam gamepad_swap_ab_and_xy{ "Gamepad: Swap AB and XY", "Swap A and B with X and Y", "Input", "GamepadSwapAbxy", false };
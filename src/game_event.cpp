@@ -164,6 +164,7 @@ void Game_Event::RefreshPage() {
 		SetPaused(false);
 		SetThrough(true);
 		this->page = new_page;
+		idle_page = false;
 		return;
 	}
 
@@ -176,6 +177,11 @@ void Game_Event::RefreshPage() {
 	const auto* old_page = page;
 	page = new_page;
 
+	idle_page = page->move_type == lcf::rpg::EventPage::MoveType_stationary
+		&& page->trigger != lcf::rpg::EventPage::Trigger_parallel
+		&& page->trigger != lcf::rpg::EventPage::Trigger_auto_start
+		&& page->trigger != lcf::rpg::EventPage::Trigger_collision;
+
 	SetSpriteGraphic(ToString(page->character_name), page->character_index);
 
 	if (IsStopping()
@@ -575,11 +581,37 @@ void Game_Event::MoveTypeAwayFromPlayer() {
 	MoveTypeTowardsOrAwayPlayer(false);
 }
 
+bool Game_Event::IsIdle() const {
+	return idle_page
+		&& IsActive()
+		&& !IsProcessed()
+		&& IsStopping()
+		&& !IsMoveRouteOverwritten()
+		&& GetStopCount() > 0
+		&& GetFlashLevel() <= 0
+		&& IsAnimationSettled();
+}
+
+void Game_Event::UpdateIdle() {
+	SetProcessed(true);
+
+	// Same rule as in Game_Character::Update() for a stopped character
+	if ((Main_Data::game_system->GetMessageContinueEvents() || !Game_Map::GetInterpreter().IsRunning()) && !IsPaused()) {
+		SetStopCount(GetStopCount() + 1);
+	}
+}
+
 AsyncOp Game_Event::Update(bool resume_async) {
 	if (!data()->active || (!resume_async && page == NULL)) {
 		return {};
 	}
 
+	// Decorative events make up most of the events on large maps
+	if (!resume_async && IsIdle()) {
+		UpdateIdle();
+		return {};
+	}
+
 	// RPG_RT runs the parallel interpreter everytime Update is called.
 	// That means if the event updates multiple times due to makeway,
 	// the interpreter will run multiple times per frame.
@@ -619,3 +651,25 @@ const lcf::rpg::EventPage *Game_Event::GetActivePage() const {
 	return page;
 }
 
+Game_Interpreter::CommandList Game_Event::GetSharedList(const lcf::rpg::EventPage* page) {
+	if (!page) {
+		return nullptr;
+	}
+
+	const int idx = page->ID - 1;
+	if (idx < 0 || idx >= static_cast<int>(event->pages.size()) || &event->pages[idx] != page) {
+		// Not a page of this event
+		return std::make_shared<const EventCommandList>(page->event_commands);
+	}
+
+	if (page_lists.size() != event->pages.size()) {
+		page_lists.resize(event->pages.size());
+	}
+
+	auto& list = page_lists[idx];
+	if (!list) {
+		list = std::make_shared<const EventCommandList>(page->event_commands);
+	}
+	return list;
+}
+
@@ -130,6 +130,17 @@ public:
 	 */
 	AsyncOp Update(bool resume_async);
 
+	/**
+	 * An event is idle when updating it only advances the stop count:
+	 * The active page has no move type and no parallel, autostart or collision
+	 * trigger, there is no forced move route, the event is neither moving,
+	 * jumping nor flashing and its step animation has settled.
+	 * Update() skips the movement and animation logic of idle events.
+	 *
+	 * @return whether the event is idle this frame
+	 */
+	bool IsIdle() const;
+
 	bool AreConditionsMet(const lcf::rpg::EventPage& page);
 
 	/**
@@ -162,6 +173,15 @@ public:
 	 */
 	const lcf::rpg::EventPage* GetActivePage() const;
 
+	/**
+	 * Returns the event commands of a page for the interpreter.
+	 * The commands are copied once and then shared by all frames running them.
+	 *
+	 * @param page page of this event
+	 * @return event commands, nullptr when page is nullptr
+	 */
+	Game_Interpreter::CommandList GetSharedList(const lcf::rpg::EventPage* page);
+
 	/** @returns the number of pages this event has */
 	int GetNumPages() const;
 
@@ -214,9 +234,16 @@ private:
 
 	void CheckCollisonOnMoveFailure();
 
+	/** Fast path of Update() for idle events */
+	void UpdateIdle();
+
 	const lcf::rpg::Event* event = nullptr;
 	const lcf::rpg::EventPage* page = nullptr;
 	std::unique_ptr<Game_Interpreter_Map> interpreter;
+	/** Shared event commands of the pages, created on first use */
+	std::vector<Game_Interpreter::CommandList> page_lists;
+	/** Whether the active page allows the event to become idle */
+	bool idle_page = false;
 
 	friend class Scene_Debug;
 };
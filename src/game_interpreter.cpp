@@ -50,6 +50,7 @@
 #include "sprite_character.h"
 #include "scene_gameover.h"
 #include "scene_map.h"
+#include "save_writer.h"
 #include "scene_save.h"
 #include "scene_settings.h"
 #include "scene.h"
@@ -58,6 +59,7 @@
 #include "main_data.h"
 #include "output.h"
 #include "player.h"
+#include "regex_cache.h"
 #include "util_macro.h"
 #include <lcf/reader_util.h>
 #include <lcf/lsd/reader.h>
@@ -80,7 +82,13 @@ constexpr int Game_Interpreter::loop_limit;
 constexpr int Game_Interpreter::call_stack_limit;
 constexpr int Game_Interpreter::subcommand_sentinel;
 
-Game_Interpreter::Game_Interpreter(bool _main_flag) {
+Game_Interpreter::Game_Interpreter(bool _main_flag)
+	: Game_Interpreter(_main_flag, GetCommandTable())
+{
+}
+
+Game_Interpreter::Game_Interpreter(bool _main_flag, const CommandTable& table) {
+	command_table = &table;
 	main_flag = _main_flag;
 
 	Clear();
@@ -92,8 +100,10 @@ Game_Interpreter::~Game_Interpreter() {
 // Clear.
 void Game_Interpreter::Clear() {
 	_state = {};
+	_frame_commands.clear();
 	_keyinput = {};
 	_async_op = {};
+	_wait_save = false;
 }
 
 // Is interpreter running.
@@ -112,13 +122,25 @@ void Game_Interpreter::Push(
 		return;
 	}
 
+	Push(std::make_shared<const EventCommandList>(std::move(_list)), event_id, started_by_decision_key, event_page_id);
+}
+
+void Game_Interpreter::Push(
+	CommandList _list,
+	int event_id,
+	bool started_by_decision_key,
+	int event_page_id
+) {
+	if (!_list || _list->GetCommands().empty()) {
+		return;
+	}
+
 	if ((int)_state.stack.size() > call_stack_limit) {
 		Output::Error("Call Event limit ({}) has been exceeded", call_stack_limit);
 	}
 
 	lcf::rpg::SaveEventExecFrame frame;
 	frame.ID = _state.stack.size() + 1;
-	frame.commands = std::move(_list);
 	frame.current_command = 0;
 	frame.triggered_by_decision_key = started_by_decision_key;
 	frame.event_id = event_id;
@@ -132,6 +154,7 @@ void Game_Interpreter::Push(
 	}
 
 	_state.stack.push_back(std::move(frame));
+	_frame_commands.push_back({ std::move(_list) });
 }
 
 
@@ -286,6 +309,9 @@ const lcf::rpg::SaveEventExecState& Game_Interpreter::GetState() const {
 
 lcf::rpg::SaveEventExecState Game_Interpreter::GetSaveState() {
 	auto save = _state;
+	for (size_t i = 0; i < save.stack.size(); ++i) {
+		save.stack[i].commands = _frame_commands[i].list->GetCommands();
+	}
 	_keyinput.toSave(save);
 	return save;
 }
@@ -444,6 +470,13 @@ void Game_Interpreter::Update(bool reset_loop_count) {
 			_state.wait_movement = false;
 		}
 
+		if (_wait_save) {
+			if (SaveWriter::IsPending()) {
+				break;
+			}
+			_wait_save = false;
+		}
+
 		if (_keyinput.wait) {
 			if (Game_Message::IsMessageActive()) {
 				break;
@@ -482,7 +515,7 @@ void Game_Interpreter::Update(bool reset_loop_count) {
 		}
 
 		// Pop any completed stack frames
-		if (frame->current_command >= (int)frame->commands.size()) {
+		if (frame->current_command >= (int)GetFrameCommands().size()) {
 			if (!OnFinishStackFrame()) {
 				break;
 			}
@@ -493,7 +526,17 @@ void Game_Interpreter::Update(bool reset_loop_count) {
 		int current_frame_idx = _state.stack.size() - 1;
 
 		const int index_before_exec = frame->current_command;
-		if (!ExecuteCommand()) {
+		bool executed;
+		if (EP_UNLIKELY(InterpreterProfiler::IsEnabled())) {
+			auto stack = GetProfilerStack();
+			auto start = Game_Clock::now();
+			executed = ExecuteCommand();
+			InterpreterProfiler::Record(stack, Game_Clock::now() - start);
+		} else {
+			executed = ExecuteCommand();
+		}
+
+		if (!executed) {
 			break;
 		}
 
@@ -532,15 +575,105 @@ void Game_Interpreter::Update(bool reset_loop_count) {
 
 // Setup Starting Event
 void Game_Interpreter::Push(Game_Event* ev) {
-	Push(ev->GetList(), ev->GetId(), ev->WasStartedByDecisionKey(), ev->GetActivePage() ? ev->GetActivePage()->ID : 0);
+	Push(ev->GetSharedList(ev->GetActivePage()), ev->GetId(), ev->WasStartedByDecisionKey(), ev->GetActivePage() ? ev->GetActivePage()->ID : 0);
 }
 
 void Game_Interpreter::Push(Game_Event* ev, const lcf::rpg::EventPage* page, bool triggered_by_decision_key) {
-	Push(page->event_commands, ev->GetId(), triggered_by_decision_key, page->ID);
+	Push(ev->GetSharedList(page), ev->GetId(), triggered_by_decision_key, page->ID);
 }
 
 void Game_Interpreter::Push(Game_CommonEvent* ev) {
-	Push(ev->GetList(), 0, false);
+	const auto num_frames = _state.stack.size();
+	Push(ev->GetSharedList(), 0, false);
+	if (_state.stack.size() > num_frames) {
+		_frame_commands.back().common_event_id = ev->GetIndex();
+	}
+}
+
+const std::vector<lcf::rpg::EventCommand>& Game_Interpreter::GetFrameCommands(int frame_idx) const {
+	assert(frame_idx >= 0 && frame_idx < (int)_frame_commands.size());
+	return _frame_commands[frame_idx].list->GetCommands();
+}
+
+/**
+ * Finds the map event page or common event which runs the commands of a
+ * frame loaded from a save file.
+ *
+ * @param frame frame with commands
+ * @param common_event_id set to the common event running the commands
+ * @return the shared list or nullptr when the commands are from elsewhere
+ */
+static Game_Interpreter::CommandList FindSharedList(const lcf::rpg::SaveEventExecFrame& frame, int& common_event_id) {
+	if (frame.event_id > 0) {
+		auto* ev = Game_Map::GetEvent(frame.event_id);
+		const auto* page = ev ? ev->GetPage(frame.maniac_event_page_id) : nullptr;
+		if (page && page->event_commands == frame.commands) {
+			return ev->GetSharedList(page);
+		}
+		return nullptr;
+	}
+
+	for (auto& ce: Game_Map::GetCommonEvents()) {
+		if (ce.GetList() == frame.commands) {
+			common_event_id = ce.GetIndex();
+			return ce.GetSharedList();
+		}
+	}
+	return nullptr;
+}
+
+void Game_Interpreter::ShareFrameCommands() {
+	_frame_commands.clear();
+	for (auto& frame: _state.stack) {
+		FrameCommands commands;
+		commands.list = FindSharedList(frame, commands.common_event_id);
+		if (!commands.list) {
+			commands.list = std::make_shared<const EventCommandList>(std::move(frame.commands));
+		}
+		_frame_commands.push_back(std::move(commands));
+		frame.commands.clear();
+	}
+}
+
+std::vector<InterpreterProfiler::Frame> Game_Interpreter::GetProfilerStack() const {
+	using Frame = InterpreterProfiler::Frame;
+
+	std::vector<Frame> stack;
+	stack.reserve(_state.stack.size());
+
+	const int map_id = Game_Map::GetMapId();
+	const auto* troop = Game_Battle::IsBattleRunning() ? Game_Battle::GetActiveTroop() : nullptr;
+
+	for (size_t i = 0; i < _state.stack.size(); ++i) {
+		const auto& frame = _state.stack[i];
+		const auto& list = _frame_commands[i].list->GetCommands();
+
+		Frame pf;
+		pf.map_id = map_id;
+		pf.command_index = frame.current_command;
+		if (i + 1 < _state.stack.size() && pf.command_index > 0) {
+			// Calling frames already point behind the CallEvent command
+			--pf.command_index;
+		}
+		if (pf.command_index < static_cast<int>(list.size())) {
+			pf.code = list[pf.command_index].code;
+		}
+
+		if (frame.event_id > 0) {
+			pf.type = Frame::Type::MapEvent;
+			pf.id = frame.event_id;
+			pf.page_id = frame.maniac_event_page_id;
+		} else if (_frame_commands[i].common_event_id > 0) {
+			pf.type = Frame::Type::CommonEvent;
+			pf.id = _frame_commands[i].common_event_id;
+		} else if (troop) {
+			pf.type = Frame::Type::BattleEvent;
+			pf.id = troop->ID;
+			pf.page_id = frame.maniac_event_page_id;
+		}
+		stack.push_back(pf);
+	}
+	return stack;
 }
 
 bool Game_Interpreter::CheckGameOver() {
@@ -556,245 +689,162 @@ bool Game_Interpreter::CheckGameOver() {
 
 void Game_Interpreter::SkipToNextConditional(std::initializer_list<Cmd> codes, int indent) {
 	auto& frame = GetFrame();
-	const auto& list = frame.commands;
+	const auto& list = GetFrameCommandList();
 	auto& index = frame.current_command;
 
-	if (index >= static_cast<int>(list.size())) {
+	if (index >= static_cast<int>(list.GetCommands().size())) {
 		return;
 	}
 
-	for (++index; index < static_cast<int>(list.size()); ++index) {
-		const auto& com = list[index];
-		if (com.indent > indent) {
-			continue;
-		}
-		if (std::find(codes.begin(), codes.end(), static_cast<Cmd>(com.code)) != codes.end()) {
-			break;
-		}
-	}
+	index = list.FindNext(index, codes, indent);
+}
+
+Game_Interpreter::CommandTable Game_Interpreter::MakeCommandTable(std::initializer_list<std::pair<Cmd, CommandHandler>> handlers, const CommandTable* base) {
+	CommandTable table;
+	if (base) {
+		table = *base;
+	}
+
+	for (const auto& handler: handlers) {
+		const int slot = EventCommandList::GetCodeSlot(static_cast<int>(handler.first));
+		if (slot >= static_cast<int>(table.size())) {
+			table.resize(slot + 1, nullptr);
+		}
+		table[slot] = handler.second;
+	}
+
+	return table;
+}
+
+const Game_Interpreter::CommandTable& Game_Interpreter::GetCommandTable() {
+	static const CommandTable table = MakeCommandTable({
+		{ Cmd::ShowMessage, &Game_Interpreter::CommandShowMessage },
+		{ Cmd::MessageOptions, &Game_Interpreter::CommandMessageOptions },
+		{ Cmd::ChangeFaceGraphic, &Game_Interpreter::CommandChangeFaceGraphic },
+		{ Cmd::ShowChoice, &Game_Interpreter::CommandShowChoices },
+		{ Cmd::ShowChoiceOption, &Game_Interpreter::CommandShowChoiceOption },
+		{ Cmd::ShowChoiceEnd, &Game_Interpreter::CommandShowChoiceEnd },
+		{ Cmd::InputNumber, &Game_Interpreter::CommandInputNumber },
+		{ Cmd::ControlSwitches, &Game_Interpreter::CommandControlSwitches },
+		{ Cmd::ControlVars, &Game_Interpreter::CommandControlVariables },
+		{ Cmd::TimerOperation, &Game_Interpreter::CommandTimerOperation },
+		{ Cmd::ChangeGold, &Game_Interpreter::CommandChangeGold },
+		{ Cmd::ChangeItems, &Game_Interpreter::CommandChangeItems },
+		{ Cmd::ChangePartyMembers, &Game_Interpreter::CommandChangePartyMember },
+		{ Cmd::ChangeExp, &Game_Interpreter::CommandChangeExp },
+		{ Cmd::ChangeLevel, &Game_Interpreter::CommandChangeLevel },
+		{ Cmd::ChangeParameters, &Game_Interpreter::CommandChangeParameters },
+		{ Cmd::ChangeSkills, &Game_Interpreter::CommandChangeSkills },
+		{ Cmd::ChangeEquipment, &Game_Interpreter::CommandChangeEquipment },
+		{ Cmd::ChangeHP, &Game_Interpreter::CommandChangeHP },
+		{ Cmd::ChangeSP, &Game_Interpreter::CommandChangeSP },
+		{ Cmd::ChangeCondition, &Game_Interpreter::CommandChangeCondition },
+		{ Cmd::FullHeal, &Game_Interpreter::CommandFullHeal },
+		{ Cmd::SimulatedAttack, &Game_Interpreter::CommandSimulatedAttack },
+		{ Cmd::Wait, &Game_Interpreter::CommandWait },
+		{ Cmd::PlayBGM, &Game_Interpreter::CommandPlayBGM },
+		{ Cmd::FadeOutBGM, &Game_Interpreter::CommandFadeOutBGM },
+		{ Cmd::PlaySound, &Game_Interpreter::CommandPlaySound },
+		{ Cmd::EndEventProcessing, &Game_Interpreter::CommandEndEventProcessing },
+		{ Cmd::Comment, &Game_Interpreter::CommandComment },
+		{ Cmd::Comment_2, &Game_Interpreter::CommandComment },
+		{ Cmd::GameOver, &Game_Interpreter::CommandGameOver },
+		{ Cmd::ChangeHeroName, &Game_Interpreter::CommandChangeHeroName },
+		{ Cmd::ChangeHeroTitle, &Game_Interpreter::CommandChangeHeroTitle },
+		{ Cmd::ChangeSpriteAssociation, &Game_Interpreter::CommandChangeSpriteAssociation },
+		{ Cmd::ChangeActorFace, &Game_Interpreter::CommandChangeActorFace },
+		{ Cmd::ChangeVehicleGraphic, &Game_Interpreter::CommandChangeVehicleGraphic },
+		{ Cmd::ChangeSystemBGM, &Game_Interpreter::CommandChangeSystemBGM },
+		{ Cmd::ChangeSystemSFX, &Game_Interpreter::CommandChangeSystemSFX },
+		{ Cmd::ChangeSystemGraphics, &Game_Interpreter::CommandChangeSystemGraphics },
+		{ Cmd::ChangeScreenTransitions, &Game_Interpreter::CommandChangeScreenTransitions },
+		{ Cmd::MemorizeLocation, &Game_Interpreter::CommandMemorizeLocation },
+		{ Cmd::SetVehicleLocation, &Game_Interpreter::CommandSetVehicleLocation },
+		{ Cmd::ChangeEventLocation, &Game_Interpreter::CommandChangeEventLocation },
+		{ Cmd::TradeEventLocations, &Game_Interpreter::CommandTradeEventLocations },
+		{ Cmd::StoreTerrainID, &Game_Interpreter::CommandStoreTerrainID },
+		{ Cmd::StoreEventID, &Game_Interpreter::CommandStoreEventID },
+		{ Cmd::EraseScreen, &Game_Interpreter::CommandEraseScreen },
+		{ Cmd::ShowScreen, &Game_Interpreter::CommandShowScreen },
+		{ Cmd::TintScreen, &Game_Interpreter::CommandTintScreen },
+		{ Cmd::FlashScreen, &Game_Interpreter::CommandFlashScreen },
+		{ Cmd::ShakeScreen, &Game_Interpreter::CommandShakeScreen },
+		{ Cmd::WeatherEffects, &Game_Interpreter::CommandWeatherEffects },
+		{ Cmd::ShowPicture, &Game_Interpreter::CommandShowPicture },
+		{ Cmd::MovePicture, &Game_Interpreter::CommandMovePicture },
+		{ Cmd::ErasePicture, &Game_Interpreter::CommandErasePicture },
+		{ Cmd::PlayerVisibility, &Game_Interpreter::CommandPlayerVisibility },
+		{ Cmd::MoveEvent, &Game_Interpreter::CommandMoveEvent },
+		{ Cmd::MemorizeBGM, &Game_Interpreter::CommandMemorizeBGM },
+		{ Cmd::PlayMemorizedBGM, &Game_Interpreter::CommandPlayMemorizedBGM },
+		{ Cmd::KeyInputProc, &Game_Interpreter::CommandKeyInputProc },
+		{ Cmd::ChangeMapTileset, &Game_Interpreter::CommandChangeMapTileset },
+		{ Cmd::ChangePBG, &Game_Interpreter::CommandChangePBG },
+		{ Cmd::ChangeEncounterSteps, &Game_Interpreter::CommandChangeEncounterSteps },
+		{ Cmd::TileSubstitution, &Game_Interpreter::CommandTileSubstitution },
+		{ Cmd::TeleportTargets, &Game_Interpreter::CommandTeleportTargets },
+		{ Cmd::ChangeTeleportAccess, &Game_Interpreter::CommandChangeTeleportAccess },
+		{ Cmd::EscapeTarget, &Game_Interpreter::CommandEscapeTarget },
+		{ Cmd::ChangeEscapeAccess, &Game_Interpreter::CommandChangeEscapeAccess },
+		{ Cmd::ChangeSaveAccess, &Game_Interpreter::CommandChangeSaveAccess },
+		{ Cmd::ChangeMainMenuAccess, &Game_Interpreter::CommandChangeMainMenuAccess },
+		{ Cmd::ConditionalBranch, &Game_Interpreter::CommandConditionalBranch },
+		{ Cmd::JumpToLabel, &Game_Interpreter::CommandJumpToLabel },
+		{ Cmd::Loop, &Game_Interpreter::CommandLoop },
+		{ Cmd::BreakLoop, &Game_Interpreter::CommandBreakLoop },
+		{ Cmd::EndLoop, &Game_Interpreter::CommandEndLoop },
+		{ Cmd::EraseEvent, &Game_Interpreter::CommandEraseEvent },
+		{ Cmd::CallEvent, &Game_Interpreter::CommandCallEvent },
+		{ Cmd::ReturntoTitleScreen, &Game_Interpreter::CommandReturnToTitleScreen },
+		{ Cmd::ChangeClass, &Game_Interpreter::CommandChangeClass },
+		{ Cmd::ChangeBattleCommands, &Game_Interpreter::CommandChangeBattleCommands },
+		{ Cmd::ElseBranch, &Game_Interpreter::CommandElseBranch },
+		{ Cmd::EndBranch, &Game_Interpreter::CommandEndBranch },
+		{ Cmd::ExitGame, &Game_Interpreter::CommandExitGame },
+		{ Cmd::ToggleFullscreen, &Game_Interpreter::CommandToggleFullscreen },
+		{ Cmd::OpenVideoOptions, &Game_Interpreter::CommandOpenVideoOptions },
+		{ Cmd::Maniac_GetSaveInfo, &Game_Interpreter::CommandManiacGetSaveInfo },
+		{ Cmd::Maniac_Load, &Game_Interpreter::CommandManiacLoad },
+		{ Cmd::Maniac_Save, &Game_Interpreter::CommandManiacSave },
+		{ Cmd::Maniac_EndLoadProcess, &Game_Interpreter::CommandManiacEndLoadProcess },
+		{ Cmd::Maniac_GetMousePosition, &Game_Interpreter::CommandManiacGetMousePosition },
+		{ Cmd::Maniac_SetMousePosition, &Game_Interpreter::CommandManiacSetMousePosition },
+		{ Cmd::Maniac_ShowStringPicture, &Game_Interpreter::CommandManiacShowStringPicture },
+		{ Cmd::Maniac_GetPictureInfo, &Game_Interpreter::CommandManiacGetPictureInfo },
+		{ Cmd::Maniac_ControlVarArray, &Game_Interpreter::CommandManiacControlVarArray },
+		{ Cmd::Maniac_KeyInputProcEx, &Game_Interpreter::CommandManiacKeyInputProcEx },
+		{ Cmd::Maniac_RewriteMap, &Game_Interpreter::CommandManiacRewriteMap },
+		{ Cmd::Maniac_ControlGlobalSave, &Game_Interpreter::CommandManiacControlGlobalSave },
+		{ Cmd::Maniac_ChangePictureId, &Game_Interpreter::CommandManiacChangePictureId },
+		{ Cmd::Maniac_SetGameOption, &Game_Interpreter::CommandManiacSetGameOption },
+		{ Cmd::Maniac_ControlStrings, &Game_Interpreter::CommandManiacControlStrings },
+		{ Cmd::Maniac_CallCommand, &Game_Interpreter::CommandManiacCallCommand },
+		{ Cmd::EasyRpg_SetInterpreterFlag, &Game_Interpreter::CommandEasyRpgSetInterpreterFlag },
+		{ static_cast<Cmd>(2056), &Game_Interpreter::CommandEasyRpgCloneMapEvent }, //EasyRPG_CloneMapEvent
+		{ static_cast<Cmd>(2057), &Game_Interpreter::CommandEasyRpgDestroyMapEvent } //EasyRPG_DestroyMapEvent
+	});
+	return table;
 }
 
 // Execute Command.
 bool Game_Interpreter::ExecuteCommand() {
 	auto& frame = GetFrame();
-	const auto& com = frame.commands[frame.current_command];
+	const auto& list = GetFrameCommandList();
+	const auto& com = list.GetCommands()[frame.current_command];
+
+	// The slot was decoded when the list was created
+	const int slot = list.GetSlot(frame.current_command);
+	const auto& table = *command_table;
+	if (slot < static_cast<int>(table.size()) && table[slot]) {
+		return (this->*table[slot])(com);
+	}
+
 	return ExecuteCommand(com);
 }
 
-bool Game_Interpreter::ExecuteCommand(lcf::rpg::EventCommand const& com) {
-	switch (static_cast<Cmd>(com.code)) {
-		case Cmd::ShowMessage:
-			return CommandShowMessage(com);
-		case Cmd::MessageOptions:
-			return CommandMessageOptions(com);
-		case Cmd::ChangeFaceGraphic:
-			return CommandChangeFaceGraphic(com);
-		case Cmd::ShowChoice:
-			return CommandShowChoices(com);
-		case Cmd::ShowChoiceOption:
-			return CommandShowChoiceOption(com);
-		case Cmd::ShowChoiceEnd:
-			return CommandShowChoiceEnd(com);
-		case Cmd::InputNumber:
-			return CommandInputNumber(com);
-		case Cmd::ControlSwitches:
-			return CommandControlSwitches(com);
-		case Cmd::ControlVars:
-			return CommandControlVariables(com);
-		case Cmd::TimerOperation:
-			return CommandTimerOperation(com);
-		case Cmd::ChangeGold:
-			return CommandChangeGold(com);
-		case Cmd::ChangeItems:
-			return CommandChangeItems(com);
-		case Cmd::ChangePartyMembers:
-			return CommandChangePartyMember(com);
-		case Cmd::ChangeExp:
-			return CommandChangeExp(com);
-		case Cmd::ChangeLevel:
-			return CommandChangeLevel(com);
-		case Cmd::ChangeParameters:
-			return CommandChangeParameters(com);
-		case Cmd::ChangeSkills:
-			return CommandChangeSkills(com);
-		case Cmd::ChangeEquipment:
-			return CommandChangeEquipment(com);
-		case Cmd::ChangeHP:
-			return CommandChangeHP(com);
-		case Cmd::ChangeSP:
-			return CommandChangeSP(com);
-		case Cmd::ChangeCondition:
-			return CommandChangeCondition(com);
-		case Cmd::FullHeal:
-			return CommandFullHeal(com);
-		case Cmd::SimulatedAttack:
-			return CommandSimulatedAttack(com);
-		case Cmd::Wait:
-			return CommandWait(com);
-		case Cmd::PlayBGM:
-			return CommandPlayBGM(com);
-		case Cmd::FadeOutBGM:
-			return CommandFadeOutBGM(com);
-		case Cmd::PlaySound:
-			return CommandPlaySound(com);
-		case Cmd::EndEventProcessing:
-			return CommandEndEventProcessing(com);
-		case Cmd::Comment:
-		case Cmd::Comment_2:
-			return CommandComment(com);
-		case Cmd::GameOver:
-			return CommandGameOver(com);
-		case Cmd::ChangeHeroName:
-			return CommandChangeHeroName(com);
-		case Cmd::ChangeHeroTitle:
-			return CommandChangeHeroTitle(com);
-		case Cmd::ChangeSpriteAssociation:
-			return CommandChangeSpriteAssociation(com);
-		case Cmd::ChangeActorFace:
-			return CommandChangeActorFace(com);
-		case Cmd::ChangeVehicleGraphic:
-			return CommandChangeVehicleGraphic(com);
-		case Cmd::ChangeSystemBGM:
-			return CommandChangeSystemBGM(com);
-		case Cmd::ChangeSystemSFX:
-			return CommandChangeSystemSFX(com);
-		case Cmd::ChangeSystemGraphics:
-			return CommandChangeSystemGraphics(com);
-		case Cmd::ChangeScreenTransitions:
-			return CommandChangeScreenTransitions(com);
-		case Cmd::MemorizeLocation:
-			return CommandMemorizeLocation(com);
-		case Cmd::SetVehicleLocation:
-			return CommandSetVehicleLocation(com);
-		case Cmd::ChangeEventLocation:
-			return CommandChangeEventLocation(com);
-		case Cmd::TradeEventLocations:
-			return CommandTradeEventLocations(com);
-		case Cmd::StoreTerrainID:
-			return CommandStoreTerrainID(com);
-		case Cmd::StoreEventID:
-			return CommandStoreEventID(com);
-		case Cmd::EraseScreen:
-			return CommandEraseScreen(com);
-		case Cmd::ShowScreen:
-			return CommandShowScreen(com);
-		case Cmd::TintScreen:
-			return CommandTintScreen(com);
-		case Cmd::FlashScreen:
-			return CommandFlashScreen(com);
-		case Cmd::ShakeScreen:
-			return CommandShakeScreen(com);
-		case Cmd::WeatherEffects:
-			return CommandWeatherEffects(com);
-		case Cmd::ShowPicture:
-			return CommandShowPicture(com);
-		case Cmd::MovePicture:
-			return CommandMovePicture(com);
-		case Cmd::ErasePicture:
-			return CommandErasePicture(com);
-		case Cmd::PlayerVisibility:
-			return CommandPlayerVisibility(com);
-		case Cmd::MoveEvent:
-			return CommandMoveEvent(com);
-		case Cmd::MemorizeBGM:
-			return CommandMemorizeBGM(com);
-		case Cmd::PlayMemorizedBGM:
-			return CommandPlayMemorizedBGM(com);
-		case Cmd::KeyInputProc:
-			return CommandKeyInputProc(com);
-		case Cmd::ChangeMapTileset:
-			return CommandChangeMapTileset(com);
-		case Cmd::ChangePBG:
-			return CommandChangePBG(com);
-		case Cmd::ChangeEncounterSteps:
-			return CommandChangeEncounterSteps(com);
-		case Cmd::TileSubstitution:
-			return CommandTileSubstitution(com);
-		case Cmd::TeleportTargets:
-			return CommandTeleportTargets(com);
-		case Cmd::ChangeTeleportAccess:
-			return CommandChangeTeleportAccess(com);
-		case Cmd::EscapeTarget:
-			return CommandEscapeTarget(com);
-		case Cmd::ChangeEscapeAccess:
-			return CommandChangeEscapeAccess(com);
-		case Cmd::ChangeSaveAccess:
-			return CommandChangeSaveAccess(com);
-		case Cmd::ChangeMainMenuAccess:
-			return CommandChangeMainMenuAccess(com);
-		case Cmd::ConditionalBranch:
-			return CommandConditionalBranch(com);
-		case Cmd::Label:
-			return true;
-		case Cmd::JumpToLabel:
-			return CommandJumpToLabel(com);
-		case Cmd::Loop:
-			return CommandLoop(com);
-		case Cmd::BreakLoop:
-			return CommandBreakLoop(com);
-		case Cmd::EndLoop:
-			return CommandEndLoop(com);
-		case Cmd::EraseEvent:
-			return CommandEraseEvent(com);
-		case Cmd::CallEvent:
-			return CommandCallEvent(com);
-		case Cmd::ReturntoTitleScreen:
-			return CommandReturnToTitleScreen(com);
-		case Cmd::ChangeClass:
-			return CommandChangeClass(com);
-		case Cmd::ChangeBattleCommands:
-			return CommandChangeBattleCommands(com);
-		case Cmd::ElseBranch:
-			return CommandElseBranch(com);
-		case Cmd::EndBranch:
-			return CommandEndBranch(com);
-		case Cmd::ExitGame:
-			return CommandExitGame(com);
-		case Cmd::ToggleFullscreen:
-			return CommandToggleFullscreen(com);
-		case Cmd::OpenVideoOptions:
-			return CommandOpenVideoOptions(com);
-		case Cmd::Maniac_GetSaveInfo:
-			return CommandManiacGetSaveInfo(com);
-		case Cmd::Maniac_Load:
-			return CommandManiacLoad(com);
-		case Cmd::Maniac_Save:
-			return CommandManiacSave(com);
-		case Cmd::Maniac_EndLoadProcess:
-			return CommandManiacEndLoadProcess(com);
-		case Cmd::Maniac_GetMousePosition:
-			return CommandManiacGetMousePosition(com);
-		case Cmd::Maniac_SetMousePosition:
-			return CommandManiacSetMousePosition(com);
-		case Cmd::Maniac_ShowStringPicture:
-			return CommandManiacShowStringPicture(com);
-		case Cmd::Maniac_GetPictureInfo:
-			return CommandManiacGetPictureInfo(com);
-		case Cmd::Maniac_ControlVarArray:
-			return CommandManiacControlVarArray(com);
-		case Cmd::Maniac_KeyInputProcEx:
-			return CommandManiacKeyInputProcEx(com);
-		case Cmd::Maniac_RewriteMap:
-			return CommandManiacRewriteMap(com);
-		case Cmd::Maniac_ControlGlobalSave:
-			return CommandManiacControlGlobalSave(com);
-		case Cmd::Maniac_ChangePictureId:
-			return CommandManiacChangePictureId(com);
-		case Cmd::Maniac_SetGameOption:
-			return CommandManiacSetGameOption(com);
-		case Cmd::Maniac_ControlStrings:
-			return CommandManiacControlStrings(com);
-		case Cmd::Maniac_CallCommand:
-			return CommandManiacCallCommand(com);
-		case Cmd::EasyRpg_SetInterpreterFlag:
-			return CommandEasyRpgSetInterpreterFlag(com);
-		case static_cast<Cmd>(2056): //EasyRPG_CloneMapEvent
-			return CommandEasyRpgCloneMapEvent(com);
-		case static_cast<Cmd>(2057): //EasyRPG_DestroyMapEvent
-			return CommandEasyRpgDestroyMapEvent(com);
-		default:
-			return true;
-	}
+bool Game_Interpreter::ExecuteCommand(lcf::rpg::EventCommand const&) {
+	// Commands without a handler are skipped
+	return true;
 }
 
 bool Game_Interpreter::OnFinishStackFrame() {
@@ -825,6 +875,7 @@ bool Game_Interpreter::OnFinishStackFrame() {
 	} else {
 		// If a called frame, or base frame of foreground interpreter, pop the stack.
 		_state.stack.pop_back();
+		_frame_commands.pop_back();
 	}
 
 	return !is_base_frame;
@@ -832,7 +883,7 @@ bool Game_Interpreter::OnFinishStackFrame() {
 
 std::vector<std::string> Game_Interpreter::GetChoices(int max_num_choices) {
 	const auto& frame = GetFrame();
-	const auto& list = frame.commands;
+	const auto& list = GetFrameCommands();
 	auto& index = frame.current_command;
 
 	// Let's find the choices
@@ -869,7 +920,7 @@ bool Game_Interpreter::CommandOptionGeneric(lcf::rpg::EventCommand const& com, i
 
 bool Game_Interpreter::CommandShowMessage(lcf::rpg::EventCommand const& com) { // code 10110
 	auto& frame = GetFrame();
-	const auto& list = frame.commands;
+	const auto& list = GetFrameCommands();
 	auto& index = frame.current_command;
 
 	if (!Game_Message::CanShowMessage(main_flag)) {
@@ -2008,7 +2059,7 @@ bool Game_Interpreter::CommandComment(const lcf::rpg::EventCommand &com) {
 		}
 
 		auto& frame = GetFrame();
-		const auto& list = frame.commands;
+		const auto& list = GetFrameCommands();
 		auto& index = frame.current_command;
 
 		std::string command = ToString(com.string);
@@ -2030,7 +2081,7 @@ bool Game_Interpreter::CommandComment(const lcf::rpg::EventCommand &com) {
 
 void Game_Interpreter::EndEventProcessing() {
 	auto& frame = GetFrame();
-	const auto& list = frame.commands;
+	const auto& list = GetFrameCommands();
 	auto& index = frame.current_command;
 
 	index = static_cast<int>(list.size());
@@ -3519,6 +3570,7 @@ bool Game_Interpreter::CommandConditionalBranch(lcf::rpg::EventCommand const& co
 			switch (com.parameters[1]) {
 				case 0:
 					// Any savestate available
+					SaveWriter::Flush();
 					result = FileFinder::HasSavegame();
 					break;
 				case 1:
@@ -3619,18 +3671,13 @@ bool Game_Interpreter::CommandEndBranch(lcf::rpg::EventCommand const& /* com */)
 
 bool Game_Interpreter::CommandJumpToLabel(lcf::rpg::EventCommand const& com) { // code 12120
 	auto& frame = GetFrame();
-	const auto& list = frame.commands;
 	auto& index = frame.current_command;
 
 	int label_id = com.parameters[0];
 
-	for (int idx = 0; (size_t)idx < list.size(); idx++) {
-		if (static_cast<Cmd>(list[idx].code) != Cmd::Label)
-			continue;
-		if (list[idx].parameters[0] != label_id)
-			continue;
+	int idx = GetFrameCommandList().FindLabel(label_id);
+	if (idx >= 0) {
 		index = idx;
-		break;
 	}
 
 	return true;
@@ -3700,7 +3747,7 @@ bool Game_Interpreter::CommandLoop(lcf::rpg::EventCommand const& com) { // code
 
 bool Game_Interpreter::CommandBreakLoop(lcf::rpg::EventCommand const& /* com */) { // code 12220
 	auto& frame = GetFrame();
-	const auto& list = frame.commands;
+	const auto& list = GetFrameCommands();
 	auto& index = frame.current_command;
 
 	// BreakLoop will jump to the end of the event if there is no loop.
@@ -3727,7 +3774,6 @@ bool Game_Interpreter::CommandBreakLoop(lcf::rpg::EventCommand const& /* com */)
 
 bool Game_Interpreter::CommandEndLoop(lcf::rpg::EventCommand const& com) { // code 22210
 	auto& frame = GetFrame();
-	const auto& list = frame.commands;
 	auto& index = frame.current_command;
 
 	int indent = com.indent;
@@ -3784,19 +3830,14 @@ bool Game_Interpreter::CommandEndLoop(lcf::rpg::EventCommand const& com) { // co
 	}
 
 	// Restart the loop
-	for (int idx = index; idx >= 0; idx--) {
-		if (list[idx].indent > indent)
-			continue;
-		if (list[idx].indent < indent)
-			return false;
-		if (static_cast<Cmd>(list[idx].code) != Cmd::Loop)
-			continue;
-		index = idx;
-		break;
+	int loop_idx = GetFrameCommandList().FindLoopBegin(index, indent);
+	if (loop_idx < 0) {
+		return false;
 	}
+	index = loop_idx;
 
 	// Jump past the Cmd::Loop to the first command.
-	if (index < (int)frame.commands.size()) {
+	if (index < (int)GetFrameCommands().size()) {
 		++index;
 	}
 
@@ -3883,7 +3924,7 @@ bool Game_Interpreter::CommandCallEvent(lcf::rpg::EventCommand const& com) { //
 		return true;
 	}
 
-	Push(page->event_commands, event->GetId(), false, page->ID);
+	Push(event->GetSharedList(page), event->GetId(), false, page->ID);
 
 	return true;
 }
@@ -4020,6 +4061,7 @@ bool Game_Interpreter::CommandManiacGetSaveInfo(lcf::rpg::EventCommand const& co
 		return true;
 	}
 
+	SaveWriter::Flush();
 	auto savefs = FileFinder::Save();
 	std::string save_name = Scene_Save::GetSaveFilename(savefs, save_number);
 	auto save_stream = FileFinder::Save().OpenInputStream(save_name);
@@ -4098,6 +4140,8 @@ bool Game_Interpreter::CommandManiacSave(lcf::rpg::EventCommand const& com) {
 	// Maniac Patch saves directly and game data could be in an undefined state
 	// We yield first to the Update loop and then do a save.
 	_async_op = AsyncOp::MakeSave(slot, out_var);
+	// The next command runs after the file is written
+	_wait_save = true;
 
 	return true;
 }
@@ -4116,6 +4160,7 @@ bool Game_Interpreter::CommandManiacLoad(lcf::rpg::EventCommand const& com) {
 	// Not implemented (kinda useless feature):
 	// When com.parameters[2] is 1 the check whether the file exists is skipped
 	// When skipped and missing RPG_RT will crash
+	SaveWriter::Flush();
 	auto savefs = FileFinder::Save();
 	std::string save_name = Scene_Save::GetSaveFilename(savefs, slot);
 	auto save_stream = FileFinder::Save().OpenInputStream(save_name);
@@ -4876,10 +4921,14 @@ bool Game_Interpreter::CommandManiacControlStrings(lcf::rpg::EventCommand const&
 			search = ToString(Main_Data::game_strings->GetWithModeAndPos(str_param, modes[1], args[1], &pos, *Main_Data::game_variables));
 			replacement = ToString(Main_Data::game_strings->GetWithModeAndPos(str_param, modes[2], args[2], &pos, *Main_Data::game_variables));
 
-			std::regex rexp(search);
+			auto rexp = RegexCache::Get(search);
+			if (!rexp) {
+				result = base;
+				break;
+			}
 
-			if (first_flag) result = std::regex_replace(base, rexp, replacement, std::regex_constants::format_first_only);
-			else result =            std::regex_replace(base, rexp, replacement);
+			if (first_flag) result = std::regex_replace(base, *rexp, replacement, std::regex_constants::format_first_only);
+			else result =            std::regex_replace(base, *rexp, replacement);
 			break;
 		}
 		default:
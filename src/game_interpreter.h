@@ -19,8 +19,11 @@
 #define EP_GAME_INTERPRETER_H
 
 #include <cstdint>
+#include <initializer_list>
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include "async_handler.h"
 #include "game_character.h"
@@ -33,6 +36,8 @@
 #include <lcf/rpg/saveeventexecstate.h>
 #include <lcf/flag_set.h>
 #include "async_op.h"
+#include "event_command_list.h"
+#include "interpreter_profiler.h"
 
 class Game_Event;
 class Game_CommonEvent;
@@ -45,6 +50,8 @@ class Game_Interpreter : public Game_BaseInterpreterContext
 {
 public:
 	using Cmd = lcf::rpg::EventCommand::Code;
+	/** Immutable event commands shared by all frames running them */
+	using CommandList = std::shared_ptr<const EventCommandList>;
 
 	static Game_Interpreter& GetForegroundInterpreter();
 
@@ -70,6 +77,12 @@ public:
 			bool started_by_decision_key = false,
 			int event_page_id = 0
 	);
+	void Push(
+			CommandList _list,
+			int _event_id,
+			bool started_by_decision_key = false,
+			int event_page_id = 0
+	);
 	void Push(Game_Event* ev);
 	void Push(Game_Event* ev, const lcf::rpg::EventPage* page, bool triggered_by_decision_key);
 	void Push(Game_CommonEvent* ev);
@@ -77,16 +90,32 @@ public:
 	void InputButton();
 	void SetupChoices(const std::vector<std::string>& choices, int indent, PendingMessage& pm);
 
+	/**
+	 * Executes the current command through the command table.
+	 * Codes without an entry go to ExecuteCommand(com).
+	 */
 	bool ExecuteCommand();
+
+	/**
+	 * Fallback for commands without an entry in the command table.
+	 * Skips the command, subclasses override it to handle additional codes.
+	 */
 	virtual bool ExecuteCommand(lcf::rpg::EventCommand const& com);
 
 
 	/**
 	 * Returns the interpreters current state information.
+	 * The commands of the frames are not part of it, see GetFrameCommands.
 	 * For saving state into a save file, use GetSaveState instead.
 	 */
 	const lcf::rpg::SaveEventExecState& GetState() const;
 
+	/**
+	 * @param frame_idx index of the frame in the stack
+	 * @return event commands executed by the frame
+	 */
+	const std::vector<lcf::rpg::EventCommand>& GetFrameCommands(int frame_idx) const;
+
 	/**
 	 * Returns a SaveEventExecState needed for the savefile.
 	 *
@@ -122,6 +151,26 @@ public:
 	bool IsWaitingForWaitCommand() const;
 
 protected:
+	using CommandHandler = bool (Game_Interpreter::*)(lcf::rpg::EventCommand const&);
+	/** Command handlers indexed by EventCommandList::GetCodeSlot */
+	using CommandTable = std::vector<CommandHandler>;
+
+	/**
+	 * @param _main_flag see Game_Interpreter(bool)
+	 * @param table command handlers of the subclass, must outlive the interpreter
+	 */
+	Game_Interpreter(bool _main_flag, const CommandTable& table);
+
+	/**
+	 * @param handlers command codes and their handlers
+	 * @param base table to extend, the handlers replace entries of the same code
+	 * @return command table for use by the constructor
+	 */
+	static CommandTable MakeCommandTable(std::initializer_list<std::pair<Cmd, CommandHandler>> handlers, const CommandTable* base = nullptr);
+
+	/** @return handlers of the commands available to all events */
+	static const CommandTable& GetCommandTable();
+
 	static constexpr int loop_limit = 10000;
 	static constexpr int call_stack_limit = 1000;
 	static constexpr int subcommand_sentinel = 255;
@@ -131,6 +180,23 @@ protected:
 	const lcf::rpg::SaveEventExecFrame* GetFramePtr() const;
 	lcf::rpg::SaveEventExecFrame* GetFramePtr();
 
+	/** @return event commands of the current frame */
+	const std::vector<lcf::rpg::EventCommand>& GetFrameCommands() const;
+
+	/** @return event commands of the current frame with the decoded jumps */
+	const EventCommandList& GetFrameCommandList() const;
+
+	/**
+	 * Moves the commands of the frames in _state into lists.
+	 * Frames running the unchanged commands of a map event page or a common
+	 * event share its list, other frames keep their commands as a private list.
+	 * Must be called after _state was loaded from a save file.
+	 */
+	void ShareFrameCommands();
+
+	/** @return the call stack for the profiler, the current command last */
+	std::vector<InterpreterProfiler::Frame> GetProfilerStack() const;
+
 	bool main_flag;
 
 	int loop_count = 0;
@@ -343,8 +409,27 @@ protected:
 	int ManiacBitmask(int value, int mask) const;
 
 	lcf::rpg::SaveEventExecState _state;
+	struct FrameCommands {
+		CommandList list;
+		/** Common event running in the frame, 0 for other events */
+		int common_event_id = 0;
+	};
+
+	/**
+	 * Event commands of the frames in _state.stack. The command vectors of
+	 * the frames stay empty, only GetSaveState fills them.
+	 */
+	std::vector<FrameCommands> _frame_commands;
 	KeyInputState _keyinput;
 	AsyncOp _async_op = {};
+	/**
+	 * Waits until the save started by this interpreter is written.
+	 * Saves are finished in order, so this waits for all pending saves,
+	 * including a save from the save menu which was requested before.
+	 */
+	bool _wait_save = false;
+	/** Command handlers of the subclass */
+	const CommandTable* command_table = nullptr;
 
 	friend class Scene_Debug;
 };
@@ -357,6 +442,15 @@ inline lcf::rpg::SaveEventExecFrame* Game_Interpreter::GetFramePtr() {
 	return !_state.stack.empty() ? &_state.stack.back() : nullptr;
 }
 
+inline const std::vector<lcf::rpg::EventCommand>& Game_Interpreter::GetFrameCommands() const {
+	return GetFrameCommandList().GetCommands();
+}
+
+inline const EventCommandList& Game_Interpreter::GetFrameCommandList() const {
+	assert(!_frame_commands.empty());
+	return *_frame_commands.back().list;
+}
+
 inline const lcf::rpg::SaveEventExecFrame& Game_Interpreter::GetFrame() const {
 	auto* frame = GetFramePtr();
 	assert(frame);
@@ -37,7 +37,7 @@ enum BranchBattleSubcommand {
 };
 
 Game_Interpreter_Battle::Game_Interpreter_Battle(Span<const lcf::rpg::TroopPage> pages)
-	: Game_Interpreter(true), pages(pages), executed(pages.size(), false)
+	: Game_Interpreter(true, GetCommandTable()), pages(pages), executed(pages.size(), false)
 {
 }
 
@@ -172,53 +172,35 @@ int Game_Interpreter_Battle::ScheduleNextPage(lcf::rpg::TroopPageCondition::Flag
 			continue;
 		}
 		Clear();
-		Push(page.event_commands, 0);
+		Push(page.event_commands, 0, false, page.ID);
 		executed[i] = true;
 		return i + 1;
 	}
 	return 0;
 }
 
-// Execute Command.
-bool Game_Interpreter_Battle::ExecuteCommand(lcf::rpg::EventCommand const& com) {
-	switch (static_cast<Cmd>(com.code)) {
-		case Cmd::CallCommonEvent:
-			return CommandCallCommonEvent(com);
-		case Cmd::ForceFlee:
-			return CommandForceFlee(com);
-		case Cmd::EnableCombo:
-			return CommandEnableCombo(com);
-		case Cmd::ChangeMonsterHP:
-			return CommandChangeMonsterHP(com);
-		case Cmd::ChangeMonsterMP:
-			return CommandChangeMonsterMP(com);
-		case Cmd::ChangeMonsterCondition:
-			return CommandChangeMonsterCondition(com);
-		case Cmd::ShowHiddenMonster:
-			return CommandShowHiddenMonster(com);
-		case Cmd::ChangeBattleBG:
-			return CommandChangeBattleBG(com);
-		case Cmd::ShowBattleAnimation_B:
-			return CommandShowBattleAnimation(com);
-		case Cmd::TerminateBattle:
-			return CommandTerminateBattle(com);
-		case Cmd::ConditionalBranch_B:
-			return CommandConditionalBranchBattle(com);
-		case Cmd::ElseBranch_B:
-			return CommandElseBranchBattle(com);
-		case Cmd::EndBranch_B:
-			return CommandEndBranchBattle(com);
-		case Cmd::Maniac_ControlBattle:
-			return CommandManiacControlBattle(com);
-		case Cmd::Maniac_ControlAtbGauge:
-			return CommandManiacControlAtbGauge(com);
-		case Cmd::Maniac_ChangeBattleCommandEx:
-			return CommandManiacChangeBattleCommandEx(com);
-		case Cmd::Maniac_GetBattleInfo:
-			return CommandManiacGetBattleInfo(com);
-		default:
-			return Game_Interpreter::ExecuteCommand(com);
-	}
+// Command handlers of battle events.
+const Game_Interpreter::CommandTable& Game_Interpreter_Battle::GetCommandTable() {
+	static const CommandTable table = MakeCommandTable({
+		{ Cmd::CallCommonEvent, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandCallCommonEvent) },
+		{ Cmd::ForceFlee, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandForceFlee) },
+		{ Cmd::EnableCombo, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandEnableCombo) },
+		{ Cmd::ChangeMonsterHP, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandChangeMonsterHP) },
+		{ Cmd::ChangeMonsterMP, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandChangeMonsterMP) },
+		{ Cmd::ChangeMonsterCondition, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandChangeMonsterCondition) },
+		{ Cmd::ShowHiddenMonster, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandShowHiddenMonster) },
+		{ Cmd::ChangeBattleBG, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandChangeBattleBG) },
+		{ Cmd::ShowBattleAnimation_B, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandShowBattleAnimation) },
+		{ Cmd::TerminateBattle, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandTerminateBattle) },
+		{ Cmd::ConditionalBranch_B, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandConditionalBranchBattle) },
+		{ Cmd::ElseBranch_B, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandElseBranchBattle) },
+		{ Cmd::EndBranch_B, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandEndBranchBattle) },
+		{ Cmd::Maniac_ControlBattle, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandManiacControlBattle) },
+		{ Cmd::Maniac_ControlAtbGauge, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandManiacControlAtbGauge) },
+		{ Cmd::Maniac_ChangeBattleCommandEx, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandManiacChangeBattleCommandEx) },
+		{ Cmd::Maniac_GetBattleInfo, static_cast<CommandHandler>(&Game_Interpreter_Battle::CommandManiacGetBattleInfo) }
+	}, &Game_Interpreter::GetCommandTable());
+	return table;
 }
 
 // Commands
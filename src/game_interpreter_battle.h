@@ -58,9 +58,10 @@ public:
 
 	bool IsForceFleeEnabled() const;
 
-	bool ExecuteCommand(lcf::rpg::EventCommand const& com) override;
-
 private:
+	/** @return handlers of the commands available to battle events */
+	static const CommandTable& GetCommandTable();
+
 	bool CommandCallCommonEvent(lcf::rpg::EventCommand const& com);
 	bool CommandForceFlee(lcf::rpg::EventCommand const& com);
 	bool CommandEnableCombo(lcf::rpg::EventCommand const& com);
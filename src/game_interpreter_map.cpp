@@ -79,9 +79,15 @@ enum InnSubcommand {
 
 using namespace Game_Interpreter_Shared;
 
+Game_Interpreter_Map::Game_Interpreter_Map(bool _main_flag)
+	: Game_Interpreter(_main_flag, GetCommandTable())
+{
+}
+
 void Game_Interpreter_Map::SetState(const lcf::rpg::SaveEventExecState& save) {
 	Clear();
 	_state = save;
+	ShareFrameCommands();
 	_keyinput.fromSave(save);
 }
 
@@ -174,71 +180,41 @@ bool Game_Interpreter_Map::RequestMainMenuScene(int subscreen_id, int actor_inde
 }
 
 /**
- * Execute Command.
+ * Command handlers of map events.
  */
-bool Game_Interpreter_Map::ExecuteCommand(lcf::rpg::EventCommand const& com) {
-	switch (static_cast<Cmd>(com.code)) {
-		case Cmd::RecallToLocation:
-			return CommandRecallToLocation(com);
-		case Cmd::EnemyEncounter:
-			return CommandEnemyEncounter(com);
-		case Cmd::VictoryHandler:
-			return CommandVictoryHandler(com);
-		case Cmd::EscapeHandler:
-			return CommandEscapeHandler(com);
-		case Cmd::DefeatHandler:
-			return CommandDefeatHandler(com);
-		case Cmd::EndBattle:
-			return CommandEndBattle(com);
-		case Cmd::OpenShop:
-			return CommandOpenShop(com);
-		case Cmd::Transaction:
-			return CommandTransaction(com);
-		case Cmd::NoTransaction:
-			return CommandNoTransaction(com);
-		case Cmd::EndShop:
-			return CommandEndShop(com);
-		case Cmd::ShowInn:
-			return CommandShowInn(com);
-		case Cmd::Stay:
-			return CommandStay(com);
-		case Cmd::NoStay:
-			return CommandNoStay(com);
-		case Cmd::EndInn:
-			return CommandEndInn(com);
-		case Cmd::EnterHeroName:
-			return CommandEnterHeroName(com);
-		case Cmd::Teleport:
-			return CommandTeleport(com);
-		case Cmd::EnterExitVehicle:
-			return CommandEnterExitVehicle(com);
-		case Cmd::PanScreen:
-			return CommandPanScreen(com);
-		case Cmd::ShowBattleAnimation:
-			return CommandShowBattleAnimation(com);
-		case Cmd::FlashSprite:
-			return CommandFlashSprite(com);
-		case Cmd::ProceedWithMovement:
-			return CommandProceedWithMovement(com);
-		case Cmd::HaltAllMovement:
-			return CommandHaltAllMovement(com);
-		case Cmd::PlayMovie:
-			return CommandPlayMovie(com);
-		case Cmd::OpenSaveMenu:
-			return CommandOpenSaveMenu(com);
-		case Cmd::OpenMainMenu:
-			return CommandOpenMainMenu(com);
-		case Cmd::OpenLoadMenu:
-			return CommandOpenLoadMenu(com);
-		case Cmd::ToggleAtbMode:
-			return CommandToggleAtbMode(com);
-		case Cmd::EasyRpg_TriggerEventAt:
-			return CommandEasyRpgTriggerEventAt(com);
-		case Cmd::EasyRpg_WaitForSingleMovement:
-			return CommandEasyRpgWaitForSingleMovement(com);
-		default:
-			return Game_Interpreter::ExecuteCommand(com);
-	}
+const Game_Interpreter::CommandTable& Game_Interpreter_Map::GetCommandTable() {
+	static const CommandTable table = MakeCommandTable({
+		{ Cmd::RecallToLocation, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandRecallToLocation) },
+		{ Cmd::EnemyEncounter, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandEnemyEncounter) },
+		{ Cmd::VictoryHandler, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandVictoryHandler) },
+		{ Cmd::EscapeHandler, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandEscapeHandler) },
+		{ Cmd::DefeatHandler, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandDefeatHandler) },
+		{ Cmd::EndBattle, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandEndBattle) },
+		{ Cmd::OpenShop, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandOpenShop) },
+		{ Cmd::Transaction, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandTransaction) },
+		{ Cmd::NoTransaction, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandNoTransaction) },
+		{ Cmd::EndShop, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandEndShop) },
+		{ Cmd::ShowInn, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandShowInn) },
+		{ Cmd::Stay, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandStay) },
+		{ Cmd::NoStay, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandNoStay) },
+		{ Cmd::EndInn, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandEndInn) },
+		{ Cmd::EnterHeroName, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandEnterHeroName) },
+		{ Cmd::Teleport, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandTeleport) },
+		{ Cmd::EnterExitVehicle, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandEnterExitVehicle) },
+		{ Cmd::PanScreen, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandPanScreen) },
+		{ Cmd::ShowBattleAnimation, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandShowBattleAnimation) },
+		{ Cmd::FlashSprite, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandFlashSprite) },
+		{ Cmd::ProceedWithMovement, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandProceedWithMovement) },
+		{ Cmd::HaltAllMovement, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandHaltAllMovement) },
+		{ Cmd::PlayMovie, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandPlayMovie) },
+		{ Cmd::OpenSaveMenu, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandOpenSaveMenu) },
+		{ Cmd::OpenMainMenu, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandOpenMainMenu) },
+		{ Cmd::OpenLoadMenu, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandOpenLoadMenu) },
+		{ Cmd::ToggleAtbMode, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandToggleAtbMode) },
+		{ Cmd::EasyRpg_TriggerEventAt, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandEasyRpgTriggerEventAt) },
+		{ Cmd::EasyRpg_WaitForSingleMovement, static_cast<CommandHandler>(&Game_Interpreter_Map::CommandEasyRpgWaitForSingleMovement) }
+	}, &Game_Interpreter::GetCommandTable());
+	return table;
 }
 
 /**
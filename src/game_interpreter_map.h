@@ -36,7 +36,7 @@ class Game_CommonEvent;
 class Game_Interpreter_Map : public Game_Interpreter
 {
 public:
-	using Game_Interpreter::Game_Interpreter;
+	explicit Game_Interpreter_Map(bool _main_flag = false);
 
 	/**
 	 * Sets up the interpreter with given state.
@@ -53,9 +53,10 @@ public:
 
 	bool RequestMainMenuScene(int subscreen_id = -1, int actor_index = 0, bool is_db_actor = false);
 
-	bool ExecuteCommand(lcf::rpg::EventCommand const& com) override;
-
 private:
+	/** @return handlers of the commands available to map and common events */
+	static const CommandTable& GetCommandTable();
+
 	bool CommandRecallToLocation(lcf::rpg::EventCommand const& com);
 	bool CommandEnemyEncounter(lcf::rpg::EventCommand const& com);
 	bool CommandVictoryHandler(lcf::rpg::EventCommand const& com);
@@ -56,6 +56,8 @@
 #include <lcf/rpg/save.h>
 #include "scene_gameover.h"
 #include "feature.h"
+#include "map_file_cache.h"
+#include "worker_pool.h"
 
 namespace {
 	// Intended bad value, Game_Map::Init sets them correctly
@@ -75,7 +77,10 @@ namespace {
 	std::vector<Game_CommonEvent> common_events;
 	std::unique_ptr<Game_Map::Caching::MapCache> map_cache;
 
-	std::unique_ptr<lcf::rpg::Map> map;
+	/** Shared with the MapFileCache until GetWritableMap copies it */
+	std::shared_ptr<const lcf::rpg::Map> map;
+	/** The map when it is a private copy, otherwise nullptr */
+	lcf::rpg::Map* map_writable = nullptr;
 
 	std::unique_ptr<Game_Interpreter_Map> interpreter;
 	std::vector<Game_Vehicle> vehicles;
@@ -95,6 +100,20 @@ namespace {
 
 namespace Game_Map {
 void SetupCommon();
+
+/**
+ * Copies the map on the first call after the setup, so events can be added
+ * and removed without changing the map in the MapFileCache.
+ *
+ * @return the map
+ */
+lcf::rpg::Map& GetWritableMap();
+
+/**
+ * Reads the map files targeted by Teleport commands of the current map in
+ * the background to make the next map change faster.
+ */
+void PrefetchTeleportTargets();
 }
 
 void Game_Map::OnContinueFromBattle() {
@@ -136,6 +155,7 @@ void Game_Map::InitCommonEvents() {
 void Game_Map::Dispose() {
 	events.clear();
 	map.reset();
+	map_writable = nullptr;
 	map_info = {};
 	panorama = {};
 }
@@ -153,13 +173,14 @@ int Game_Map::GetMapSaveCount() {
 		: map->save_count;
 }
 
-void Game_Map::Setup(std::unique_ptr<lcf::rpg::Map> map_in) {
+void Game_Map::Setup(std::shared_ptr<const lcf::rpg::Map> map_in) {
 	Dispose();
 
 	screen_width = (Player::screen_width / 16) * SCREEN_TILE_SIZE;
 	screen_height = (Player::screen_height / 16) * SCREEN_TILE_SIZE;
 
 	map = std::move(map_in);
+	map_writable = nullptr;
 
 	SetupCommon();
 
@@ -219,7 +240,7 @@ void Game_Map::Setup(std::unique_ptr<lcf::rpg::Map> map_in) {
 }
 
 void Game_Map::SetupFromSave(
-		std::unique_ptr<lcf::rpg::Map> map_in,
+		std::shared_ptr<const lcf::rpg::Map> map_in,
 		lcf::rpg::SaveMapInfo save_map,
 		lcf::rpg::SaveVehicleLocation save_boat,
 		lcf::rpg::SaveVehicleLocation save_ship,
@@ -229,6 +250,7 @@ void Game_Map::SetupFromSave(
 		std::vector<lcf::rpg::SaveCommonEvent> save_ce) {
 
 	map = std::move(map_in);
+	map_writable = nullptr;
 	map_info = std::move(save_map);
 	panorama = std::move(save_pan);
 
@@ -291,58 +313,147 @@ void Game_Map::SetupFromSave(
 	Game_Map::Parallax::ChangeBG(GetParallaxParams());
 }
 
-std::unique_ptr<lcf::rpg::Map> Game_Map::LoadMapFile(int map_id) {
-	std::unique_ptr<lcf::rpg::Map> map;
+namespace {
+	struct MapFile {
+		std::string name;
+		std::string path;
+		bool is_xml = false;
+	};
 
 	// Try loading EasyRPG map files first, then fallback to normal RPG Maker
-	// FIXME: Assert map was cached for async platforms
-	std::string map_name = Game_Map::ConstructMapName(map_id, true);
-	std::string map_file = FileFinder::Game().FindFile(map_name);
-	if (map_file.empty()) {
-		map_name = Game_Map::ConstructMapName(map_id, false);
-		map_file = FileFinder::Game().FindFile(map_name);
-
-		if (map_file.empty()) {
-			Output::Error("Loading of Map {} failed.\nThe map was not found.", map_name);
-			return nullptr;
-		}
+	MapFile FindMapFile(int map_id) {
+		MapFile file;
+		file.name = Game_Map::ConstructMapName(map_id, true);
+		file.path = FileFinder::Game().FindFile(file.name);
+		file.is_xml = true;
 
-		auto map_stream = FileFinder::Game().OpenInputStream(map_file);
-		if (!map_stream) {
-			Output::Error("Loading of Map {} failed.\nMap not readable.", map_name);
-			return nullptr;
+		if (file.path.empty()) {
+			file.name = Game_Map::ConstructMapName(map_id, false);
+			file.path = FileFinder::Game().FindFile(file.name);
+			file.is_xml = false;
 		}
 
-		map = lcf::LMU_Reader::Load(map_stream, Player::encoding);
+		return file;
+	}
 
-		if (Input::IsRecording()) {
-			map_stream.clear();
-			map_stream.seekg(0);
+	MapFileCache::Key MakeCacheKey(const MapFile& file, StringView translation) {
+		return { file.path, FileFinder::Game().GetModificationTime(file.path), ToString(translation) };
+	}
+}
+
+std::shared_ptr<const lcf::rpg::Map> Game_Map::LoadMapFile(int map_id) {
+	// FIXME: Assert map was cached for async platforms
+	MapFile file = FindMapFile(map_id);
+	if (file.path.empty()) {
+		Output::Error("Loading of Map {} failed.\nThe map was not found.", file.name);
+		return nullptr;
+	}
+
+	const auto& translation = Tr::GetCurrentTranslationId();
+	auto key = MakeCacheKey(file, "");
+
+	if (Input::IsRecording() && !file.is_xml) {
+		auto map_stream = FileFinder::Game().OpenInputStream(file.path);
+		if (map_stream) {
 			Input::AddRecordingData(Input::RecordingData::Hash,
 						   fmt::format("map{:04} {:#08x}", map_id, Utils::CRC32(map_stream)));
 		}
+	}
+
+	if (!translation.empty()) {
+		auto tr_key = key;
+		tr_key.translation = translation;
+		if (auto cached = MapFileCache::Get(tr_key)) {
+			Output::Debug("Loaded Map {} (cached)", file.name);
+			return cached;
+		}
+	}
+
+	auto map = MapFileCache::Get(key);
+
+	if (map) {
+		Output::Debug("Loaded Map {} (cached)", file.name);
 	} else {
-		auto map_stream = FileFinder::Game().OpenInputStream(map_file);
-		if (!map_stream) {
-			Output::Error("Loading of Map {} failed.\nMap not readable.", map_name);
+		std::unique_ptr<lcf::rpg::Map> loaded;
+		if (auto data = MapFileCache::TakePrefetched(key)) {
+			loaded = MapFileCache::Parse(*data, file.is_xml, Player::encoding);
+		} else {
+			auto map_stream = FileFinder::Game().OpenInputStream(file.path);
+			if (!map_stream) {
+				Output::Error("Loading of Map {} failed.\nMap not readable.", file.name);
+				return nullptr;
+			}
+
+			loaded = MapFileCache::Parse(map_stream, file.is_xml, Player::encoding);
+		}
+
+		if (loaded.get() == NULL) {
+			Output::ErrorStr(lcf::LcfReader::GetError());
 			return nullptr;
 		}
-		map = lcf::LMU_Reader::LoadXml(map_stream);
-	}
 
-	Output::Debug("Loaded Map {}", map_name);
+		Output::Debug("Loaded Map {}", file.name);
+		map = std::move(loaded);
+		MapFileCache::Put(key, map);
+	}
 
-	if (map.get() == NULL) {
-		Output::ErrorStr(lcf::LcfReader::GetError());
+	if (!translation.empty()) {
+		// The untranslated map stays in the cache for the other languages
+		auto translated = std::make_shared<lcf::rpg::Map>(*map);
+		TranslateMapMessages(map_id, *translated);
+		map = std::move(translated);
+		key.translation = translation;
+		MapFileCache::Put(key, map);
 	}
 
 	return map;
 }
 
-void Game_Map::SetupCommon() {
-	if (!Tr::GetCurrentTranslationId().empty()) {
-		TranslateMapMessages(GetMapId(), *map);
+void Game_Map::PrefetchTeleportTargets() {
+	if (WorkerPool::GetNumWorkers() == 0) {
+		return;
+	}
+
+	std::vector<int> targets;
+	for (const auto& ev : map->events) {
+		for (const auto& page : ev.pages) {
+			for (const auto& cmd : page.event_commands) {
+				if (static_cast<lcf::rpg::EventCommand::Code>(cmd.code) != lcf::rpg::EventCommand::Code::Teleport || cmd.parameters.empty()) {
+					continue;
+				}
+				const int target = cmd.parameters[0];
+				if (target > 0 && target != GetMapId() && std::find(targets.begin(), targets.end(), target) == targets.end()) {
+					targets.push_back(target);
+				}
+			}
+		}
 	}
+
+	// Hub maps can link to dozens of maps, only the first few are kept
+	constexpr size_t max_prefetch = 4;
+	size_t num_prefetch = 0;
+
+	for (int target : targets) {
+		if (num_prefetch >= max_prefetch) {
+			break;
+		}
+		MapFile file = FindMapFile(target);
+		if (file.path.empty()) {
+			continue;
+		}
+
+		auto key = MakeCacheKey(file, "");
+		if (MapFileCache::IsCachedOrPending(key)) {
+			continue;
+		}
+
+		// Opening happens here because the filesystems are not thread-safe
+		MapFileCache::Prefetch(std::move(key), FileFinder::Game().OpenInputStream(file.path));
+		++num_prefetch;
+	}
+}
+
+void Game_Map::SetupCommon() {
 	SetNeedRefresh(true);
 
 	PrintPathToMap();
@@ -354,6 +465,8 @@ void Game_Map::SetupCommon() {
 	map_cache->Clear();
 
 	CreateMapEvents();
+
+	PrefetchTeleportTargets();
 }
 
 void Game_Map::CreateMapEvents() {
@@ -403,7 +516,7 @@ void Game_Map::Caching::MapCache::Clear() {
 }
 
 bool Game_Map::CloneMapEvent(int src_map_id, int src_event_id, int target_x, int target_y, int target_event_id, StringView target_name) {
-	std::unique_ptr<lcf::rpg::Map> source_map_storage;
+	std::shared_ptr<const lcf::rpg::Map> source_map_storage;
 	const lcf::rpg::Map* source_map;
 
 	if (src_map_id == GetMapId()) {
@@ -416,10 +529,6 @@ bool Game_Map::CloneMapEvent(int src_map_id, int src_event_id, int target_x, int
 			Output::Warning("CloneMapEvent: Invalid source map ID {}", src_map_id);
 			return false;
 		}
-
-		if (!Tr::GetCurrentTranslationId().empty()) {
-			TranslateMapMessages(src_map_id, *source_map_storage);
-		}
 	}
 
 	const lcf::rpg::Event* source_event = FindEventById(source_map->events, src_event_id);
@@ -443,8 +552,9 @@ bool Game_Map::CloneMapEvent(int src_map_id, int src_event_id, int target_x, int
 	}
 
 	// sorted insert
-	auto insert_it = map->events.insert(
-		std::upper_bound(map->events.begin(), map->events.end(), new_event, [](const auto& e, const auto& e2) {
+	auto& map_events = GetWritableMap().events;
+	auto insert_it = map_events.insert(
+		std::upper_bound(map_events.begin(), map_events.end(), new_event, [](const auto& e, const auto& e2) {
 			return e.ID < e2.ID;
 		}), new_event);
 
@@ -466,7 +576,8 @@ bool Game_Map::CloneMapEvent(int src_map_id, int src_event_id, int target_x, int
 }
 
 bool Game_Map::DestroyMapEvent(const int event_id, bool from_clone) {
-	const lcf::rpg::Event* event = FindEventById(map->events, event_id);
+	auto& map_events = GetWritableMap().events;
+	const lcf::rpg::Event* event = FindEventById(map_events, event_id);
 
 	if (event == nullptr) {
 		if (!from_clone) {
@@ -487,9 +598,9 @@ bool Game_Map::DestroyMapEvent(const int event_id, bool from_clone) {
 	}
 
 	// Remove event from map
-	for (auto it = map->events.begin(); it != map->events.end(); ++it) {
+	for (auto it = map_events.begin(); it != map_events.end(); ++it) {
 		if (it->ID == event_id) {
-			map->events.erase(it);
+			map_events.erase(it);
 			break;
 		}
 	}
@@ -527,6 +638,16 @@ void Game_Map::UpdateUnderlyingEventReferences() {
 	Main_Data::game_screen->UpdateUnderlyingEventReferences();
 }
 
+lcf::rpg::Map& Game_Map::GetWritableMap() {
+	if (!map_writable) {
+		auto copy = std::make_shared<lcf::rpg::Map>(*map);
+		map_writable = copy.get();
+		map = std::move(copy);
+		UpdateUnderlyingEventReferences();
+	}
+	return *map_writable;
+}
+
 const lcf::rpg::Event* Game_Map::FindEventById(const std::vector<lcf::rpg::Event>& events, int eventId) {
 	for (const auto& ev : events) {
 		if (ev.ID == eventId) {
@@ -1283,9 +1404,95 @@ void Game_Map::UpdateProcessedFlags(bool is_preupdate) {
 }
 
 
+namespace {
+	bool Intersects(const std::vector<int>& a, const std::vector<int>& b) {
+		auto ia = a.begin();
+		auto ib = b.begin();
+		while (ia != a.end() && ib != b.end()) {
+			if (*ia < *ib) {
+				++ia;
+			} else if (*ib < *ia) {
+				++ib;
+			} else {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Merge(std::vector<int>& ids, const std::vector<int>& other) {
+		auto size = ids.size();
+		ids.insert(ids.end(), other.begin(), other.end());
+		std::inplace_merge(ids.begin(), ids.begin() + size, ids.end());
+	}
+
+	/**
+	 * Consecutive independent parallel common events which are updated
+	 * concurrently. No event of a batch writes a variable another event of
+	 * the batch accesses, so the result is the same as updating them in
+	 * order.
+	 */
+	struct CommonEventBatch {
+		std::vector<Game_CommonEvent*> events;
+		std::vector<int> var_reads;
+		std::vector<int> var_writes;
+
+		bool Add(Game_CommonEvent& ev) {
+			if (!ev.CanUpdateConcurrently()) {
+				return false;
+			}
+
+			const auto& access = ev.GetAccess();
+
+			// Map refreshes must happen on the main thread
+			for (int var_id : access.var_writes) {
+				if (map_cache->GetNeedRefresh<Game_Map::Caching::ObservedVarOps::VarSet>(var_id)) {
+					return false;
+				}
+			}
+
+			if (Intersects(access.var_writes, var_reads) || Intersects(access.var_writes, var_writes) ||
+					Intersects(access.var_reads, var_writes)) {
+				Run();
+			}
+
+			events.push_back(&ev);
+			Merge(var_reads, access.var_reads);
+			Merge(var_writes, access.var_writes);
+			return true;
+		}
+
+		void Run() {
+			if (events.empty()) {
+				return;
+			}
+
+			if (need_refresh) {
+				Game_Map::Refresh();
+			}
+
+			WorkerPool::ParallelFor(static_cast<int>(events.size()), [this](int i) {
+				auto aop = events[i]->Update(false);
+				assert(!aop.IsActive());
+				(void)aop;
+			});
+
+			events.clear();
+			var_reads.clear();
+			var_writes.clear();
+		}
+	};
+}
+
 bool Game_Map::UpdateCommonEvents(MapUpdateAsyncContext& actx) {
 	int resume_ce = actx.GetParallelCommonEvent();
 
+	const bool concurrent = resume_ce == 0 &&
+		Player::player_config.parallel_common_events.Get() &&
+		WorkerPool::GetNumWorkers() > 0 &&
+		!(Input::IsTriggered(Input::DEBUG_ABORT_EVENT) && Player::debug_flag);
+	CommonEventBatch batch;
+
 	for (Game_CommonEvent& ev : common_events) {
 		bool resume_async = false;
 		if (resume_ce != 0) {
@@ -1298,6 +1505,14 @@ bool Game_Map::UpdateCommonEvents(MapUpdateAsyncContext& actx) {
 			}
 		}
 
+		if (concurrent) {
+			if (!ev.IsWaitingBackgroundExecution(false) || batch.Add(ev)) {
+				continue;
+			}
+			// Events of the batch come first
+			batch.Run();
+		}
+
 		auto aop = ev.Update(resume_async);
 		if (aop.IsActive()) {
 			// Suspend due to this event ..
@@ -1305,6 +1520,7 @@ bool Game_Map::UpdateCommonEvents(MapUpdateAsyncContext& actx) {
 			return false;
 		}
 	}
+	batch.Run();
 
 	actx = {};
 	return true;
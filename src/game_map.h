@@ -21,6 +21,7 @@
 // Headers
 #include <cstdint>
 #include <initializer_list>
+#include <memory>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -127,19 +128,23 @@ namespace Game_Map {
 	int GetNextAvailableEventId();
 
 	/**
-	 * Loads the map from disk
+	 * Loads the map from disk.
+	 * The messages are translated to the active language.
+	 * Recently loaded maps are returned from the MapFileCache.
 	 *
 	 * @param map_id the id of the map to load
-	 * @return the map, or nullptr if it couldn't be loaded
+	 * @return the map shared with the MapFileCache, or nullptr if it couldn't be loaded
 	 */
-	std::unique_ptr<lcf::rpg::Map> LoadMapFile(int map_id);
+	std::shared_ptr<const lcf::rpg::Map> LoadMapFile(int map_id);
 
 	/**
 	 * Setups a new map.
 	 *
 	 * @pre Main_Data::game_player->GetMapId() reflects the new map.
+	 *
+	 * @param map the map data, copied before events are cloned or destroyed
 	 */
-	void Setup(std::unique_ptr<lcf::rpg::Map> map);
+	void Setup(std::shared_ptr<const lcf::rpg::Map> map);
 
 	/**
 	 * Setups a map from a savegame.
@@ -154,7 +159,7 @@ namespace Game_Map {
 	 * @param save_ce - The common event state
 	 */
 	void SetupFromSave(
-			std::unique_ptr<lcf::rpg::Map> map,
+			std::shared_ptr<const lcf::rpg::Map> map,
 			lcf::rpg::SaveMapInfo save_map,
 			lcf::rpg::SaveVehicleLocation save_boat,
 			lcf::rpg::SaveVehicleLocation save_ship,
@@ -692,6 +697,15 @@ namespace Game_Map {
 	void RemoveAllPendingMoves();
 
 	void UpdateProcessedFlags(bool is_preupdate);
+
+	/**
+	 * Updates the parallel common events.
+	 * When enabled in the settings, consecutive independent events are
+	 * updated concurrently on the worker pool.
+	 *
+	 * @param actx async context, the event to resume from
+	 * @return false when an event started an async operation
+	 */
 	bool UpdateCommonEvents(MapUpdateAsyncContext& actx);
 	bool UpdateMapEvents(MapUpdateAsyncContext& actx);
 	bool UpdateMessage(MapUpdateAsyncContext& actx);
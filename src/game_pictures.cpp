@@ -15,6 +15,7 @@
  * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cmath>
 #include "bitmap.h"
 #include "options.h"
@@ -493,6 +494,12 @@ void Game_Pictures::OnMapScrolled(int dx, int dy) {
 	}
 }
 
+bool Game_Pictures::HasPictureBelow(Drawable::Z_t z) const {
+	return std::any_of(pictures.begin(), pictures.end(), [z](const Picture& pic) {
+		return pic.sprite && pic.sprite->IsVisible() && pic.sprite->GetZ() < z;
+	});
+}
+
 void Game_Pictures::Picture::AttachWindow(const Window_Base& window) {
 	data.easyrpg_type = lcf::rpg::SavePicture::EasyRpgType_window;
 
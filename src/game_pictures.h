@@ -93,6 +93,12 @@ public:
 	void OnBattleEnd();
 	void OnMapScrolled(int dx, int dy);
 
+	/**
+	 * @param z priority to check
+	 * @return Whether a visible picture is drawn below z
+	 */
+	bool HasPictureBelow(Drawable::Z_t z) const;
+
 	struct Picture {
 		explicit Picture(int id) { data.ID = id; }
 		explicit Picture(lcf::rpg::SavePicture data);
@@ -0,0 +1,230 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "game_scanner.h"
+#include "exe_reader.h"
+#include "filefinder.h"
+#include "filesystem_native.h"
+#include "options.h"
+#include "platform.h"
+#include "player.h"
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <lcf/inireader.h>
+#include <lcf/reader_util.h>
+
+#ifdef HAVE_THREADS
+#  include <mutex>
+#endif
+
+struct GameScanner::State {
+	/** Results of the worker tasks, not reported yet */
+	std::vector<std::pair<int, GameInfo>> results;
+	/** Set when the scanner is destroyed, remaining tasks do nothing */
+	bool cancelled = false;
+};
+
+namespace {
+	struct CacheEntry {
+		int64_t mtime = -1;
+		GameScanner::GameInfo info;
+	};
+
+	// Key is the full path of the entry
+	std::unordered_map<std::string, CacheEntry> cache;
+
+	// Guards the cache and the scanner states
+#ifdef HAVE_THREADS
+	std::mutex mutex;
+
+	std::unique_lock<std::mutex> Lock() {
+		return std::unique_lock<std::mutex>(mutex);
+	}
+#else
+	struct NoLock {
+		~NoLock() {}
+	};
+
+	NoLock Lock() {
+		return {};
+	}
+#endif
+
+	bool FindCached(const std::string& path, int64_t mtime, GameScanner::GameInfo& info) {
+		if (mtime < 0) {
+			return false;
+		}
+
+		auto lk = Lock();
+		auto it = cache.find(path);
+		if (it == cache.end() || it->second.mtime != mtime) {
+			return false;
+		}
+		info = it->second.info;
+		return true;
+	}
+
+	void StoreCached(const std::string& path, int64_t mtime, const GameScanner::GameInfo& info) {
+		if (mtime < 0) {
+			return;
+		}
+
+		auto lk = Lock();
+		cache[path] = { mtime, info };
+	}
+
+	/**
+	 * Only directories of the native filesystem can be opened a second time
+	 * by a worker without touching the filesystem of the caller.
+	 *
+	 * @return full path of the directory or empty when not native
+	 */
+	std::string GetNativePath(const FilesystemView& fs) {
+		if (fs.GetOwner().GetParent()) {
+			// Inside an archive
+			return {};
+		}
+
+		std::string path = FileFinder::GetFullFilesystemPath(fs);
+		if (path.empty() || !Platform::File(path).IsDirectory(true)) {
+			return {};
+		}
+		return path;
+	}
+}
+
+GameScanner::GameScanner(FilesystemView base, std::vector<std::string> entries) :
+	base(std::move(base)), entries(std::move(entries)), state(std::make_shared<State>()) {
+
+	std::string base_path;
+	if (WorkerPool::GetNumWorkers() > 0) {
+		base_path = GetNativePath(this->base);
+	}
+
+	for (int i = 0; i < static_cast<int>(this->entries.size()); ++i) {
+		if (base_path.empty()) {
+			inline_entries.push_back(i);
+			continue;
+		}
+
+		WorkerPool::Submit([state = state, i, path = FileFinder::MakePath(base_path, this->entries[i])]() {
+			{
+				auto lk = Lock();
+				if (state->cancelled) {
+					return;
+				}
+			}
+
+			GameInfo info;
+			int64_t mtime = Platform::File(path).GetModificationTime();
+			if (!FindCached(path, mtime, info)) {
+				auto fs = std::make_shared<NativeFilesystem>("", FilesystemView());
+				info = Probe(fs->Create(path));
+				StoreCached(path, mtime, info);
+			}
+
+			auto lk = Lock();
+			state->results.emplace_back(i, std::move(info));
+		});
+	}
+
+	// Probed from the end because the entries are taken from the back
+	std::reverse(inline_entries.begin(), inline_entries.end());
+}
+
+GameScanner::~GameScanner() {
+	auto lk = Lock();
+	state->cancelled = true;
+}
+
+bool GameScanner::Update(const std::function<void(int, const GameInfo&)>& on_result) {
+	std::vector<std::pair<int, GameInfo>> results;
+	{
+		auto lk = Lock();
+		results.swap(state->results);
+	}
+
+	if (!inline_entries.empty()) {
+		int i = inline_entries.back();
+		inline_entries.pop_back();
+
+		std::string path = FileFinder::MakePath(FileFinder::GetFullFilesystemPath(base), entries[i]);
+		int64_t mtime = base.GetModificationTime(entries[i]);
+
+		GameInfo info;
+		if (!FindCached(path, mtime, info)) {
+			info = Probe(base.Create(entries[i]));
+			StoreCached(path, mtime, info);
+		}
+		results.emplace_back(i, std::move(info));
+	}
+
+	for (const auto& result : results) {
+		on_result(result.first, result.second);
+	}
+	reported += results.size();
+
+	return reported >= entries.size();
+}
+
+GameScanner::GameInfo GameScanner::Probe(FilesystemView fs) {
+	GameInfo info;
+	info.status = GameInfo::Status::NoGame;
+
+	if (!fs) {
+		return info;
+	}
+
+	if (!FileFinder::IsValidProject(fs) && !FileFinder::OpenViewToEasyRpgFile(fs)) {
+		return info;
+	}
+
+	info.status = GameInfo::Status::Game;
+
+	auto ini_stream = fs.OpenInputStream(fs.FindFile(INI_NAME), std::ios_base::in);
+	if (ini_stream) {
+		lcf::INIReader ini(ini_stream);
+		if (ini.ParseError() != -1) {
+			std::string title = ini.Get("RPG_RT", "GameTitle", "");
+			// The encoding of the database is unknown here, guess from the title
+			std::vector<std::string> encodings = lcf::ReaderUtil::DetectEncodings(title);
+			if (!encodings.empty()) {
+				title = lcf::ReaderUtil::Recode(title, encodings.front());
+			}
+			info.title = std::move(title);
+		}
+	}
+
+#ifndef EMSCRIPTEN
+	auto exe_stream = fs.OpenFile(EXE_NAME);
+	if (exe_stream) {
+		EXEReader exe_reader(std::move(exe_stream));
+		bool is_patch_maniac;
+		info.engine = exe_reader.GetFileInfo().GetEngineType(is_patch_maniac);
+	}
+#endif
+
+	return info;
+}
+
+void GameScanner::ClearCache() {
+	auto lk = Lock();
+	cache.clear();
+}
@@ -0,0 +1,102 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_GAME_SCANNER_H
+#define EP_GAME_SCANNER_H
+
+// Headers
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "filesystem.h"
+
+/**
+ * Probes the entries of a directory for games without blocking the caller.
+ *
+ * Entries on the native filesystem are probed by the worker pool. Every task
+ * uses a filesystem instance of its own because filesystems are not
+ * thread-safe. All other entries (e.g. archives inside archives or Android
+ * content providers) are probed on the main thread, one entry per Update.
+ *
+ * The results are cached by full path and modification time of the entry.
+ */
+class GameScanner {
+public:
+	struct GameInfo {
+		enum class Status {
+			/** Not probed yet */
+			Pending,
+			/** No game: A directory or an archive with other content */
+			NoGame,
+			/** Contains a game that can be started */
+			Game
+		};
+
+		Status status = Status::Pending;
+		/** GameTitle of the RPG_RT.ini, empty when missing */
+		std::string title;
+		/** Player::EngineType detected from the RPG_RT.exe */
+		int engine = 0;
+	};
+
+	/**
+	 * Starts probing the entries.
+	 *
+	 * @param base directory containing the entries
+	 * @param entries names of directories and archives in base
+	 */
+	GameScanner(FilesystemView base, std::vector<std::string> entries);
+
+	/** Discards results of tasks that did not finish yet. */
+	~GameScanner();
+
+	GameScanner(const GameScanner&) = delete;
+	GameScanner& operator=(const GameScanner&) = delete;
+
+	/**
+	 * Reports entries which were probed since the last call.
+	 * Must be called from the main thread.
+	 *
+	 * @param on_result invoked with the index of the entry and the result
+	 * @return true when all entries were reported
+	 */
+	bool Update(const std::function<void(int, const GameInfo&)>& on_result);
+
+	/**
+	 * Probes a filesystem for a game. Blocks until done.
+	 *
+	 * @param fs filesystem to check
+	 * @return information about the game
+	 */
+	static GameInfo Probe(FilesystemView fs);
+
+	/** Removes all cached results. */
+	static void ClearCache();
+
+private:
+	struct State;
+
+	FilesystemView base;
+	std::vector<std::string> entries;
+	/** Entries the main thread must probe itself */
+	std::vector<int> inline_entries;
+	std::shared_ptr<State> state;
+	size_t reported = 0;
+};
+
+#endif
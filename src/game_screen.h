@@ -65,6 +65,9 @@ public:
 	 */
 	Tone GetTone();
 
+	/** @return Whether a Tint Screen command is still changing the tone */
+	bool IsTintFading() const;
+
 	/**
 	 * Returns the current flash color.
 	 *
@@ -243,6 +246,10 @@ inline Tone Game_Screen::GetTone() {
 		(int)((data.tint_current_sat) * 128 / 100));
 }
 
+inline bool Game_Screen::IsTintFading() const {
+	return data.tint_time_left > 0;
+}
+
 inline Color Game_Screen::GetFlashColor() const {
 	return Flash::MakeColor(data.flash_red, data.flash_green, data.flash_blue, data.flash_current_level);
 }
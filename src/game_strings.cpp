@@ -16,6 +16,7 @@
  */
 
  // Headers
+#include <algorithm>
 #include <regex>
 #include <lcf/encoder.h>
 #include "async_handler.h"
@@ -26,6 +27,7 @@
 #include "game_variables.h"
 #include "output.h"
 #include "player.h"
+#include "regex_cache.h"
 #include "utils.h"
 
 void Game_Strings::WarnGet(int id) const {
@@ -43,13 +45,13 @@ StringView Game_Strings::Cat(Str_Params params, StringView string) {
 		return {};
 	}
 
-	auto it = _strings.find(params.string_id);
-	if (it == _strings.end()) {
+	auto* var = Find(params.string_id);
+	if (var == nullptr) {
 		Set(params, string);
 		return Get(params.string_id);
 	}
-	it->second += ToString(string);
-	return it->second;
+	var->data += ToString(string);
+	return var->View();
 }
 
 int Game_Strings::ToNum(Str_Params params, int var_id, Game_Variables& variables) {
@@ -57,16 +59,17 @@ int Game_Strings::ToNum(Str_Params params, int var_id, Game_Variables& variables
 		return -1;
 	}
 
-	auto it = _strings.find(params.string_id);
-	if (it == _strings.end()) {
+	auto* var = Find(params.string_id);
+	if (var == nullptr) {
 		return 0;
 	}
 
+	const char* str = var->data.c_str() + var->begin;
 	int num;
 	if (params.hex)
-		num = static_cast<int>(std::strtol(it->second.c_str(), nullptr, 16));
+		num = static_cast<int>(std::strtol(str, nullptr, 16));
 	else
-		num = static_cast<int>(std::strtol(it->second.c_str(), nullptr, 0));
+		num = static_cast<int>(std::strtol(str, nullptr, 0));
 
 	variables.Set(var_id, num);
 	Game_Map::SetNeedRefresh(true);
@@ -134,14 +137,14 @@ int Game_Strings::Split(Str_Params params, const std::string& delimiter, int str
 			// token not found -> 1 split
 			splits = 1;
 		} else {
-			std::string token;
-			for (auto index = str.find(delimiter); index != std::string::npos; index = str.find(delimiter)) {
-				token = str.substr(0, index);
-				Set(params, token);
+			size_t pos = 0;
+			for (auto index = str.find(delimiter); index != std::string::npos; index = str.find(delimiter, pos)) {
+				Set(params, StringView(str).substr(pos, index - pos));
 				params.string_id++;
 				splits++;
-				str.erase(0, index + delimiter.length());
+				pos = index + delimiter.length();
 			}
+			str.erase(0, pos);
 		}
 	}
 
@@ -230,14 +233,39 @@ StringView Game_Strings::PopLine(Str_Params params, int offset, int string_out_i
 
 	std::string result;
 	StringView str = Get(params.string_id);
+	size_t pos = 0;
 
-	std::stringstream ss(ToString(str));
+	// Same line splitting as Utils::ReadLine
+	while (offset >= 0) {
+		if (pos >= str.size()) {
+			result.clear();
+			break;
+		}
 
-	while (offset >= 0 && Utils::ReadLine(ss, result)) { offset--; }
+		auto end = str.find_first_of("\r\n", pos);
+		if (end == StringView::npos) {
+			end = str.size();
+		}
+		result = ToString(str.substr(pos, end - pos));
 
-	offset = ss.rdbuf()->in_avail();
+		pos = end + 1;
+		if (end < str.size() && str[end] == '\r' && pos < str.size() && str[pos] == '\n') {
+			++pos;
+		}
+		pos = std::min(pos, str.size());
+		offset--;
+	}
 
-	Set(params, ss.str().substr(str.length() - offset));
+	if (params.extract) {
+		Set(params, str.substr(pos));
+	} else if (auto* var = Find(params.string_id)) {
+		// Skip the popped lines without copying the remaining text
+		var->begin += pos;
+		if (var->begin > var->data.size() - var->begin) {
+			var->data.erase(0, var->begin);
+			var->begin = 0;
+		}
+	}
 
 	params.string_id = string_out_id;
 	Set(params, result);
@@ -254,9 +282,12 @@ StringView Game_Strings::ExMatch(Str_Params params, std::string expr, int var_id
 	}
 
 	std::string base = ToString(Get(params.string_id)).erase(0, begin);
-	std::regex r(expr);
+	auto r = RegexCache::Get(expr);
+	if (!r) {
+		return {};
+	}
 
-	std::regex_search(base, match, r);
+	std::regex_search(base, match, *r);
 
 	var_result = match.position() + begin;
 	variables.Set(var_id, var_result);
@@ -270,14 +301,14 @@ StringView Game_Strings::ExMatch(Str_Params params, std::string expr, int var_id
 	return str_result;
 }
 
-const Game_Strings::Strings_t& Game_Strings::RangeOp(Str_Params params, int string_id_1, std::string string, int op, int args[], Game_Variables& variables) {
+void Game_Strings::RangeOp(Str_Params params, int string_id_1, std::string string, int op, int args[], Game_Variables& variables) {
 	if (EP_UNLIKELY(ShouldWarn(params.string_id))) {
 		WarnGet(params.string_id);
 	}
 	if (EP_UNLIKELY(ShouldWarn(string_id_1))) {
 		WarnGet(string_id_1);
 	}
-	if (params.string_id <= 0 && string_id_1 <= 0) { return GetData(); }
+	if (params.string_id <= 0 && string_id_1 <= 0) { return; }
 
 	// maniacs just ignores if only one of the params is <= 0
 	if (params.string_id <= 0) { params.string_id = 1; }
@@ -301,7 +332,6 @@ const Game_Strings::Strings_t& Game_Strings::RangeOp(Str_Params params, int stri
 		case 10: ExMatch(params, string, args[1] + (params.string_id - start), args[2], args[3], variables); break;
 		}
 	}
-	return GetData();
 }
 
 std::string Game_Strings::PrependMin(StringView string, int min_size, char c) {
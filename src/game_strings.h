@@ -18,6 +18,8 @@
  // Headers
 #include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <lcf/data.h>
 #include "compiler.h"
 #include "game_variables.h"
@@ -32,11 +34,12 @@
  */
 class Game_Strings {
 public:
-	using Strings_t = std::unordered_map<int, std::string>;
-
 	// currently only warns when ID <= 0
 	static constexpr int max_warnings = 10;
 
+	// Ids up to this value are stored contiguously, higher ids in a hash map
+	static constexpr int max_dense_id = 65536;
+
 	struct Str_Params {
 		int string_id = 0, hex = 0, extract = 0;
 	};
@@ -49,9 +52,7 @@ public:
 
 	Game_Strings() = default;
 
-	void SetData(Strings_t s);
 	void SetData(const std::vector<lcf::DBString>& s);
-	const Strings_t& GetData() const;
 	std::vector<lcf::DBString> GetLcfData() const;
 
 	StringView Get(int id) const;
@@ -70,7 +71,7 @@ public:
 	StringView PopLine(Str_Params params, int offset, int string_out_id);
 	StringView ExMatch(Str_Params params, std::string expr, int var_id, int begin, int string_out_id, Game_Variables& variables);
 
-	const Strings_t& RangeOp(Str_Params params, int string_id_1, std::string string, int op, int args[], Game_Variables& variables);
+	void RangeOp(Str_Params params, int string_id_1, std::string string, int op, int args[], Game_Variables& variables);
 
 	static std::string PrependMin(StringView string, int min_size, char c);
 	static std::string Extract(StringView string, bool as_hex);
@@ -79,11 +80,30 @@ public:
 	static std::optional<std::string> ManiacsCommandInserterHex(char ch, const char** iter, const char* end, uint32_t escape_char);
 
 private:
+	/**
+	 * Content of a string variable.
+	 * Lines removed by PopLine are only skipped, the storage is compacted
+	 * when most of it was popped. This makes reading a file line by line linear.
+	 */
+	struct Str_Var {
+		std::string data;
+		/** Start of the value in data */
+		size_t begin = 0;
+		/** False when the variable was never assigned */
+		bool exists = false;
+
+		StringView View() const;
+	};
+
 	void Set(Str_Params params, StringView string);
+	Str_Var* Find(int id);
+	const Str_Var* Find(int id) const;
+	Str_Var& Insert(int id);
 	bool ShouldWarn(int id) const;
 	void WarnGet(int id) const;
 
-	Strings_t _strings;
+	std::vector<Str_Var> _strings;
+	std::unordered_map<int, Str_Var> _sparse_strings;
 	mutable int _warnings = max_warnings;
 };
 
@@ -98,45 +118,84 @@ inline void Game_Strings::Set(Str_Params params, StringView string) {
 		ins_string = Extract(ins_string, params.hex);
 	}
 
-	auto it = _strings.find(params.string_id);
-	if (it == _strings.end()) {
+	auto* var = Find(params.string_id);
+	if (var == nullptr) {
 		if (ins_string.empty()) {
 			return;
-		} else {
-			_strings[params.string_id] = ins_string;
 		}
-	} else {
-		it->second = ins_string;
+		var = &Insert(params.string_id);
 	}
+	var->data = std::move(ins_string);
+	var->begin = 0;
+}
+
+inline StringView Game_Strings::Str_Var::View() const {
+	return StringView(data).substr(begin);
+}
+
+inline Game_Strings::Str_Var* Game_Strings::Find(int id) {
+	return const_cast<Str_Var*>(static_cast<const Game_Strings*>(this)->Find(id));
 }
 
-inline void Game_Strings::SetData(Strings_t s) {
-	_strings = std::move(s);
+inline const Game_Strings::Str_Var* Game_Strings::Find(int id) const {
+	const Str_Var* var = nullptr;
+	if (id > 0 && id <= static_cast<int>(_strings.size())) {
+		var = &_strings[id - 1];
+	} else if (id > max_dense_id) {
+		auto it = _sparse_strings.find(id);
+		if (it != _sparse_strings.end()) {
+			var = &it->second;
+		}
+	}
+	return var && var->exists ? var : nullptr;
+}
+
+inline Game_Strings::Str_Var& Game_Strings::Insert(int id) {
+	assert(id > 0);
+	Str_Var* var;
+	if (id <= max_dense_id) {
+		if (id > static_cast<int>(_strings.size())) {
+			_strings.resize(id);
+		}
+		var = &_strings[id - 1];
+	} else {
+		var = &_sparse_strings[id];
+	}
+	var->exists = true;
+	return *var;
 }
 
 inline void Game_Strings::SetData(const std::vector<lcf::DBString>& s) {
 	int i = 1;
 	for (const auto& string: s) {
 		if (!s.empty()) {
-			_strings[i] = ToString(string);
+			auto& var = Insert(i);
+			var.data = ToString(string);
+			var.begin = 0;
 		}
 		++i;
 	}
 }
 
-inline const Game_Strings::Strings_t& Game_Strings::GetData() const {
-	return _strings;
-}
-
 inline std::vector<lcf::DBString> Game_Strings::GetLcfData() const {
 	std::vector<lcf::DBString> lcf_data;
 
-	for (auto& [index, value]: _strings) {
+	auto add = [&](int index, const Str_Var& var) {
 		assert(index > 0);
+		if (!var.exists) {
+			return;
+		}
 		if (index >= static_cast<int>(lcf_data.size())) {
 			lcf_data.resize(index + 1);
 		}
-		lcf_data[index - 1] = lcf::DBString(value);
+		lcf_data[index - 1] = lcf::DBString(ToString(var.View()));
+	};
+
+	for (int i = 0; i < static_cast<int>(_strings.size()); ++i) {
+		add(i + 1, _strings[i]);
+	}
+	for (auto& [index, var]: _sparse_strings) {
+		add(index, var);
 	}
 
 	return lcf_data;
@@ -150,11 +209,11 @@ inline StringView Game_Strings::Get(int id) const {
 	if (EP_UNLIKELY(ShouldWarn(id))) {
 		WarnGet(id);
 	}
-	auto it = _strings.find(id);
-	if (it == _strings.end()) {
+	auto* var = Find(id);
+	if (var == nullptr) {
 		return {};
 	}
-	return it->second;
+	return var->View();
 }
 
 inline StringView Game_Strings::GetIndirect(int id, const Game_Variables& variables) const {
@@ -27,6 +27,8 @@
 #include "output.h"
 #include "player.h"
 
+#include <algorithm>
+
 static std::optional<std::string> CommandCodeInserter(char ch, const char **iter, const char *end, uint32_t escape_char) {
 	if ((ch == 'T' || ch == 't') && Player::IsPatchManiac()) {
 		auto parse_ret = Game_Message::ParseString(*iter, end, escape_char, true);
@@ -40,6 +42,29 @@ static std::optional<std::string> CommandCodeInserter(char ch, const char **iter
 	return PendingMessage::DefaultCommandInserter(ch, iter, end, escape_char);
 }
 
+static bool IsSameFont(const lcf::rpg::SaveEasyRpgText& l, const lcf::rpg::SaveEasyRpgText& r) {
+	return l.font_name == r.font_name && l.font_size == r.font_size &&
+		l.flags.bold == r.flags.bold && l.flags.italic == r.flags.italic;
+}
+
+// Area of the contents covered by a text. The margin covers glyphs which
+// are larger than the font size, ExFont glyphs and shadows.
+static Rect GetTextRect(const lcf::rpg::SaveEasyRpgText& text, const std::vector<std::string>& lines, int width) {
+	int num_lines = 0;
+	for (const auto& line: lines) {
+		num_lines += 1 + static_cast<int>(std::count(line.begin(), line.end(), '\n'));
+	}
+	num_lines = std::max(num_lines, 1);
+
+	const int first_y = text.position_y + 2;
+	const int last_y = first_y + (num_lines - 1) * (text.font_size + text.line_spacing);
+	const int margin = std::max(text.font_size, 12);
+	const int top = std::min(first_y, last_y) - margin;
+	const int bottom = std::max(first_y, last_y) + margin * 2;
+
+	return { 0, top, width, bottom - top };
+}
+
 Game_Windows::Window_User::Window_User(lcf::rpg::SaveEasyRpgWindow save)
 	: data(std::move(save))
 {
@@ -173,13 +198,17 @@ void Game_Windows::Window_User::Refresh(bool& async_wait) {
 	std::vector<PendingMessage> messages;
 
 	// Preprocessing
-	for (const auto& text: data.texts) {
+	for (size_t i = 0; i < data.texts.size(); ++i) {
+		const auto& text = data.texts[i];
 		FontRef font;
 
 		Filesystem_Stream::InputStream font_file;
 		std::string font_name = ToString(text.font_name);
 
-		if (!font_name.empty()) {
+		if (i < drawn_texts.size() && IsSameFont(drawn_texts[i].text, text)) {
+			// Opening a font file is expensive
+			font = drawn_texts[i].font;
+		} else if (!font_name.empty()) {
 			// Try to find best fitting font
 			if (text.flags.bold && text.flags.italic) {
 				font_file = FileFinder::OpenFont(font_name + "-BoldItalic");
@@ -345,15 +374,6 @@ void Game_Windows::Window_User::Refresh(bool& async_wait) {
 		}
 	}
 
-	window = std::make_unique<Window_Selectable>(0, 0, data.width, data.height);
-	if (!data.flags.border_margin) {
-		window->SetBorderX(0);
-		// FIXME: Figure out why 0 does not work here (bug in Window class)
-		window->SetBorderY(-3);
-	}
-	window->CreateContents();
-	window->SetVisible(false);
-
 	BitmapRef system;
 	// FIXME: Transparency setting is currently not applied to the system graphic
 	// Disabling transparency breaks the rendering of the system graphic
@@ -363,19 +383,63 @@ void Game_Windows::Window_User::Refresh(bool& async_wait) {
 		system = Cache::SystemOrBlack();
 	}
 
-	window->SetWindowskin(system);
-	window->SetStretch(data.message_stretch == lcf::rpg::System::Stretch_stretch);
+	const bool reuse_window = window && window->GetContents() &&
+		IsSameWindow(drawn_window, drawn_system, data, system);
+
+	if (!reuse_window) {
+		window = std::make_unique<Window_Selectable>(0, 0, data.width, data.height);
+		if (!data.flags.border_margin) {
+			window->SetBorderX(0);
+			// FIXME: Figure out why 0 does not work here (bug in Window class)
+			window->SetBorderY(-3);
+		}
+		window->CreateContents();
+		window->SetVisible(false);
+
+		window->SetWindowskin(system);
+		window->SetStretch(data.message_stretch == lcf::rpg::System::Stretch_stretch);
+
+		if (data.message_stretch == lcf::rpg::System::Stretch_easyrpg_none) {
+			window->SetBackOpacity(0);
+		}
+
+		if (!data.flags.draw_frame) {
+			window->SetFrameOpacity(0);
+		}
+
+		drawn_texts.clear();
+	}
+
+	drawn_window = data;
+	drawn_window.texts.clear();
+	drawn_system = system;
 
-	if (data.message_stretch == lcf::rpg::System::Stretch_easyrpg_none) {
-		window->SetBackOpacity(0);
+	// Only texts which changed are redrawn. Their old and new area is
+	// cleared and all other texts in these areas are redrawn as well.
+	auto& contents = *window->GetContents();
+	std::vector<DrawnText> texts;
+	for (size_t i = 0; i < data.texts.size(); ++i) {
+		const auto& lines = messages[i].GetLines();
+		texts.push_back({ data.texts[i], lines, fonts[i], GetTextRect(data.texts[i], lines, contents.width()) });
 	}
 
-	if (!data.flags.draw_frame) {
-		window->SetFrameOpacity(0);
+	std::vector<Rect> cleared;
+	const auto dirty = FindDirtyTexts(drawn_texts, texts, cleared);
+
+	if (reuse_window) {
+		for (const auto& rect: cleared) {
+			contents.ClearRect(rect);
+		}
 	}
 
+	drawn_texts = std::move(texts);
+
 	// Draw text
 	for (size_t i = 0; i < data.texts.size(); ++i) {
+		if (!dirty[i]) {
+			continue;
+		}
+
 		auto& font = fonts[i];
 		const auto& pm = messages[i];
 		const auto& text = data.texts[i];
@@ -459,6 +523,54 @@ void Game_Windows::Window_User::Refresh(bool& async_wait) {
 	pic.AttachWindow(*window);
 }
 
+bool Game_Windows::Window_User::IsSameWindow(const lcf::rpg::SaveEasyRpgWindow& drawn, const BitmapRef& drawn_system,
+		const lcf::rpg::SaveEasyRpgWindow& data, const BitmapRef& system) {
+	return drawn.width == data.width && drawn.height == data.height &&
+		drawn_system == system &&
+		drawn.message_stretch == data.message_stretch &&
+		drawn.flags.draw_frame == data.flags.draw_frame &&
+		drawn.flags.border_margin == data.flags.border_margin;
+}
+
+std::vector<bool> Game_Windows::Window_User::FindDirtyTexts(const std::vector<DrawnText>& drawn,
+		const std::vector<DrawnText>& texts, std::vector<Rect>& cleared) {
+	std::vector<bool> dirty(texts.size(), false);
+
+	for (size_t i = 0; i < texts.size(); ++i) {
+		const auto& text = texts[i];
+		if (i < drawn.size()) {
+			const auto& old = drawn[i];
+			if (old.text == text.text && old.lines == text.lines && old.font == text.font) {
+				continue;
+			}
+			cleared.push_back(old.rect);
+		}
+		cleared.push_back(text.rect);
+		dirty[i] = true;
+	}
+
+	for (size_t i = texts.size(); i < drawn.size(); ++i) {
+		cleared.push_back(drawn[i].rect);
+	}
+
+	for (bool changed = true; changed;) {
+		changed = false;
+		for (size_t i = 0; i < texts.size(); ++i) {
+			if (dirty[i]) {
+				continue;
+			}
+			const Rect& rect = texts[i].rect;
+			if (std::any_of(cleared.begin(), cleared.end(), [&](const Rect& r) { return !rect.IsOutOfBounds(r); })) {
+				cleared.push_back(rect);
+				dirty[i] = true;
+				changed = true;
+			}
+		}
+	}
+
+	return dirty;
+}
+
 bool Game_Windows::Window_User::Request() {
 	if (!request_ids.empty()) {
 		return true;
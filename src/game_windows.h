@@ -23,7 +23,9 @@
 #include <deque>
 #include <lcf/rpg/saveeasyrpgwindow.h>
 #include <lcf/rpg/system.h>
+#include "font.h"
 #include "game_pictures.h"
+#include "rect.h"
 #include "window_selectable.h"
 
 /*
@@ -91,6 +93,50 @@ public:
 
 		std::unique_ptr<Window_Selectable> window;
 		std::vector<FileRequestBinding> request_ids;
+
+		/** A text as it was drawn into the contents of the window */
+		struct DrawnText {
+			lcf::rpg::SaveEasyRpgText text;
+			/** Lines after processing the message codes */
+			std::vector<std::string> lines;
+			FontRef font;
+			/** Area of the contents covered by the text */
+			Rect rect;
+		};
+
+		/**
+		 * Compares the settings of a window which affect the window itself
+		 * and not only the texts.
+		 *
+		 * @param drawn settings the window was created with
+		 * @param drawn_system system graphic the window was created with
+		 * @param data new settings
+		 * @param system new system graphic
+		 * @return true when the window can be reused for the new settings
+		 */
+		static bool IsSameWindow(const lcf::rpg::SaveEasyRpgWindow& drawn, const BitmapRef& drawn_system,
+			const lcf::rpg::SaveEasyRpgWindow& data, const BitmapRef& system);
+
+		/**
+		 * Determines the texts which must be redrawn. These are the texts which
+		 * changed and all texts overlapping an area which is cleared.
+		 *
+		 * @param drawn texts currently drawn into the window
+		 * @param texts new texts
+		 * @param cleared filled with the areas of the contents to clear
+		 * @return for each new text whether it must be drawn
+		 */
+		static std::vector<bool> FindDirtyTexts(const std::vector<DrawnText>& drawn,
+			const std::vector<DrawnText>& texts, std::vector<Rect>& cleared);
+
+		/**
+		 * Settings and texts of the current window. When the settings did not
+		 * change the window is reused and only changed texts are redrawn.
+		 */
+		lcf::rpg::SaveEasyRpgWindow drawn_window;
+		std::vector<DrawnText> drawn_texts;
+		/** System graphic of the window, an empty system name follows the current system graphic */
+		BitmapRef drawn_system;
 	};
 
 	Window_User& GetWindow(int id);
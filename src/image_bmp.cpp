@@ -141,48 +141,35 @@ bool ImageBMP::Read(const uint8_t* data, unsigned len, bool transparent, ImageOu
 	int line_width = (hdr.depth == 4) ? (hdr.w + 1) >> 1 : hdr.w;
 	int padding = (-line_width)&3;
 
-	output.pixels = malloc(hdr.w * hdr.h * 4);
-	if (!output.pixels) {
+	if (!output.Allocate(hdr.w, hdr.h)) {
 		Output::Warning("Error allocating BMP pixel buffer.");
 		return false;
 	}
 
-	uint8_t* dst = (uint8_t*) output.pixels;
+	for (int i = 0; i < hdr.num_colors; i++) {
+		auto* color = get_palette(i);
+		output.SetPaletteColor(i, color[2], color[1], color[0], (transparent && i == 0) ? 0 : 255);
+	}
+
+	std::vector<uint8_t> row(hdr.w);
 	for (int y = 0; y < hdr.h; y++) {
 		const uint8_t* src = src_pixels + (vflip ? hdr.h - 1 - y : y) * (line_width + padding);
+		if (hdr.depth == 8) {
+			output.WriteIndexed(y, src);
+			continue;
+		}
+
+		// split up packed pixels
 		for (int x = 0; x < hdr.w; x += 2) {
 			uint8_t pix = *src++;
-			uint8_t pix2 = 0;
-			const uint8_t* color;
-
-			// split up packed pixel
-			if (hdr.depth == 4) {
-				pix2 = pix & 15;
-				pix >>= 4;
+			row[x] = pix >> 4;
+			if (x + 1 < hdr.w) {
+				row[x + 1] = pix & 15;
 			}
-
-			color = get_palette(pix);
-			*dst++ = color[2];
-			*dst++ = color[1];
-			*dst++ = color[0];
-			*dst++ = (transparent && pix == 0) ? 0 : 255;
-
-			// end of line
-			if (x + 1 == hdr.w)
-				break;
-
-			pix = (hdr.depth == 8) ? *src++ : pix2;
-
-			color = get_palette(pix);
-			*dst++ = color[2];
-			*dst++ = color[1];
-			*dst++ = color[0];
-			*dst++ = (transparent && pix == 0) ? 0 : 255;
 		}
+		output.WriteIndexed(y, row.data());
 	}
 
-	output.width = hdr.w;
-	output.height = hdr.h;
 	output.bpp = hdr.depth; // Currently only 4 and 8 bit (indexed) are supported
 	return true;
 }
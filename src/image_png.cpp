@@ -48,11 +48,12 @@ static void on_png_error(png_structp, png_const_charp error_msg) {
 }
 
 static bool ReadPNGWithReadFunction(png_voidp,png_rw_ptr, bool, ImageOut&);
-static void ReadPalettedData(png_struct*, png_info*, png_uint_32, png_uint_32, bool, uint32_t*);
-static void ReadGrayData(png_struct*, png_info*, png_uint_32, png_uint_32, bool, uint32_t*);
-static void ReadGrayAlphaData(png_struct*, png_info*, png_uint_32, png_uint_32, uint32_t*);
-static void ReadRGBData(png_struct*, png_info*, png_uint_32, png_uint_32, uint32_t*);
-static void ReadRGBAData(png_struct*, png_info*, png_uint_32, png_uint_32, uint32_t*);
+static void ReadPalettedData(png_struct*, png_info*, png_uint_32, png_uint_32, bool, std::vector<uint8_t>&, ImageOut&);
+static void ReadGrayData(png_struct*, png_info*, png_uint_32, png_uint_32, bool, std::vector<uint8_t>&, ImageOut&);
+static void ReadGrayAlphaData(png_struct*, png_info*, png_uint_32, png_uint_32, std::vector<uint8_t>&, ImageOut&);
+static void ReadRGBData(png_struct*, png_info*, png_uint_32, png_uint_32, std::vector<uint8_t>&, ImageOut&);
+static void ReadRGBAData(png_struct*, png_info*, png_uint_32, png_uint_32, std::vector<uint8_t>&, ImageOut&);
+static void ReadRGBARows(png_struct*, png_uint_32, png_uint_32, std::vector<uint8_t>&, ImageOut&);
 
 bool ImagePNG::Read(const void* buffer, bool transparent, ImageOut& output) {
 	return ReadPNGWithReadFunction((png_voidp)&buffer, read_data, transparent, output);
@@ -77,6 +78,10 @@ static bool ReadPNGWithReadFunction(png_voidp user_data, png_rw_ptr fn, bool tra
 		return false;
 	}
 
+	// Rows are decoded into this buffer and then written to the output.
+	// Declared before setjmp, the longjmp of libpng skips destructors.
+	std::vector<uint8_t> row;
+
 	if (setjmp(png_jmpbuf(png_ptr))) {
 		png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
 		return false;
@@ -91,31 +96,31 @@ static bool ReadPNGWithReadFunction(png_voidp user_data, png_rw_ptr fn, bool tra
 	png_get_IHDR(png_ptr, info_ptr, &w, &h,
 				 &bit_depth, &color_type, NULL, NULL, NULL);
 
-	output.pixels = malloc(w * h * 4);
-	if (!output.pixels) {
+	if (!output.Allocate(w, h)) {
+		png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
 		Output::Warning("Error allocating PNG pixel buffer.");
 		return false;
 	}
 
 	switch (color_type) {
 		case PNG_COLOR_TYPE_PALETTE:
-			ReadPalettedData(png_ptr, info_ptr, w, h, transparent, (uint32_t*)output.pixels);
+			ReadPalettedData(png_ptr, info_ptr, w, h, transparent, row, output);
 			output.bpp = 8;
 			break;
 		case PNG_COLOR_TYPE_GRAY:
-			ReadGrayData(png_ptr, info_ptr, w, h, transparent, (uint32_t*)output.pixels);
+			ReadGrayData(png_ptr, info_ptr, w, h, transparent, row, output);
 			output.bpp = 8;
 			break;
 		case PNG_COLOR_TYPE_GRAY_ALPHA:
-			ReadGrayAlphaData(png_ptr, info_ptr, w, h, (uint32_t*)output.pixels);
+			ReadGrayAlphaData(png_ptr, info_ptr, w, h, row, output);
 			output.bpp = 8;
 			break;
 		case PNG_COLOR_TYPE_RGB:
-			ReadRGBData(png_ptr, info_ptr, w, h, (uint32_t*)output.pixels);
+			ReadRGBData(png_ptr, info_ptr, w, h, row, output);
 			output.bpp = 24;
 			break;
 		case PNG_COLOR_TYPE_RGB_ALPHA:
-			ReadRGBAData(png_ptr, info_ptr, w, h, (uint32_t*)output.pixels);
+			ReadRGBAData(png_ptr, info_ptr, w, h, row, output);
 			output.bpp = 32;
 			break;
 	}
@@ -123,8 +128,6 @@ static bool ReadPNGWithReadFunction(png_voidp user_data, png_rw_ptr fn, bool tra
 	png_read_end(png_ptr, NULL);
 	png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
 
-	output.width = w;
-	output.height = h;
 	return true;
 }
 
@@ -132,7 +135,8 @@ static void ReadPalettedData(
 	png_struct* png_ptr, png_info* info_ptr,
 	png_uint_32 w, png_uint_32 h,
 	bool transparent,
-	uint32_t* pixels
+	std::vector<uint8_t>& row,
+	ImageOut& output
 ) {
 	// For transparent images, all the colors are opaque, except the
 	// color with index 0. So we'll need to do index->RGB conversion
@@ -149,26 +153,15 @@ static void ReadPalettedData(
 	int num_palette;
 	png_get_PLTE(png_ptr, info_ptr, &palette, &num_palette);
 
+	for (int i = 0; i < num_palette; i++) {
+		png_color& color = palette[i];
+		output.SetPaletteColor(i, color.red, color.green, color.blue, (i == 0 && transparent) ? 0 : 255);
+	}
+
+	row.resize(w);
 	for (png_uint_32 y = 0; y < h; y++) {
-		// We read the indices (w bytes) into the end of the pixel
-		// data for this row (4w bytes), then scan over them
-		// converting them into RGBA values. Putting them at the end
-		// gives us enough room that we don't overwrite an index
-		// we'll need later with an RGBA value.
-
-		uint32_t* beginning_of_row = pixels + y * w;
-
-		uint8_t* indices = (uint8_t*)beginning_of_row + w * 3;
-		png_read_row(png_ptr, (png_bytep)indices, NULL);
-
-		uint32_t* dst = beginning_of_row;
-		for (png_uint_32 x = 0; x < w; x++, dst++) {
-			uint8_t idx = indices[x];
-			png_color& color = palette[idx];
-			uint8_t alpha = (idx == 0 && transparent) ? 0 : 255;
-			uint8_t rgba[4] = { color.red, color.green, color.blue, alpha };
-			*dst = *(uint32_t*)rgba;
-		}
+		png_read_row(png_ptr, row.data(), NULL);
+		output.WriteIndexed(y, row.data());
 	}
 }
 
@@ -176,7 +169,8 @@ static void ReadGrayData(
 	png_struct* png_ptr, png_info* info_ptr,
 	png_uint_32 w, png_uint_32 h,
 	bool transparent,
-	uint32_t* pixels
+	std::vector<uint8_t>& row,
+	ImageOut& output
 ) {
 	png_set_strip_16(png_ptr);
 	png_set_expand(png_ptr);
@@ -184,65 +178,76 @@ static void ReadGrayData(
 	png_set_filler(png_ptr, 0xFF, PNG_FILLER_AFTER);
 	png_read_update_info(png_ptr, info_ptr);
 
-	for (png_uint_32 y = 0; y < h; y++) {
-		png_bytep dst = (png_bytep) pixels + y * w * 4;
-		png_read_row(png_ptr, dst, NULL);
+	if (!transparent) {
+		ReadRGBARows(png_ptr, w, h, row, output);
+		return;
 	}
 
 	// Black pixels are transparent
-	if (transparent) {
-		uint8_t ck1[4] = {0, 0, 0, 255};
-		uint8_t ck2[4] = {0, 0, 0,   0};
-		uint32_t srckey = *(uint32_t*)ck1;
-		uint32_t dstkey = *(uint32_t*)ck2;
-		uint32_t* p = (uint32_t*) pixels;
-		for (unsigned i = 0; i < w * h; i++, p++)
+	uint8_t ck1[4] = {0, 0, 0, 255};
+	uint8_t ck2[4] = {0, 0, 0,   0};
+	uint32_t srckey = *(uint32_t*)ck1;
+	uint32_t dstkey = *(uint32_t*)ck2;
+
+	row.resize(w * 4);
+	for (png_uint_32 y = 0; y < h; y++) {
+		png_read_row(png_ptr, row.data(), NULL);
+		uint32_t* p = (uint32_t*) row.data();
+		for (unsigned x = 0; x < w; x++, p++)
 			if (*p == srckey)
 				*p = dstkey;
+		output.WriteRGBA(y, row.data());
 	}
 }
 
 static void ReadGrayAlphaData(
 	png_struct* png_ptr, png_info* info_ptr,
 	png_uint_32 w, png_uint_32 h,
-	uint32_t* pixels
+	std::vector<uint8_t>& row,
+	ImageOut& output
 ) {
 	png_set_strip_16(png_ptr);
 	png_set_gray_to_rgb(png_ptr);
 	png_read_update_info(png_ptr, info_ptr);
 
-	for (png_uint_32 y = 0; y < h; y++) {
-		png_bytep dst = (png_bytep) pixels + y * w * 4;
-		png_read_row(png_ptr, dst, NULL);
-	}
+	ReadRGBARows(png_ptr, w, h, row, output);
 }
 
 static void ReadRGBData(
 	png_struct* png_ptr, png_info* info_ptr,
 	png_uint_32 w, png_uint_32 h,
-	uint32_t* pixels
+	std::vector<uint8_t>& row,
+	ImageOut& output
 ) {
 	png_set_strip_16(png_ptr);
 	png_set_filler(png_ptr, 0xFF, PNG_FILLER_AFTER);
 	png_read_update_info(png_ptr, info_ptr);
 
-	for (png_uint_32 y = 0; y < h; y++) {
-		png_bytep dst = (png_bytep) pixels + y * w * 4;
-		png_read_row(png_ptr, dst, NULL);
-	}
+	ReadRGBARows(png_ptr, w, h, row, output);
 }
 
 static void ReadRGBAData(
 	png_struct* png_ptr, png_info* info_ptr,
 	png_uint_32 w, png_uint_32 h,
-	uint32_t* pixels
+	std::vector<uint8_t>& row,
+	ImageOut& output
 ) {
 	png_set_strip_16(png_ptr);
 	png_read_update_info(png_ptr, info_ptr);
 
+	ReadRGBARows(png_ptr, w, h, row, output);
+}
+
+static void ReadRGBARows(
+	png_struct* png_ptr,
+	png_uint_32 w, png_uint_32 h,
+	std::vector<uint8_t>& row,
+	ImageOut& output
+) {
+	row.resize(w * 4);
 	for (png_uint_32 y = 0; y < h; y++) {
-		png_bytep dst = (png_bytep) pixels + y * w * 4;
-		png_read_row(png_ptr, dst, NULL);
+		png_read_row(png_ptr, row.data(), NULL);
+		output.WriteRGBA(y, row.data());
 	}
 }
 
@@ -34,39 +34,62 @@ bool ImageXYZ::Read(const uint8_t* data, unsigned len, bool transparent, ImageOu
 
 	uint16_t w = data[4] + (data[5] << 8);
 	uint16_t h = data[6] + (data[7] << 8);
-	uLongf src_size = len - 8;
-	Bytef* src_buffer = (Bytef*)&data[8];
-	uLongf dst_size = 768 + (w * h);
-	std::vector<Bytef> dst_buffer(dst_size);
 
-	int status = uncompress(&dst_buffer.front(), &dst_size, src_buffer, src_size);
-	if (status != Z_OK) {
+	// Inflated row by row, the palette followed by the indices of every row
+	z_stream zs = {};
+	zs.next_in = const_cast<Bytef*>(&data[8]);
+	zs.avail_in = len - 8;
+
+	if (inflateInit(&zs) != Z_OK) {
 		Output::Warning("Error decompressing XYZ file.");
 		return false;
 	}
-	const uint8_t (*palette)[3] = (const uint8_t(*)[3]) &dst_buffer.front();
 
-	output.pixels = malloc(w * h * 4);
-	if (!output.pixels) {
-		Output::Warning("Error allocating XYZ pixel buffer.");
-		return false;
-	}
+	auto inflate_next = [&](uint8_t* dst, unsigned size) {
+		zs.next_out = dst;
+		zs.avail_out = size;
+		while (zs.avail_out > 0) {
+			int status = inflate(&zs, Z_SYNC_FLUSH);
+			if (status == Z_STREAM_END) {
+				break;
+			}
+			if (status != Z_OK) {
+				return false;
+			}
+		}
+		return zs.avail_out == 0;
+	};
+
+	uint8_t palette[256][3];
+	std::vector<uint8_t> row(w);
+
+	bool okay = inflate_next(&palette[0][0], sizeof(palette));
+	if (okay) {
+		if (!output.Allocate(w, h)) {
+			inflateEnd(&zs);
+			Output::Warning("Error allocating XYZ pixel buffer.");
+			return false;
+		}
 
-	uint8_t* dst = (uint8_t*) output.pixels;
-	const uint8_t* src = (const uint8_t*) &dst_buffer[768];
-	for (int y = 0; y < h; y++) {
-		for (int x = 0; x < w; x++) {
-			uint8_t pix = *src++;
-			const uint8_t* color = palette[pix];
-			*dst++ = color[0];
-			*dst++ = color[1];
-			*dst++ = color[2];
-			*dst++ = (transparent && pix == 0) ? 0 : 255;
+		for (int i = 0; i < 256; ++i) {
+			output.SetPaletteColor(i, palette[i][0], palette[i][1], palette[i][2], (transparent && i == 0) ? 0 : 255);
 		}
+
+		for (int y = 0; okay && y < h; y++) {
+			okay = inflate_next(row.data(), w);
+			if (okay) {
+				output.WriteIndexed(y, row.data());
+			}
+		}
+	}
+
+	inflateEnd(&zs);
+
+	if (!okay) {
+		Output::Warning("Error decompressing XYZ file.");
+		return false;
 	}
 
-	output.width = w;
-	output.height = h;
 	output.bpp = 8;
 
 	return true;
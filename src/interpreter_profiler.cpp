@@ -0,0 +1,176 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "interpreter_profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <tuple>
+#include <fmt/format.h>
+
+#ifdef HAVE_THREADS
+#  include <mutex>
+#endif
+
+using InterpreterProfiler::Frame;
+using InterpreterProfiler::Stats;
+
+namespace {
+	bool enabled = false;
+
+	auto AsTuple(const Frame& frame) {
+		return std::tie(frame.type, frame.map_id, frame.id, frame.page_id, frame.command_index, frame.code);
+	}
+
+	struct FrameLess {
+		bool operator()(const Frame& l, const Frame& r) const {
+			return AsTuple(l) < AsTuple(r);
+		}
+	};
+
+	struct StackLess {
+		bool operator()(const std::vector<Frame>& l, const std::vector<Frame>& r) const {
+			return std::lexicographical_compare(l.begin(), l.end(), r.begin(), r.end(), FrameLess());
+		}
+	};
+
+	struct Entry {
+		int64_t count = 0;
+		Game_Clock::duration time = {};
+	};
+
+	// Aggregated per call stack, the per command statistics are derived from it
+	std::map<std::vector<Frame>, Entry, StackLess> stacks;
+
+	// Parallel common events can be updated by worker threads
+#ifdef HAVE_THREADS
+	std::mutex mutex;
+
+	std::unique_lock<std::mutex> Lock() {
+		return std::unique_lock<std::mutex>(mutex);
+	}
+#else
+	struct NoLock {
+		~NoLock() {}
+	};
+
+	NoLock Lock() {
+		return {};
+	}
+#endif
+
+	int64_t ToMicroseconds(Game_Clock::duration time) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+	}
+
+	const char* GetTypeName(Frame::Type type) {
+		switch (type) {
+			case Frame::Type::MapEvent:
+				return "event";
+			case Frame::Type::CommonEvent:
+				return "common_event";
+			case Frame::Type::BattleEvent:
+				return "battle_event";
+		}
+		return "";
+	}
+}
+
+bool InterpreterProfiler::IsEnabled() {
+	return enabled;
+}
+
+void InterpreterProfiler::SetEnabled(bool enable) {
+	enabled = enable;
+}
+
+void InterpreterProfiler::Reset() {
+	auto lk = Lock();
+	stacks.clear();
+}
+
+void InterpreterProfiler::Record(const std::vector<Frame>& stack, Game_Clock::duration time) {
+	if (stack.empty()) {
+		return;
+	}
+
+	auto lk = Lock();
+	auto it = stacks.find(stack);
+	if (it == stacks.end()) {
+		it = stacks.emplace(stack, Entry()).first;
+	}
+	it->second.count++;
+	it->second.time += time;
+}
+
+std::vector<Stats> InterpreterProfiler::GetStats() {
+	std::map<Frame, Stats, FrameLess> commands;
+	auto lk = Lock();
+	for (auto& [stack, entry]: stacks) {
+		auto& stats = commands[stack.back()];
+		stats.frame = stack.back();
+		stats.count += entry.count;
+		stats.time += entry.time;
+	}
+
+	std::vector<Stats> result;
+	result.reserve(commands.size());
+	for (auto& [frame, stats]: commands) {
+		result.push_back(stats);
+	}
+
+	std::stable_sort(result.begin(), result.end(), [](const Stats& l, const Stats& r) {
+		return l.time > r.time;
+	});
+	return result;
+}
+
+std::string InterpreterProfiler::GetFrameName(const Frame& frame) {
+	switch (frame.type) {
+		case Frame::Type::MapEvent:
+			if (frame.page_id > 0) {
+				return fmt::format("EV{:04d}[{}]", frame.id, frame.page_id);
+			}
+			return fmt::format("EV{:04d}", frame.id);
+		case Frame::Type::CommonEvent:
+			return fmt::format("CE{:04d}", frame.id);
+		case Frame::Type::BattleEvent:
+			return fmt::format("TR{:04d}[{}]", frame.id, frame.page_id);
+	}
+	return {};
+}
+
+void InterpreterProfiler::WriteCsv(std::ostream& os) {
+	os << "map_id,type,id,page_id,command_index,code,count,time_us\n";
+	for (auto& stats: GetStats()) {
+		auto& frame = stats.frame;
+		os << fmt::format("{},{},{},{},{},{},{},{}\n", frame.map_id, GetTypeName(frame.type), frame.id, frame.page_id,
+			frame.command_index, frame.code, stats.count, ToMicroseconds(stats.time));
+	}
+}
+
+void InterpreterProfiler::WriteFolded(std::ostream& os) {
+	auto lk = Lock();
+	for (auto& [stack, entry]: stacks) {
+		std::string line = fmt::format("Map{:04d}", stack.front().map_id);
+		for (auto& frame: stack) {
+			line += fmt::format(";{};cmd{}@{}", GetFrameName(frame), frame.code, frame.command_index);
+		}
+		os << line << ' ' << ToMicroseconds(entry.time) << '\n';
+	}
+}
@@ -0,0 +1,112 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_INTERPRETER_PROFILER_H
+#define EP_INTERPRETER_PROFILER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "game_clock.h"
+
+/**
+ * Measures the time event commands take, attributed to the event and
+ * command that executed them.
+ *
+ * Disabled by default, enable it from the debug scene. The interpreter
+ * reports every executed command with the call stack of the interpreter.
+ * The results can be written as CSV or as folded stacks which can be
+ * turned into a flamegraph (e.g. with flamegraph.pl).
+ */
+namespace InterpreterProfiler {
+	/** A frame of the interpreter call stack */
+	struct Frame {
+		enum class Type : uint8_t {
+			MapEvent,
+			CommonEvent,
+			BattleEvent
+		};
+
+		Type type = Type::MapEvent;
+		int map_id = 0;
+		/** Event id, common event id or troop id */
+		int id = 0;
+		/** Page of the map event or troop, 0 for common events */
+		int page_id = 0;
+		/** Index of the executed command in the event */
+		int command_index = 0;
+		/** Code of the executed command */
+		int code = 0;
+	};
+
+	struct Stats {
+		/** Innermost frame, the command which was executed */
+		Frame frame;
+		/** Number of executions */
+		int64_t count = 0;
+		/** Total time spent in the command */
+		Game_Clock::duration time = {};
+	};
+
+	/** @return whether the interpreters report their commands */
+	bool IsEnabled();
+
+	/**
+	 * Starts or stops the profiler. The collected data is kept.
+	 *
+	 * @param enabled whether to record commands
+	 */
+	void SetEnabled(bool enabled);
+
+	/** Discards the collected data. */
+	void Reset();
+
+	/**
+	 * Records the execution of a command.
+	 *
+	 * @param stack call stack of the interpreter, the executed command last
+	 * @param time time the command took
+	 */
+	void Record(const std::vector<Frame>& stack, Game_Clock::duration time);
+
+	/** @return statistics per command, most expensive first */
+	std::vector<Stats> GetStats();
+
+	/**
+	 * @param frame frame to describe
+	 * @return short name of the event owning the frame, e.g. EV0005[1]
+	 */
+	std::string GetFrameName(const Frame& frame);
+
+	/**
+	 * Writes the statistics per command as CSV.
+	 *
+	 * @param os output stream
+	 */
+	void WriteCsv(std::ostream& os);
+
+	/**
+	 * Writes the statistics per call stack in the folded stack format
+	 * used by flamegraph tools. The value of a stack is in microseconds.
+	 *
+	 * @param os output stream
+	 */
+	void WriteFolded(std::ostream& os);
+}
+
+#endif
@@ -0,0 +1,200 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "map_file_cache.h"
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <list>
+#include <vector>
+#include <lcf/lmu/reader.h>
+
+#ifdef HAVE_THREADS
+#  include <condition_variable>
+#  include <mutex>
+#endif
+
+namespace {
+	// Maps with many events take a few MB of memory each.
+	// Translated maps are separate entries.
+	constexpr size_t max_entries = 6;
+
+	struct Entry {
+		MapFileCache::Key key;
+		MapFileCache::MapPtr map;
+	};
+
+	struct PrefetchedEntry {
+		MapFileCache::Key key;
+		std::stringstream data;
+	};
+
+	// Most recently used first
+	std::list<Entry> entries;
+	// Map files read by a worker, taken out when the map is loaded
+	std::list<PrefetchedEntry> prefetched;
+	// Maps which are read by a worker
+	std::vector<MapFileCache::Key> pending;
+
+#ifdef HAVE_THREADS
+	std::mutex mutex;
+	std::condition_variable pending_cv;
+
+	std::unique_lock<std::mutex> Lock() {
+		return std::unique_lock<std::mutex>(mutex);
+	}
+#else
+	struct NoLock {
+		~NoLock() {}
+	};
+
+	NoLock Lock() {
+		return {};
+	}
+#endif
+
+	bool IsPending(const MapFileCache::Key& key) {
+		return std::find(pending.begin(), pending.end(), key) != pending.end();
+	}
+
+	std::list<Entry>::iterator Find(const MapFileCache::Key& key) {
+		return std::find_if(entries.begin(), entries.end(), [&](const auto& e) { return e.key == key; });
+	}
+
+	std::list<PrefetchedEntry>::iterator FindPrefetched(const MapFileCache::Key& key) {
+		return std::find_if(prefetched.begin(), prefetched.end(), [&](const auto& e) { return e.key == key; });
+	}
+
+	/**
+	 * Owned by the prefetch task. Marks the map as not pending anymore when
+	 * the task finished or was discarded without running.
+	 */
+	struct PrefetchJob {
+		MapFileCache::Key key;
+		Filesystem_Stream::InputStream stream;
+
+		~PrefetchJob() {
+			auto lk = Lock();
+			pending.erase(std::remove(pending.begin(), pending.end(), key), pending.end());
+#ifdef HAVE_THREADS
+			pending_cv.notify_all();
+#endif
+		}
+	};
+}
+
+MapFileCache::MapPtr MapFileCache::Get(const Key& key) {
+	auto lk = Lock();
+
+	auto it = Find(key);
+	if (it == entries.end()) {
+		return nullptr;
+	}
+
+	entries.splice(entries.begin(), entries, it);
+	return it->map;
+}
+
+void MapFileCache::Put(const Key& key, MapPtr map) {
+	if (!map) {
+		return;
+	}
+
+	auto lk = Lock();
+
+	auto it = Find(key);
+	if (it != entries.end()) {
+		entries.erase(it);
+	}
+
+	entries.push_front({ key, std::move(map) });
+	if (entries.size() > max_entries) {
+		entries.pop_back();
+	}
+}
+
+std::unique_ptr<lcf::rpg::Map> MapFileCache::Parse(std::istream& stream, bool is_xml, StringView encoding) {
+	if (is_xml) {
+		return lcf::LMU_Reader::LoadXml(stream);
+	}
+	return lcf::LMU_Reader::Load(stream, encoding);
+}
+
+void MapFileCache::Prefetch(Key key, Filesystem_Stream::InputStream stream) {
+	if (WorkerPool::GetNumWorkers() == 0 || !stream) {
+		return;
+	}
+
+	assert(key.translation.empty());
+
+	{
+		auto lk = Lock();
+		if (IsPending(key) || FindPrefetched(key) != prefetched.end() || Find(key) != entries.end()) {
+			return;
+		}
+		pending.push_back(key);
+	}
+
+	auto job = std::make_shared<PrefetchJob>();
+	job->key = std::move(key);
+	job->stream = std::move(stream);
+
+	WorkerPool::Submit([job]() {
+		// Only the file is read here, the parsing stays on the main thread
+		std::stringstream data;
+		data << job->stream.rdbuf();
+		job->stream.Close();
+		if (!data) {
+			return;
+		}
+
+		auto lk = Lock();
+		prefetched.push_back({ job->key, std::move(data) });
+		if (prefetched.size() > max_entries) {
+			prefetched.pop_front();
+		}
+	});
+}
+
+std::optional<std::stringstream> MapFileCache::TakePrefetched(const Key& key) {
+	auto lk = Lock();
+
+#ifdef HAVE_THREADS
+	pending_cv.wait(lk, [&]() { return !IsPending(key); });
+#endif
+
+	auto it = FindPrefetched(key);
+	if (it == prefetched.end()) {
+		return std::nullopt;
+	}
+
+	std::optional<std::stringstream> data = std::move(it->data);
+	prefetched.erase(it);
+	return data;
+}
+
+bool MapFileCache::IsCachedOrPending(const Key& key) {
+	auto lk = Lock();
+	return IsPending(key) || FindPrefetched(key) != prefetched.end() || Find(key) != entries.end();
+}
+
+void MapFileCache::Clear() {
+	auto lk = Lock();
+	entries.clear();
+	prefetched.clear();
+}
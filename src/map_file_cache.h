@@ -0,0 +1,113 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_MAP_FILE_CACHE_H
+#define EP_MAP_FILE_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <lcf/rpg/map.h>
+#include "filesystem_stream.h"
+#include "string_view.h"
+
+/**
+ * Keeps the most recently loaded maps in memory to avoid parsing the same
+ * map file again when the player moves back and forth between maps.
+ *
+ * Entries are identified by the resolved file path, the modification time of
+ * the file and the translation that was applied to the map. A changed file
+ * on disk therefore never returns stale data.
+ *
+ * Map files can be read on a worker thread ahead of time. liblcf is not
+ * thread-safe, so the map is parsed on the main thread when it is loaded.
+ */
+namespace MapFileCache {
+	using MapPtr = std::shared_ptr<const lcf::rpg::Map>;
+
+	struct Key {
+		/** Path of the map file as returned by FileFinder */
+		std::string path;
+		/** Modification time of the file, -1 when unknown */
+		int64_t mtime = -1;
+		/** Translation applied to the map, empty for the original text */
+		std::string translation;
+	};
+
+	inline bool operator==(const Key& l, const Key& r) {
+		return l.mtime == r.mtime && l.path == r.path && l.translation == r.translation;
+	}
+
+	/**
+	 * Looks up a map.
+	 *
+	 * @param key map to search
+	 * @return the cached map or nullptr when not cached
+	 */
+	MapPtr Get(const Key& key);
+
+	/**
+	 * Adds a map to the cache. When the cache is full the least recently
+	 * used map is dropped.
+	 *
+	 * @param key map identifier
+	 * @param map parsed map
+	 */
+	void Put(const Key& key, MapPtr map);
+
+	/**
+	 * Parses a map file.
+	 *
+	 * @param stream stream of the map file
+	 * @param is_xml whether the map is an EasyRPG XML map (emu)
+	 * @param encoding encoding of the strings in the map
+	 * @return parsed map or nullptr on error
+	 */
+	std::unique_ptr<lcf::rpg::Map> Parse(std::istream& stream, bool is_xml, StringView encoding);
+
+	/**
+	 * Reads the map file into memory on a worker thread.
+	 * Does nothing when the map is already cached, in progress or when there
+	 * are no worker threads.
+	 *
+	 * @param key map identifier, the translation must be empty
+	 * @param stream opened stream of the map file
+	 */
+	void Prefetch(Key key, Filesystem_Stream::InputStream stream);
+
+	/**
+	 * Takes the content of a prefetched map file out of the cache.
+	 * Waits when the file is still read in the background.
+	 *
+	 * @param key map identifier
+	 * @return content of the map file, empty when it was not prefetched
+	 */
+	std::optional<std::stringstream> TakePrefetched(const Key& key);
+
+	/**
+	 * @param key map identifier
+	 * @return Whether the map is cached, prefetched or read in the background
+	 */
+	bool IsCachedOrPending(const Key& key);
+
+	/** Removes all maps from the cache. */
+	void Clear();
+}
+
+#endif
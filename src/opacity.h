@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <climits>
 #include <memory>
+#include <vector>
 
 /** Opacity class.  */
 struct Opacity {
@@ -130,4 +131,66 @@ inline bool TileOpacity::Empty() const {
 	return _w * _h == 0;
 }
 
+/**
+ * Structure used to store the fully opaque runs of every row of a bitmap
+ * with 1 Bit Alpha. Pixels outside of the spans are transparent.
+ */
+class OpacitySpans {
+	public:
+		struct Span {
+			uint16_t x;
+			uint16_t width;
+		};
+
+		/** Initialize with no rows */
+		OpacitySpans() = default;
+
+		/** Starts the next row, spans added afterwards belong to it */
+		void AddRow();
+
+		/** Adds an opaque span to the current row */
+		void Add(int x, int width);
+
+		/** @return first span of row y */
+		const Span* RowBegin(int y) const;
+
+		/** @return end of the spans of row y */
+		const Span* RowEnd(int y) const;
+
+		/** @return true if no rows stored */
+		bool Empty() const;
+
+	private:
+		std::vector<Span> _spans;
+		/** Index of the first span of every row */
+		std::vector<uint32_t> _rows;
+};
+
+inline void OpacitySpans::AddRow() {
+	_rows.push_back(static_cast<uint32_t>(_spans.size()));
+}
+
+inline void OpacitySpans::Add(int x, int width) {
+	assert(!_rows.empty());
+	assert(x >= 0 && x + width <= UINT16_MAX);
+
+	_spans.push_back({ static_cast<uint16_t>(x), static_cast<uint16_t>(width) });
+}
+
+inline const OpacitySpans::Span* OpacitySpans::RowBegin(int y) const {
+	assert(y >= 0 && y < static_cast<int>(_rows.size()));
+
+	return _spans.data() + _rows[y];
+}
+
+inline const OpacitySpans::Span* OpacitySpans::RowEnd(int y) const {
+	assert(y >= 0 && y < static_cast<int>(_rows.size()));
+
+	return _spans.data() + (y + 1 < static_cast<int>(_rows.size()) ? _rows[y + 1] : _spans.size());
+}
+
+inline bool OpacitySpans::Empty() const {
+	return _rows.empty();
+}
+
 #endif
@@ -24,6 +24,10 @@
 #include <fstream>
 #include <thread>
 #include <chrono>
+#ifdef HAVE_THREADS
+#  include <condition_variable>
+#  include <mutex>
+#endif
 #include <fmt/color.h>
 #include <fmt/ostream.h>
 #ifdef EMSCRIPTEN
@@ -60,26 +64,35 @@ namespace {
 	bool output_recurse = false;
 	bool init = false;
 
-	std::ostream& output_time() {
-		if (!init) {
-			LOG_FILE = FileFinder::Save().OpenOutputStream(OUTPUT_FILENAME, std::ios_base::out | std::ios_base::app);
-			init = true;
-		}
+	// The time is only formatted again when the second changes
+	std::time_t time_prefix_time = -1;
+	std::string time_prefix;
+
+	const std::string& GetTimePrefix() {
 		std::time_t t = std::time(nullptr);
-		return LOG_FILE << Utils::FormatDate(std::localtime(&t), "[%Y-%m-%d %H:%M:%S] ");
+		if (t != time_prefix_time) {
+			time_prefix_time = t;
+			time_prefix = Utils::FormatDate(std::localtime(&t), "[%Y-%m-%d %H:%M:%S] ");
+		}
+		return time_prefix;
 	}
 
 	bool ignore_pause = false;
 	bool colored_log = true;
 
 	std::vector<std::string> log_buffer;
-	// pair of repeat count + message
 	struct {
+		/** How often the message was logged after the first time */
 		int repeat = 0;
+		/** Repeats since the count was written the last time */
+		int unreported = 0;
 		std::string msg;
 		LogLevel lvl = {};
 	} last_message;
 
+	// A message repeated every frame is reported every few seconds
+	constexpr int max_unreported = 500;
+
 	void LogCallback(LogLevel lvl, std::string const& msg, LogCallbackUserData /* userdata */) {
 		// terminal output
 		std::string prefix = Output::LogLevelToString(lvl) + ":";
@@ -112,6 +125,208 @@ namespace {
 
 	LogCallbackFn log_cb = LogCallback;
 	LogCallbackUserData log_cb_udata = nullptr;
+
+#ifdef HAVE_THREADS
+	// Worker threads can log, e.g. the filesystems used by the game scanner
+	std::recursive_mutex log_mutex;
+	const std::thread::id main_thread_id = std::this_thread::get_id();
+#endif
+
+	/** A formatted line waiting to be written to the log file */
+	struct LogRecord {
+		std::string file_line;
+	};
+
+	void WriteRecord(const LogRecord& rec) {
+		if (LOG_FILE) {
+			LOG_FILE << rec.file_line << '\n';
+		}
+	}
+
+#ifdef HAVE_THREADS
+	/**
+	 * Writing messages except errors to the log file is done by a background
+	 * thread. The thread that logs only moves the record into a preallocated
+	 * ring and waits when the ring is full.
+	 * The writer thread must never log itself.
+	 */
+	struct LogQueue {
+		std::vector<LogRecord> ring = std::vector<LogRecord>(256);
+		size_t first = 0;
+		size_t size = 0;
+		/** Records were taken from the ring but are not written yet */
+		bool writing = false;
+		bool stop = false;
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable cv;
+
+		/** Writes the remaining records and ends the thread */
+		void Stop() {
+			{
+				std::lock_guard<std::mutex> lk(mutex);
+				stop = true;
+			}
+			cv.notify_all();
+
+			if (thread.joinable()) {
+				thread.join();
+			}
+		}
+
+		~LogQueue() {
+			// exit() without Output::Quit
+			Stop();
+		}
+	} log_queue;
+
+	void LogThreadMain() {
+		auto& q = log_queue;
+		std::vector<LogRecord> records;
+
+		std::unique_lock<std::mutex> lk(q.mutex);
+		while (true) {
+			q.cv.wait(lk, [&]() { return q.stop || q.size > 0; });
+			if (q.size == 0) {
+				return;
+			}
+
+			for (; q.size > 0; --q.size) {
+				records.push_back(std::move(q.ring[q.first]));
+				q.first = (q.first + 1) % q.ring.size();
+			}
+			q.writing = true;
+			lk.unlock();
+			q.cv.notify_all();
+
+			for (const auto& rec: records) {
+				WriteRecord(rec);
+			}
+			records.clear();
+			if (LOG_FILE) {
+				LOG_FILE.flush();
+			}
+
+			lk.lock();
+			q.writing = false;
+			q.cv.notify_all();
+		}
+	}
+
+	void StopLogThread() {
+		log_queue.Stop();
+
+		// Started again by the next message
+		std::lock_guard<std::mutex> lk(log_queue.mutex);
+		log_queue.stop = false;
+	}
+#endif
+
+	/** Blocks until all queued records are written. */
+	void DrainLog() {
+#ifdef HAVE_THREADS
+		auto& q = log_queue;
+		std::unique_lock<std::mutex> lk(q.mutex);
+		q.cv.wait(lk, [&]() { return q.size == 0 && !q.writing; });
+#endif
+	}
+
+	/**
+	 * Writes a record to the log file.
+	 *
+	 * @param rec record to write
+	 * @param sync write and flush before returning. The queued records are written first.
+	 */
+	void QueueRecord(LogRecord rec, bool sync) {
+#ifdef HAVE_THREADS
+		auto& q = log_queue;
+		std::unique_lock<std::mutex> lk(q.mutex);
+		if (sync) {
+			// Producers are serialized by the log mutex, nothing is queued meanwhile
+			q.cv.wait(lk, [&]() { return q.size == 0 && !q.writing; });
+		} else if (!q.stop) {
+			if (!q.thread.joinable()) {
+				q.thread = std::thread(LogThreadMain);
+			}
+
+			q.cv.wait(lk, [&]() { return q.size < q.ring.size(); });
+			q.ring[(q.first + q.size) % q.ring.size()] = std::move(rec);
+			++q.size;
+			lk.unlock();
+			q.cv.notify_all();
+			return;
+		}
+		lk.unlock();
+#endif
+		WriteRecord(rec);
+		if (sync && LOG_FILE) {
+			LOG_FILE.flush();
+		}
+	}
+
+	/**
+	 * Writes a message to the log file (or the startup buffer).
+	 * Errors are written immediately, the Player exits afterwards.
+	 */
+	void WriteMessage(LogLevel lvl, std::string const& msg) {
+	// skip writing log file
+	#ifndef EMSCRIPTEN
+		const bool sync = lvl == LogLevel::Error;
+		std::string line = Output::LogLevelToString(lvl) + ": " + msg;
+		bool add_to_buffer = true;
+
+		// Prevent recursion when the Save filesystem writes to the logfile on startup before it is ready
+		if (!output_recurse) {
+			output_recurse = true;
+			if (FileFinder::Save()) {
+				add_to_buffer = false;
+
+				if (!init) {
+					// The writer thread can still use the stream
+					DrainLog();
+					LOG_FILE = FileFinder::Save().OpenOutputStream(OUTPUT_FILENAME, std::ios_base::out | std::ios_base::app);
+					init = true;
+				}
+
+				// Only write to file when save path is initialized
+				// (happens after parsing the command line)
+				if (!log_buffer.empty()) {
+					std::vector<std::string> local_log_buffer = std::move(log_buffer);
+					for (std::string& log : local_log_buffer) {
+						QueueRecord({ GetTimePrefix() + log }, false);
+					}
+					local_log_buffer.clear();
+				}
+
+				QueueRecord({ GetTimePrefix() + line }, sync);
+			}
+			output_recurse = false;
+		}
+
+		if (add_to_buffer) {
+			// buffer log messages until file system is ready
+			log_buffer.push_back(std::move(line));
+		}
+	#else
+		(void)lvl;
+		(void)msg;
+	#endif
+	}
+
+	/** Writes a message to the log file and to the custom logger or terminal. */
+	void OutputMessage(LogLevel lvl, std::string const& msg) {
+		WriteMessage(lvl, msg);
+		log_cb(lvl, msg, log_cb_udata);
+	}
+
+	/** Writes how often the last message was repeated since the last report. */
+	void ReportRepeatedMessage() {
+		if (last_message.unreported == 0) {
+			return;
+		}
+		last_message.unreported = 0;
+		OutputMessage(last_message.lvl, fmt::format("{} [{}x]", last_message.msg, last_message.repeat + 1));
+	}
 }
 
 std::string Output::LogLevelToString(LogLevel lvl) {
@@ -140,57 +355,37 @@ void Output::SetLogCallback(LogCallbackFn fn, LogCallbackUserData userdata) {
 }
 
 static void WriteLog(LogLevel lvl, std::string const& msg, Color const& c = Color()) {
-// skip writing log file
-#ifndef EMSCRIPTEN
-	std::string prefix = Output::LogLevelToString(lvl) + ": ";
-	bool add_to_buffer = true;
-
-	// Prevent recursion when the Save filesystem writes to the logfile on startup before it is ready
-	if (!output_recurse) {
-		output_recurse = true;
-		if (FileFinder::Save()) {
-			add_to_buffer = false;
-
-			// Only write to file when save path is initialized
-			// (happens after parsing the command line)
-			if (!log_buffer.empty()) {
-				std::vector<std::string> local_log_buffer = std::move(log_buffer);
-				for (std::string& log : local_log_buffer) {
-					output_time() << log << '\n';
-				}
-				local_log_buffer.clear();
-			}
-
-			// Every new message is written once to the file.
-			// When it is repeated increment a counter until a different message appears,
-			// then write the buffered message with the counter.
-			if (msg == last_message.msg) {
-				last_message.repeat++;
-			} else {
-				if (last_message.repeat > 0) {
-					output_time() << Output::LogLevelToString(last_message.lvl) << ": " << last_message.msg << " [" << last_message.repeat + 1 << "x]" << std::endl;
-				}
-				output_time() << prefix << msg << '\n';
+	{
+#ifdef HAVE_THREADS
+		std::lock_guard<std::recursive_mutex> lock(log_mutex);
+#endif
 
-				last_message.repeat = 0;
-				last_message.msg = msg;
-				last_message.lvl = lvl;
+		// Every new message is written once to the file and the terminal.
+		// When it is repeated increment a counter until a different message appears,
+		// then write the message with the counter.
+		if (msg == last_message.msg && lvl != LogLevel::Error) {
+			last_message.repeat++;
+			if (++last_message.unreported >= max_unreported) {
+				ReportRepeatedMessage();
 			}
-		}
-		output_recurse = false;
-	}
+		} else {
+			ReportRepeatedMessage();
+			OutputMessage(lvl, msg);
 
-	if (add_to_buffer) {
-		// buffer log messages until file system is ready
-		log_buffer.push_back(prefix + msg);
+			last_message.repeat = 0;
+			last_message.msg = msg;
+			last_message.lvl = lvl;
+		}
 	}
-#endif
-
-	// output to custom logger or terminal
-	log_cb(lvl, msg, log_cb_udata);
 
 	// output to overlay
 	if (lvl != LogLevel::Debug && lvl != LogLevel::Error) {
+#ifdef HAVE_THREADS
+		// The overlay is only drawn by the main thread
+		if (std::this_thread::get_id() != main_thread_id) {
+			return;
+		}
+#endif
 		Graphics::GetMessageOverlay().AddMessage(msg, c);
 	}
 }
@@ -223,6 +418,16 @@ static void HandleErrorOutput(const std::string& err) {
 }
 
 void Output::Quit() {
+	{
+#ifdef HAVE_THREADS
+		std::lock_guard<std::recursive_mutex> lock(log_mutex);
+#endif
+		ReportRepeatedMessage();
+	}
+#ifdef HAVE_THREADS
+	StopLogThread();
+#endif
+
 	if (LOG_FILE) {
 		LOG_FILE.Close();
 	}
@@ -289,6 +494,10 @@ void Output::ToggleLog() {
 
 void Output::ErrorStr(std::string const& err) {
 	WriteLog(LogLevel::Error, err);
+	// The process exits below, everything must be written
+#ifdef HAVE_THREADS
+	StopLogThread();
+#endif
 	std::string error = "Error:\n" + err + "\n\nEasyRPG Player will close now.";
 
 	static bool recursive_call = false;
@@ -29,6 +29,15 @@ Plane::Plane() : Drawable(0)
 	DrawableMgr::Register(this);
 }
 
+Drawable::Bounds Plane::GetBounds(const Bitmap& dst) {
+	Bounds bounds;
+	bounds.known = true;
+	if (bitmap) {
+		bounds.rect = dst.GetRect();
+	}
+	return bounds;
+}
+
 void Plane::Draw(Bitmap& dst) {
 	if (!bitmap) return;
 
@@ -32,6 +32,7 @@ public:
 	Plane();
 
 	void Draw(Bitmap& dst) override;
+	Bounds GetBounds(const Bitmap& dst) override;
 
 	BitmapRef const& GetBitmap() const;
 	void SetBitmap(BitmapRef const& bitmap);
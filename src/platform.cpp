@@ -20,7 +20,11 @@
 #include "filefinder.h"
 #include "utils.h"
 #include <cassert>
+#include <cstdio>
 #include <utility>
+#ifndef _WIN32
+#  include <fcntl.h>
+#endif
 
 #ifndef DT_UNKNOWN
 #define DT_UNKNOWN 0
@@ -123,6 +127,29 @@ int64_t Platform::File::GetSize() const {
 #endif
 }
 
+int64_t Platform::File::GetModificationTime() const {
+#if defined(_WIN32)
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	BOOL res = ::GetFileAttributesExW(filename.c_str(),
+			GetFileExInfoStandard,
+			&data);
+	if (!res) {
+		return -1;
+	}
+
+	// FILETIME counts 100ns intervals since 1601-01-01
+	int64_t ft = ((int64_t)data.ftLastWriteTime.dwHighDateTime << 32) | (int64_t)data.ftLastWriteTime.dwLowDateTime;
+	return ft / 10000000 - 11644473600LL;
+#elif defined(__vita__)
+	// SceIoStat only provides a broken down date
+	return -1;
+#else
+	struct stat sb = {};
+	int result = ::stat(filename.c_str(), &sb);
+	return (result == 0) ? (int64_t)sb.st_mtime : (int64_t)-1;
+#endif
+}
+
 bool Platform::File::MakeDirectory(bool follow_symlinks) const {
 	if (IsDirectory(follow_symlinks)) {
 		return true;
@@ -189,6 +216,58 @@ bool Platform::File::MakeDirectory(bool follow_symlinks) const {
 	return true;
 }
 
+bool Platform::File::MoveTo(const std::string& target) const {
+#ifdef _WIN32
+	// MOVEFILE_WRITE_THROUGH only covers the move, not the file content
+	HANDLE handle = ::CreateFileW(filename.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	bool flushed = ::FlushFileBuffers(handle) != 0;
+	::CloseHandle(handle);
+	if (!flushed) {
+		return false;
+	}
+
+	return ::MoveFileExW(filename.c_str(), Utils::ToWideString(target).c_str(),
+		MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#elif defined(__vita__) || defined(PLAYER_NINTENDO)
+	return ::rename(filename.c_str(), target.c_str()) == 0;
+#else
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	bool synced = ::fsync(fd) == 0;
+	::close(fd);
+	if (!synced) {
+		return false;
+	}
+
+	if (::rename(filename.c_str(), target.c_str()) != 0) {
+		return false;
+	}
+
+	// The rename is only durable after the directory was synced
+	auto slash = target.find_last_of('/');
+	std::string dir = slash == std::string::npos ? "." : slash == 0 ? "/" : target.substr(0, slash);
+	fd = ::open(dir.c_str(), O_RDONLY);
+	if (fd >= 0) {
+		::fsync(fd);
+		::close(fd);
+	}
+	return true;
+#endif
+}
+
+bool Platform::File::Remove() const {
+#ifdef _WIN32
+	return ::DeleteFileW(filename.c_str()) != 0;
+#else
+	return ::remove(filename.c_str()) == 0;
+#endif
+}
+
 Platform::Directory::Directory(const std::string& name) {
 #if defined(_WIN32)
 	std::wstring wname = Utils::ToWideString((name.empty() ? "." : name) + "\\*");
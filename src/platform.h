@@ -89,6 +89,9 @@ namespace Platform {
 		/** @return Filesize or -1 on error */
 		int64_t GetSize() const;
 
+		/** @return Last modification time in seconds since the epoch or -1 on error */
+		int64_t GetModificationTime() const;
+
 		/**
 		 * Creates a directory recursively at the filename path.
 		 * @param follow_symlinks Whether to follow symlinks (if supported on this platform)
@@ -96,6 +99,24 @@ namespace Platform {
 		 */
 		bool MakeDirectory(bool follow_symlinks) const;
 
+		/**
+		 * Moves the file to another path, an existing file at this path is
+		 * replaced in one step.
+		 * The content of the file is flushed to the disk before the move.
+		 * On POSIX systems the directory of the target is synced afterwards,
+		 * so the new directory entry survives a power loss as well.
+		 * Platforms without fsync only rename the file.
+		 * @param target new path of the file
+		 * @return true on success
+		 */
+		bool MoveTo(const std::string& target) const;
+
+		/**
+		 * Deletes the file.
+		 * @return true on success
+		 */
+		bool Remove() const;
+
 	private:
 #ifdef _WIN32
 		const std::wstring filename;
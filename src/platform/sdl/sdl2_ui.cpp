@@ -209,6 +209,7 @@ Sdl2Ui::~Sdl2Ui() {
 	if (sdl_joystick) {
 		SDL_JoystickClose(sdl_joystick);
 	}
+	EndDirectRender();
 	if (sdl_texture_game) {
 		SDL_DestroyTexture(sdl_texture_game);
 	}
@@ -235,6 +236,7 @@ bool Sdl2Ui::vChangeDisplaySurfaceResolution(int new_width, int new_height) {
 		return false;
 	}
 
+	EndDirectRender();
 	if (sdl_texture_game) {
 		SDL_DestroyTexture(sdl_texture_game);
 	}
@@ -250,6 +252,7 @@ bool Sdl2Ui::vChangeDisplaySurfaceResolution(int new_width, int new_height) {
 
 	main_surface = new_main_surface;
 	window.size_changed = true;
+	SetupPresentation();
 
 	BeginDisplayModeChange();
 
@@ -484,6 +487,7 @@ bool Sdl2Ui::RefreshDisplayMode() {
 		main_surface = Bitmap::Create(
 			display_width, display_height, Color(0, 0, 0, 255));
 	}
+	SetupPresentation();
 
 	return true;
 }
@@ -584,24 +588,194 @@ void Sdl2Ui::ToggleVsync() {
 #endif
 }
 
-void Sdl2Ui::UpdateDisplay() {
+void Sdl2Ui::ToggleDirectRender() {
+	vcfg.direct_render.Toggle();
+	SetupPresentation();
+}
+
+void Sdl2Ui::SetupPresentation() {
+	last_frame.clear();
+	EndDirectRender();
+
+	if (!sdl_texture_game || !main_surface || !vcfg.direct_render.Get()) {
+		Output::Debug("SDL2: Direct rendering disabled");
+		return;
+	}
+
+	uint32_t fmt;
+	int access, w, h;
+	SDL_RendererInfo rinfo;
+	SDL_QueryTexture(sdl_texture_game, &fmt, &access, &w, &h);
+	SDL_GetRendererInfo(sdl_renderer, &rinfo);
+	StringView renderer = rinfo.name;
+
+	// Only these renderers keep the pixel buffer of a streaming texture
+	// alive between two locks and upload the whole buffer on unlock.
+	// The others hand out temporary staging memory.
+	bool persistent_buffer = renderer == "opengl" || renderer == "opengles2" || renderer == "software";
+	auto tex_format = GetDynamicFormat(fmt);
+
+	if (!persistent_buffer || tex_format != Bitmap::pixel_format) {
+		Output::Debug("SDL2: Direct rendering not possible with {}", renderer);
+		return;
+	}
+
+	void* pixels = nullptr;
+	void* pixels_again = nullptr;
+	int pitch = 0;
+
+	if (SDL_LockTexture(sdl_texture_game, nullptr, &pixels, &pitch) != 0) {
+		Output::Debug("SDL2: Direct rendering not possible: {}", SDL_GetError());
+		return;
+	}
+	SDL_UnlockTexture(sdl_texture_game);
+
+	// The texture stays locked while the game draws into it and is only
+	// unlocked for presenting, see UploadDisplay and LockDirectRender
+	if (SDL_LockTexture(sdl_texture_game, nullptr, &pixels_again, &pitch) != 0) {
+		Output::Debug("SDL2: Direct rendering not possible: {}", SDL_GetError());
+		return;
+	}
+
+	if (pixels != pixels_again) {
+		SDL_UnlockTexture(sdl_texture_game);
+		Output::Debug("SDL2: Direct rendering not possible with {}", renderer);
+		return;
+	}
+
+	auto surface = Bitmap::Create(pixels, w, h, pitch, Bitmap::pixel_format);
+	if (surface->GetRect() == main_surface->GetRect()) {
+		surface->BlitFast(0, 0, *main_surface, main_surface->GetRect(), Opacity::Opaque());
+	}
+	main_surface = surface;
+	direct_render = true;
+
+	Output::Debug("SDL2: Direct rendering enabled");
+}
+
+void Sdl2Ui::EndDirectRender() {
+	if (!direct_render) {
+		return;
+	}
+
+	// Draw into memory of our own again. Copied while the texture is still
+	// locked because the pixel buffer is only valid until then.
+	auto surface = Bitmap::Create(main_surface->width(), main_surface->height(), Color(0, 0, 0, 255));
+	surface->BlitFast(0, 0, *main_surface, main_surface->GetRect(), Opacity::Opaque());
+	main_surface = surface;
+
+	SDL_UnlockTexture(sdl_texture_game);
+	direct_render = false;
+}
+
+void Sdl2Ui::LockDirectRender() {
+	void* pixels;
+	int pitch;
+	if (SDL_LockTexture(sdl_texture_game, nullptr, &pixels, &pitch) != 0) {
+		Output::Debug("SDL2: Texture lock failed, disabling direct rendering: {}", SDL_GetError());
+		auto surface = Bitmap::Create(main_surface->width(), main_surface->height(), Color(0, 0, 0, 255));
+		main_surface = surface;
+		direct_render = false;
+		last_frame.clear();
+		return;
+	}
+
+	if (pixels != main_surface->pixels() || pitch != main_surface->pitch()) {
+		// The old buffer is gone, the main surface must not point to it anymore
+		Output::Debug("SDL2: Texture buffer moved");
+		main_surface = Bitmap::Create(pixels, main_surface->width(), main_surface->height(), pitch, Bitmap::pixel_format);
+	}
+}
+
+void Sdl2Ui::UploadDisplay() {
+	if (direct_render) {
+		// The frame was drawn into the locked pixel buffer of the texture.
+		// Unlocking hands the buffer to the renderer.
+		SDL_UnlockTexture(sdl_texture_game);
+		return;
+	}
+
 #ifdef __WIIU__
 	if (vcfg.scaling_mode.Get() == ConfigEnum::ScalingMode::Bilinear && window.scale > 0.f) {
 		// Workaround WiiU bug: Bilinear uses a render target and for these the format is not converted
+		UploadConvertedRows(SDL_PIXELFORMAT_RGBA8888);
+		return;
+	}
+#endif
+
+	// The next conversion must upload everything
+	last_frame.clear();
+
+	// SDL_UpdateTexture was found to be faster than SDL_LockTexture / SDL_UnlockTexture.
+	SDL_UpdateTexture(sdl_texture_game, nullptr, main_surface->pixels(), main_surface->pitch());
+}
+
+void Sdl2Ui::UploadConvertedRows(uint32_t format) {
+	const int width = main_surface->width();
+	const int height = main_surface->height();
+	const int pitch = main_surface->pitch();
+	const size_t row_size = static_cast<size_t>(width) * main_surface->bpp();
+	const auto* pixels = static_cast<const uint8_t*>(main_surface->pixels());
+
+	bool full_upload = false;
+	if (last_frame.size() != row_size * height) {
+		last_frame.resize(row_size * height);
+		full_upload = true;
+	}
+
+	auto upload = [&](int first, int last) {
+		for (int y = first; y < last; ++y) {
+			memcpy(&last_frame[y * row_size], pixels + y * pitch, row_size);
+		}
+
+		SDL_Rect rect = { 0, first, width, last - first };
 		void* target_pixels;
 		int target_pitch;
 
-		SDL_LockTexture(sdl_texture_game, nullptr, &target_pixels, &target_pitch);
-		SDL_ConvertPixels(main_surface->width(), main_surface->height(), GetDefaultFormat(), main_surface->pixels(),
-			main_surface->pitch(), SDL_PIXELFORMAT_RGBA8888, target_pixels, target_pitch);
+		if (SDL_LockTexture(sdl_texture_game, &rect, &target_pixels, &target_pitch) != 0) {
+			return;
+		}
+		SDL_ConvertPixels(width, rect.h, GetDefaultFormat(), pixels + first * pitch,
+			pitch, format, target_pixels, target_pitch);
 		SDL_UnlockTexture(sdl_texture_game);
-	} else {
-		SDL_UpdateTexture(sdl_texture_game, nullptr, main_surface->pixels(), main_surface->pitch());
+	};
+
+	if (full_upload) {
+		upload(0, height);
+		return;
 	}
-#else
-	// SDL_UpdateTexture was found to be faster than SDL_LockTexture / SDL_UnlockTexture.
-	SDL_UpdateTexture(sdl_texture_game, nullptr, main_surface->pixels(), main_surface->pitch());
-#endif
+
+	// Every upload has a fixed cost, small gaps between changed rows are
+	// uploaded as well to keep the number of uploads low.
+	constexpr int max_gap = 8;
+
+	int first = -1;
+	int last = -1;
+	for (int y = 0; y < height; ++y) {
+		if (memcmp(&last_frame[y * row_size], pixels + y * pitch, row_size) == 0) {
+			continue;
+		}
+
+		if (first >= 0 && y - last > max_gap) {
+			upload(first, last);
+			first = -1;
+		}
+		if (first < 0) {
+			first = y;
+		}
+		last = y + 1;
+	}
+
+	if (first >= 0) {
+		upload(first, last);
+	}
+}
+
+void Sdl2Ui::UpdateDisplay() {
+	auto upload_start = Game_Clock::now();
+	UploadDisplay();
+	upload_time += Game_Clock::now() - upload_start;
+	++upload_count;
 
 	if (window.size_changed && window.width > 0 && window.height > 0) {
 		// Based on SDL2 function UpdateLogicalSize
@@ -692,6 +866,10 @@ void Sdl2Ui::UpdateDisplay() {
 		SDL_RenderCopy(sdl_renderer, sdl_texture_game, nullptr, nullptr);
 	}
 	SDL_RenderPresent(sdl_renderer);
+
+	if (direct_render) {
+		LockDirectRender();
+	}
 }
 
 void Sdl2Ui::SetTitle(const std::string &title) {
@@ -1280,6 +1458,7 @@ void Sdl2Ui::vGetConfig(Game_ConfigVideo& cfg) const {
 #endif
 	cfg.scaling_mode.SetOptionVisible(true);
 	cfg.stretch.SetOptionVisible(true);
+	cfg.direct_render.SetOptionVisible(true);
 	cfg.game_resolution.SetOptionVisible(true);
 	cfg.pause_when_focus_lost.SetOptionVisible(true);
 
@@ -25,6 +25,7 @@
 #include "system.h"
 
 #include <array>
+#include <vector>
 #include <SDL.h>
 
 extern "C" {
@@ -69,6 +70,7 @@ public:
 	void SetScalingMode(ConfigEnum::ScalingMode) override;
 	void ToggleStretch() override;
 	void ToggleVsync() override;
+	void ToggleDirectRender() override;
 	void vGetConfig(Game_ConfigVideo& cfg) const override;
 	bool OpenURL(StringView url) override;
 	Rect GetWindowMetrics() const override;
@@ -124,6 +126,35 @@ private:
 
 	void RequestVideoMode(int width, int height, int zoom, bool fullscreen, bool vsync);
 
+	/**
+	 * Decides how the main surface reaches the game texture.
+	 * Must be called whenever the game texture was recreated.
+	 */
+	void SetupPresentation();
+
+	/**
+	 * Stops drawing into the game texture: The main surface gets memory of its
+	 * own and the texture is unlocked.
+	 */
+	void EndDirectRender();
+
+	/**
+	 * Locks the game texture again after presenting for drawing the next frame.
+	 * The main surface is recreated when the pixel buffer moved.
+	 */
+	void LockDirectRender();
+
+	/** Uploads the main surface to the game texture. */
+	void UploadDisplay();
+
+	/**
+	 * Converts the main surface to the format and uploads it to the game texture.
+	 * Only the rows which changed since the last conversion are converted.
+	 *
+	 * @param format pixel format to convert to
+	 */
+	void UploadConvertedRows(uint32_t format);
+
 	/** Last display mode. */
 	DisplayMode last_display_mode;
 
@@ -145,6 +176,15 @@ private:
 
 	uint32_t texture_format = SDL_PIXELFORMAT_UNKNOWN;
 
+	/**
+	 * The main surface uses the pixel buffer of the game texture.
+	 * The texture is locked except while presenting.
+	 */
+	bool direct_render = false;
+
+	/** Copy of the last converted frame, used to find changed rows */
+	std::vector<uint8_t> last_frame;
+
 #ifdef SUPPORT_AUDIO
 	std::unique_ptr<AudioInterface> audio_;
 #endif
@@ -39,6 +39,7 @@
 #include "cmdline_parser.h"
 #include "dynrpg.h"
 #include "filefinder.h"
+#include "frame_skip.h"
 #include "filefinder_rtp.h"
 #include "fileext_guesser.h"
 #include "filesystem_hook.h"
@@ -84,6 +85,9 @@
 #include "game_clock.h"
 #include "message_overlay.h"
 #include "audio_midi.h"
+#include "worker_pool.h"
+#include "map_file_cache.h"
+#include "save_writer.h"
 
 #ifdef __ANDROID__
 #include "platform/android/android.h"
@@ -131,6 +135,7 @@ namespace Player {
 	std::string command_line;
 	int speed_modifier_a;
 	int speed_modifier_b;
+	bool speed_modifier_turbo;
 	int rng_seed = -1;
 	Game_ConfigPlayer player_config;
 	Game_ConfigGame game_config;
@@ -148,6 +153,10 @@ namespace {
 	FileRequestBinding system_request_id;
 	FileRequestBinding save_request_id;
 	FileRequestBinding map_request_id;
+
+	// Whether frames are skipped to run faster while fast forwarding
+	bool turbo = false;
+	FrameSkip frame_skip;
 }
 
 void Player::Init(std::vector<std::string> args) {
@@ -198,6 +207,7 @@ void Player::Init(std::vector<std::string> args) {
 	player_config = std::move(cfg.player);
 	speed_modifier_a = cfg.input.speed_modifier_a.Get();
 	speed_modifier_b = cfg.input.speed_modifier_b.Get();
+	speed_modifier_turbo = cfg.input.speed_modifier_turbo.Get();
 }
 
 void Player::Run() {
@@ -235,6 +245,9 @@ void Player::MainLoop() {
 		return;
 	}
 
+	const bool frame_skip_active = turbo;
+	const int max_updates = frame_skip_active ? frame_skip.GetStepsPerFrame(Game_Clock::GetGameSpeedFactor()) : 0;
+
 	int num_updates = 0;
 	while (Game_Clock::NextGameTimeStep()) {
 		if (num_updates > 0) {
@@ -247,19 +260,36 @@ void Player::MainLoop() {
 			}
 		}
 
+		const auto step_start = Game_Clock::now();
+
 		Scene::old_instances.clear();
 		Scene::instance->MainFunction();
 
 		Graphics::GetMessageOverlay().Update();
 
 		++num_updates;
+
+		if (frame_skip_active) {
+			frame_skip.AddStepTime(Game_Clock::now() - step_start);
+
+			if (num_updates >= max_updates) {
+				// Too slow for the requested speed: Draw now and drop the
+				// remaining time instead of catching up in the next frames
+				Game_Clock::DiscardGameTime();
+				break;
+			}
+		}
 	}
 	if (num_updates == 0) {
 		// If no logical frames ran, we need to update the system keys only.
 		Input::UpdateSystem();
 	}
 
+	const auto draw_start = Game_Clock::now();
 	Player::Draw();
+	if (frame_skip_active) {
+		frame_skip.AddDrawTime(Game_Clock::now() - draw_start);
+	}
 
 	Scene::old_instances.clear();
 
@@ -315,6 +345,14 @@ void Player::UpdateInput() {
 	}
 	Game_Clock::SetGameSpeedFactor(speed);
 
+	// The frame skip limits the steps per frame, the clock does not need to
+	bool new_turbo = speed > 1.0f && speed_modifier_turbo;
+	if (new_turbo != turbo) {
+		turbo = new_turbo;
+		Game_Clock::SetUncapped(turbo);
+		frame_skip.Reset();
+	}
+
 	if (Main_Data::game_quit) {
 		reset_flag |= Main_Data::game_quit->ShouldQuit();
 	}
@@ -342,6 +380,7 @@ void Player::Update(bool update_scene) {
 
 	Audio().Update();
 	Input::Update();
+	SaveWriter::Update();
 
 	// Game events can query full screen status and change their behavior, so this needs to
 	// be a game key and not a system key.
@@ -408,9 +447,15 @@ void Player::Exit() {
 	auto ret = FileFinder::Root().OpenOutputStream("/tmp/message.png", std::ios_base::binary | std::ios_base::out | std::ios_base::trunc);
 	if (ret) Output::TakeScreenshot(ret);
 #endif
+	// Saves which are still written by a worker
+	SaveWriter::Flush();
+
 	Player::ResetGameObjects();
 	Font::Dispose();
 	DynRpg::Reset();
+	WorkerPool::Quit();
+	MapFileCache::Clear();
+	FileFinder::SaveDirectoryIndexes();
 	Graphics::Quit();
 	Output::Quit();
 	FileFinder::Quit();
@@ -1098,6 +1143,9 @@ static void OnMapSaveFileReady(FileRequestResult*, lcf::rpg::Save save) {
 void Player::LoadSavegame(const std::string& save_name, int save_id) {
 	Output::Debug("Loading Save {}", save_name);
 
+	// The save could still be written
+	SaveWriter::Flush();
+
 	bool load_on_map = Scene::instance->type == Scene::Map;
 
 	if (!load_on_map) {
@@ -410,6 +410,9 @@ namespace Player {
 	extern int speed_modifier_a;
 	extern int speed_modifier_b;
 
+	/** Whether frames are skipped to reach the fast forward speed on slow devices */
+	extern bool speed_modifier_turbo;
+
 	/**
 	 * The engine game logic configuration
 	 */
@@ -0,0 +1,90 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "regex_cache.h"
+#include "output.h"
+
+#include <algorithm>
+#include <list>
+#include <string>
+
+#ifdef HAVE_THREADS
+#  include <mutex>
+#endif
+
+namespace {
+	constexpr size_t max_entries = 32;
+
+	struct Entry {
+		std::string pattern;
+		std::regex::flag_type flags;
+		RegexCache::RegexPtr regex;
+	};
+
+	// Most recently used first
+	std::list<Entry> entries;
+
+#ifdef HAVE_THREADS
+	std::mutex mutex;
+
+	std::unique_lock<std::mutex> Lock() {
+		return std::unique_lock<std::mutex>(mutex);
+	}
+#else
+	struct NoLock {
+		~NoLock() {}
+	};
+
+	NoLock Lock() {
+		return {};
+	}
+#endif
+}
+
+RegexCache::RegexPtr RegexCache::Get(StringView pattern, std::regex::flag_type flags) {
+	{
+		auto lk = Lock();
+		auto it = std::find_if(entries.begin(), entries.end(), [&](const auto& e) {
+			return e.flags == flags && e.pattern == pattern;
+		});
+		if (it != entries.end()) {
+			entries.splice(entries.begin(), entries, it);
+			return it->regex;
+		}
+	}
+
+	// Compiled outside of the lock, this is the slow part
+	RegexPtr regex;
+	try {
+		regex = std::make_shared<const std::regex>(pattern.begin(), pattern.end(), flags);
+	} catch (const std::regex_error& e) {
+		Output::Warning("Invalid regular expression \"{}\": {}", pattern, e.what());
+		return nullptr;
+	}
+
+	auto lk = Lock();
+	entries.push_front({ ToString(pattern), flags, regex });
+	if (entries.size() > max_entries) {
+		entries.pop_back();
+	}
+	return regex;
+}
+
+void RegexCache::Clear() {
+	auto lk = Lock();
+	entries.clear();
+}
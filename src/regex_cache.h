@@ -0,0 +1,48 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_REGEX_CACHE_H
+#define EP_REGEX_CACHE_H
+
+#include <memory>
+#include <regex>
+#include "string_view.h"
+
+/**
+ * Keeps the most recently used regular expressions compiled.
+ *
+ * Compiling a std::regex is expensive and the Maniac string commands
+ * usually run the same pattern over and over again, often in loops.
+ */
+namespace RegexCache {
+	using RegexPtr = std::shared_ptr<const std::regex>;
+
+	/**
+	 * Returns the compiled pattern. When the cache is full the least
+	 * recently used pattern is dropped.
+	 *
+	 * @param pattern regular expression
+	 * @param flags syntax options
+	 * @return compiled regex or nullptr when the pattern is invalid
+	 */
+	RegexPtr Get(StringView pattern, std::regex::flag_type flags = std::regex::ECMAScript);
+
+	/** Removes all patterns from the cache. */
+	void Clear();
+}
+
+#endif
@@ -0,0 +1,253 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "save_writer.h"
+#include "filefinder.h"
+#include "filesystem_native.h"
+#include "output.h"
+#include "platform.h"
+#include "player.h"
+#include "worker_pool.h"
+
+#include <deque>
+#include <memory>
+#include <sstream>
+#include <lcf/lsd/reader.h>
+
+#ifdef HAVE_THREADS
+#  include <condition_variable>
+#  include <mutex>
+#endif
+
+namespace {
+	struct Job {
+		FilesystemView fs;
+		std::string filename;
+		/** Full path of fs when the worker can write to it */
+		std::string native_path;
+		lcf::rpg::Save save;
+		lcf::EngineVersion engine = lcf::EngineVersion::e2k;
+		std::string encoding;
+		std::function<void(bool)> on_done;
+
+		/** Serialized save, written by the main thread when not written by the worker */
+		std::string data;
+		bool success = false;
+		bool written = false;
+		bool done = false;
+	};
+
+	// Unfinished saves, in the order they were requested
+	std::deque<std::shared_ptr<Job>> jobs;
+	// Saves the worker did not serialize yet. The jobs keep them alive.
+	std::deque<Job*> queue;
+	bool worker_active = false;
+	// A native write failed: The main thread writes that save later, so the
+	// following saves must not be written before it
+	bool native_failed = false;
+
+#ifdef HAVE_THREADS
+	std::mutex mutex;
+	std::condition_variable done_cv;
+
+	std::unique_lock<std::mutex> Lock() {
+		return std::unique_lock<std::mutex>(mutex);
+	}
+#else
+	struct NoLock {
+		~NoLock() {}
+	};
+
+	NoLock Lock() {
+		return {};
+	}
+#endif
+
+	/** Same check as the game scanner: Native directories can be opened a second time */
+	std::string GetNativePath(const FilesystemView& fs) {
+		if (fs.GetOwner().GetParent()) {
+			return {};
+		}
+
+		std::string path = FileFinder::GetFullFilesystemPath(fs);
+		if (path.empty() || !Platform::File(path).IsDirectory(true)) {
+			return {};
+		}
+		return path;
+	}
+
+	/** Writes to a temporary file first, a crash never leaves a truncated save behind. */
+	bool WriteNative(const Job& job) {
+		// The filesystem of the job is owned by the main thread
+		auto native_fs = std::make_shared<NativeFilesystem>("", FilesystemView());
+		const std::string tmp_name = job.filename + ".tmp";
+		Platform::File tmp_file(FileFinder::MakePath(job.native_path, tmp_name));
+
+		bool written = false;
+		{
+			auto out = native_fs->Create(job.native_path).OpenOutputStream(tmp_name, std::ios_base::binary | std::ios_base::out | std::ios_base::trunc);
+			if (out) {
+				out.write(job.data.data(), job.data.size());
+				out.flush();
+				written = out.good();
+			}
+		}
+
+		if (written && tmp_file.MoveTo(FileFinder::MakePath(job.native_path, job.filename))) {
+			return true;
+		}
+
+		// The main thread writes the save instead, no leftover in the save directory
+		if (tmp_file.Exists()) {
+			tmp_file.Remove();
+		}
+		return false;
+	}
+
+	void Serialize(Job& job) {
+		std::ostringstream ss;
+		job.success = lcf::LSD_Reader::Save(ss, job.save, job.engine, job.encoding);
+		job.save = {};
+
+		if (!job.success) {
+			return;
+		}
+
+		job.data = ss.str();
+
+		bool native = !job.native_path.empty();
+		if (native) {
+			auto lk = Lock();
+			native = !native_failed;
+		}
+		if (native) {
+			// On failure the main thread tries again
+			job.written = WriteNative(job);
+			if (!job.written) {
+				auto lk = Lock();
+				native_failed = true;
+			}
+		}
+	}
+
+	void Finish(Job& job) {
+		if (job.written) {
+			// Written through another filesystem instance
+			job.fs.ClearCache();
+		} else if (job.success) {
+			auto out = job.fs.OpenOutputStream(job.filename);
+			if (out) {
+				out.write(job.data.data(), job.data.size());
+				out.flush();
+			}
+			job.success = out.good();
+		}
+
+		if (!job.success) {
+			Output::Warning("Failed saving to {}", job.filename);
+		}
+
+		if (job.on_done) {
+			job.on_done(job.success);
+		}
+	}
+
+	void Work() {
+		while (true) {
+			Job* job;
+			{
+				auto lk = Lock();
+				if (queue.empty()) {
+					worker_active = false;
+					return;
+				}
+				job = queue.front();
+				queue.pop_front();
+			}
+
+			Serialize(*job);
+
+			auto lk = Lock();
+			job->done = true;
+#ifdef HAVE_THREADS
+			done_cv.notify_all();
+#endif
+		}
+	}
+}
+
+void SaveWriter::Write(FilesystemView fs, std::string filename, lcf::rpg::Save save, std::function<void(bool)> on_done) {
+	auto job = std::make_shared<Job>();
+	job->fs = std::move(fs);
+	job->filename = std::move(filename);
+	job->save = std::move(save);
+	job->engine = Player::IsRPG2k3() ? lcf::EngineVersion::e2k3 : lcf::EngineVersion::e2k;
+	job->encoding = Player::encoding;
+	job->on_done = std::move(on_done);
+
+	if (WorkerPool::GetNumWorkers() == 0) {
+		Serialize(*job);
+		Finish(*job);
+		return;
+	}
+
+	job->native_path = GetNativePath(job->fs);
+	jobs.push_back(job);
+
+	auto lk = Lock();
+	queue.push_back(job.get());
+	if (!worker_active) {
+		// One task for all saves: A slot is never written by two workers at once
+		worker_active = true;
+		WorkerPool::Submit(Work);
+	}
+}
+
+void SaveWriter::Update() {
+	while (!jobs.empty()) {
+		{
+			auto lk = Lock();
+			if (!jobs.front()->done) {
+				return;
+			}
+		}
+
+		// on_done can request another save
+		auto job = std::move(jobs.front());
+		jobs.pop_front();
+		Finish(*job);
+	}
+
+	// All fallback writes are done
+	auto lk = Lock();
+	native_failed = false;
+}
+
+bool SaveWriter::IsPending() {
+	return !jobs.empty();
+}
+
+void SaveWriter::Flush() {
+#ifdef HAVE_THREADS
+	if (!jobs.empty()) {
+		Job* last = jobs.back().get();
+		auto lk = Lock();
+		done_cv.wait(lk, [&]() { return last->done; });
+	}
+#endif
+	Update();
+}
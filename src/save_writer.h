@@ -0,0 +1,61 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_SAVE_WRITER_H
+#define EP_SAVE_WRITER_H
+
+#include <functional>
+#include <string>
+#include <lcf/rpg/save.h>
+#include "filesystem.h"
+
+/**
+ * Writes save files without blocking the main loop.
+ *
+ * The caller creates a snapshot of the game state on the main thread. A
+ * worker serializes it. When the save directory is on the native filesystem
+ * the worker also writes a temporary file, syncs it to the disk and replaces
+ * the save file with it. Other filesystems are not thread-safe, the main
+ * thread writes the serialized data to them in Update.
+ *
+ * Saves are finished in the order they were requested. After a failed write
+ * of the worker all following saves are written by the main thread until
+ * the failed save is written. Without worker threads the save is written
+ * before Write returns.
+ */
+namespace SaveWriter {
+	/**
+	 * Starts writing a save file.
+	 *
+	 * @param fs save directory
+	 * @param filename name of the save file in fs
+	 * @param save snapshot of the game state
+	 * @param on_done invoked on the main thread with the result after the file was written
+	 */
+	void Write(FilesystemView fs, std::string filename, lcf::rpg::Save save, std::function<void(bool)> on_done);
+
+	/** Finishes the saves which were serialized by the worker. Called every frame. */
+	void Update();
+
+	/** @return whether a save is not finished yet */
+	bool IsPending();
+
+	/** Blocks until all saves are finished. */
+	void Flush();
+}
+
+#endif
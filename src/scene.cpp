@@ -237,8 +237,7 @@ void Scene::OnFinishAsync() {
 }
 
 bool Scene::IsAsyncPending() {
-	return Transition::instance().IsActive() || AsyncHandler::IsImportantFilePending()
-		|| (instance != nullptr && instance->HasDelayFrames());
+	return Transition::instance().IsActive() || AsyncHandler::IsImportantFilePending() || (instance != nullptr && instance->HasDelayFrames());
 }
 
 void Scene::Update() {
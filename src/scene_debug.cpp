@@ -19,6 +19,7 @@
 #include <vector>
 #include <sstream>
 #include <cmath>
+#include <chrono>
 #include <iomanip>
 #include "baseui.h"
 #include "cache.h"
@@ -42,6 +43,9 @@
 #include "bitmap.h"
 #include "game_party.h"
 #include "game_player.h"
+#include "interpreter_profiler.h"
+#include "filefinder.h"
+#include "async_handler.h"
 #include <lcf/data.h>
 #include "output.h"
 #include "transition.h"
@@ -287,8 +291,10 @@ void Scene_Debug::PushUiChoices(std::vector<std::string> choices, std::vector<bo
 void Scene_Debug::PushUiStringView() {
 	const auto str_id = GetFrame().value;
 
-	auto value = ToString(Main_Data::game_strings->Get(str_id));
+	PushUiStringView(ToString(Main_Data::game_strings->Get(str_id)));
+}
 
+void Scene_Debug::PushUiStringView(std::string value) {
 	if (value.empty()) {
 		Main_Data::game_system->SePlay(Main_Data::game_system->GetSystemSE(Main_Data::game_system->SFX_Buzzer));
 		return;
@@ -649,6 +655,19 @@ void Scene_Debug::vUpdate() {
 					UpdateInterpreterWindow(GetSelectedIndexFromRange());
 				}
 				break;
+			case eProfiler:
+				if (sz == 2) {
+					DoProfiler();
+				} else if (sz == 1) {
+					PushUiChoices({
+						InterpreterProfiler::IsEnabled() ? "Stop" : "Start",
+						"Show Results",
+						"Write CSV",
+						"Write Folded",
+						"Reset"
+					}, { true, true, true, true, true });
+				}
+				break;
 			case eOpenMenu:
 				DoOpenMenu();
 				break;
@@ -735,6 +754,7 @@ void Scene_Debug::UpdateRangeListWindow() {
 				addItem("Call BtlEvent", is_battle);
 				addItem("Strings", Player::IsPatchManiac());
 				addItem("Interpreter");
+				addItem(InterpreterProfiler::IsEnabled() ? "Profiler (On)" : "Profiler");
 				addItem("Open Menu", !is_battle);
 			}
 			break;
@@ -1188,6 +1208,64 @@ void Scene_Debug::DoCallBattleEvent() {
 	Output::Debug("Debug Scene Forced execution of battle troop {} event page {} on the map foreground interpreter.", troop->ID, page.ID);
 }
 
+void Scene_Debug::DoProfiler() {
+	auto play_se = [](int se) {
+		Main_Data::game_system->SePlay(Main_Data::game_system->GetSystemSE(se));
+	};
+
+	auto write_file = [&](const char* filename, void (*write)(std::ostream&)) {
+		auto out = FileFinder::Save().OpenOutputStream(filename);
+		if (!out) {
+			Output::Warning("Debug Scene: Cannot write profiler results to {}", filename);
+			play_se(Main_Data::game_system->SFX_Buzzer);
+			return;
+		}
+		write(out);
+		out.Close();
+		AsyncHandler::SaveFilesystem();
+
+		Output::Debug("Debug Scene wrote profiler results to {}.", filename);
+		play_se(Main_Data::game_system->SFX_Decision);
+		Pop();
+	};
+
+	switch (GetFrame().value) {
+		case 0:
+			InterpreterProfiler::SetEnabled(!InterpreterProfiler::IsEnabled());
+			play_se(Main_Data::game_system->SFX_Decision);
+			Pop();
+			break;
+		case 1: {
+			// Most expensive commands first
+			auto stats_list = InterpreterProfiler::GetStats();
+			if (stats_list.size() > 100) {
+				stats_list.resize(100);
+			}
+
+			std::string report;
+			for (auto& stats: stats_list) {
+				const auto& frame = stats.frame;
+				report += fmt::format("{} #{} ({}) {}us x{}\n",
+					InterpreterProfiler::GetFrameName(frame), frame.command_index, frame.code,
+					std::chrono::duration_cast<std::chrono::microseconds>(stats.time).count(), stats.count);
+			}
+			PushUiStringView(std::move(report));
+			break;
+		}
+		case 2:
+			write_file("profile.csv", InterpreterProfiler::WriteCsv);
+			break;
+		case 3:
+			write_file("profile.folded", InterpreterProfiler::WriteFolded);
+			break;
+		case 4:
+			InterpreterProfiler::Reset();
+			play_se(Main_Data::game_system->SFX_Decision);
+			Pop();
+			break;
+	}
+}
+
 void Scene_Debug::DoOpenMenu() {
 	if (Scene::Find(Scene::Menu)) {
 		Scene::PopUntil(Scene::Menu);
@@ -1227,12 +1305,12 @@ void Scene_Debug::CacheBackgroundInterpreterStates() {
 			if (ev.GetTrigger() != lcf::rpg::EventPage::Trigger_parallel || !ev.interpreter)
 				continue;
 			state_interpreter.ev.emplace_back(ev.GetId());
-			state_interpreter.state_ev.emplace_back(ev.interpreter->GetState());
+			state_interpreter.state_ev.emplace_back(ev.interpreter->GetSaveState());
 		}
 		for (auto& ce : Game_Map::GetCommonEvents()) {
 			if (ce.IsWaitingBackgroundExecution(false)) {
 				state_interpreter.ce.emplace_back(ce.common_event_id);
-				state_interpreter.state_ce.emplace_back(ce.interpreter->GetState());
+				state_interpreter.state_ce.emplace_back(ce.interpreter->GetSaveState());
 			}
 		}
 	} else if (Game_Battle::IsBattleRunning() && Player::IsPatchManiac()) {
@@ -1247,7 +1325,7 @@ void Scene_Debug::UpdateInterpreterWindow(int index) {
 	int evt_id = 0;
 
 	if (index == 1) {
-		state = Game_Interpreter::GetForegroundInterpreter().GetState();
+		state = Game_Interpreter::GetForegroundInterpreter().GetSaveState();
 		first_line = Game_Battle::IsBattleRunning() ? "Foreground (Battle)" : "Foreground (Map)";
 		valid = true;
 	} else if (index <= state_interpreter.ev.size()) {
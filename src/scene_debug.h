@@ -72,6 +72,7 @@ public:
 		eCallBattleEvent,
 		eString,
 		eInterpreter,
+		eProfiler,
 		eOpenMenu,
 		eLastMainMenuOption,
 	};
@@ -134,6 +135,7 @@ private:
 	void DoCallCommonEvent();
 	void DoCallMapEvent();
 	void DoCallBattleEvent();
+	void DoProfiler();
 	void DoOpenMenu();
 
 	const int choice_window_width = 120;
@@ -172,6 +174,7 @@ private:
 	void PushUiNumberInput(int init_value, int digits, bool show_operator);
 	void PushUiChoices(std::vector<std::string> choices, std::vector<bool> choices_enabled);
 	void PushUiStringView();
+	void PushUiStringView(std::string value);
 	void PushUiInterpreterView();
 
 	Window_VarList::Mode GetWindowMode() const;
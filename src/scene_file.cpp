@@ -27,6 +27,7 @@
 #include "input.h"
 #include <lcf/lsd/reader.h>
 #include "player.h"
+#include "save_writer.h"
 #include "scene_file.h"
 #include "bitmap.h"
 #include <lcf/reader_util.h>
@@ -121,6 +122,8 @@ void Scene_File::Start() {
 	border_top = Scene_File::MakeBorderSprite(32);
 
 	// Refresh File Finder Save Folder
+	// Saves still written in the background must show up
+	SaveWriter::Flush();
 	fs = FileFinder::Save();
 
 	for (int i = 0; i < Utils::Clamp<int32_t>(lcf::Data::system.easyrpg_max_savefiles, 3, 99); i++) {
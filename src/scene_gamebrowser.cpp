@@ -24,15 +24,21 @@
 #include "audio_midi.h"
 #include "audio_secache.h"
 #include "cache.h"
+#include "map_file_cache.h"
 #include "game_system.h"
 #include "input.h"
 #include "player.h"
 #include "scene_logo.h"
 #include "scene_title.h"
 #include "bitmap.h"
+#include "bitmap_pool.h"
 #include "audio.h"
 #include "output.h"
 
+namespace {
+	constexpr const char* default_help_text = "EasyRPG Player - RPG Maker 2000/2003 interpreter";
+}
+
 Scene_GameBrowser::Scene_GameBrowser() {
 	type = Scene::GameBrowser;
 }
@@ -51,6 +57,8 @@ void Scene_GameBrowser::Continue(SceneType /* prev_scene */) {
 
 	Cache::ClearAll();
 	AudioSeCache::Clear();
+	MapFileCache::Clear();
+	BitmapPool::Clear();
 	MidiDecoder::Reset();
 	lcf::Data::Clear();
 	Main_Data::Cleanup();
@@ -106,7 +114,18 @@ void Scene_GameBrowser::CreateWindows() {
 	}
 
 	help_window = std::make_unique<Window_Help>(0, 0, Player::screen_width, 32);
-	help_window->SetText("EasyRPG Player - RPG Maker 2000/2003 interpreter");
+	help_window->SetText(default_help_text);
+
+	// Show the title of the selected game when it is known
+	gamelist_window->SetHelpWindow(help_window.get());
+	gamelist_window->UpdateHelpFn = [this](Window_Help& win, int index) {
+		const auto* info = gamelist_window->GetGameInfo(index);
+		if (info && !info->title.empty()) {
+			win.SetText(info->title);
+		} else {
+			win.SetText(default_help_text);
+		}
+	};
 
 	load_window = std::make_unique<Window_Help>(Player::screen_width / 4, Player::screen_height / 2 - 16, Player::screen_width / 2, 32);
 	load_window->SetText("Loading...");
@@ -166,6 +185,7 @@ void Scene_GameBrowser::UpdateGameListSelection() {
 		gamelist_window->SetActive(false);
 		old_gamelist_index = gamelist_window->GetIndex();
 		gamelist_window->SetIndex(-1);
+		help_window->SetText(default_help_text);
 	} else if (Input::IsTriggered(Input::DECISION)) {
 		load_window->SetVisible(true);
 		game_loading = true;
@@ -213,6 +233,7 @@ void Scene_GameBrowser::BootGame() {
 		return;
 	}
 
+	FileFinder::LoadDirectoryIndex(fs);
 	FileFinder::SetGameFilesystem(fs);
 	Player::CreateGameObjects();
 
@@ -134,6 +134,8 @@ bool Scene_Logo::DetectGame() {
 		FileFinder::SetGameFilesystem(fs);
 	}
 
+	FileFinder::LoadDirectoryIndex(fs);
+
 #ifdef EMSCRIPTEN
 	static bool once = true;
 	if (once) {
@@ -400,11 +400,13 @@ void Scene_Map::OnAsyncSuspend(F&& f, AsyncOp aop, bool is_preupdate) {
 
 	if (aop.GetType() == AsyncOp::eSave) {
 		auto savefs = FileFinder::Save();
-		bool success = Scene_Save::Save(savefs, aop.GetSaveSlot());
-		if (aop.GetSaveResultVar() > 0) {
-			Main_Data::game_variables->Set(aop.GetSaveResultVar(), success ? 1 : 0);
-			Game_Map::SetNeedRefresh(true);
-		}
+		// The interpreter that issued the save waits until it is written
+		Scene_Save::Save(savefs, aop.GetSaveSlot(), true, [var_id = aop.GetSaveResultVar()](bool success) {
+			if (var_id > 0) {
+				Main_Data::game_variables->Set(var_id, success ? 1 : 0);
+				Game_Map::SetNeedRefresh(true);
+			}
+		});
 	}
 
 	if (aop.GetType() == AsyncOp::eLoad) {
@@ -41,6 +41,7 @@
 #include <lcf/lsd/reader.h>
 #include "output.h"
 #include "player.h"
+#include "save_writer.h"
 #include "scene_save.h"
 #include "translation.h"
 #include "version.h"
@@ -76,21 +77,33 @@ std::string Scene_Save::GetSaveFilename(const FilesystemView& fs, int slot_id) {
 	return filename;
 }
 
-bool Scene_Save::Save(const FilesystemView& fs, int slot_id, bool prepare_save) {
+void Scene_Save::Save(const FilesystemView& fs, int slot_id, bool prepare_save, std::function<void(bool)> on_done) {
 	const auto filename = GetSaveFilename(fs, slot_id);
 	Output::Debug("Saving to {}", filename);
 
-	auto save_stream = FileFinder::Save().OpenOutputStream(filename);
+	auto save = CreateSaveData(slot_id, prepare_save);
+	DynRpg::Save(slot_id);
 
-	if (!save_stream) {
-		Output::Warning("Failed saving to {}", filename);
-		return false;
-	}
+	SaveWriter::Write(fs, filename, std::move(save), [on_done = std::move(on_done)](bool success) {
+		AsyncHandler::SaveFilesystem();
 
-	return Save(save_stream, slot_id, prepare_save);
+		if (on_done) {
+			on_done(success);
+		}
+	});
 }
 
 bool Scene_Save::Save(std::ostream& os, int slot_id, bool prepare_save) {
+	auto lcf_engine = Player::IsRPG2k3() ? lcf::EngineVersion::e2k3 : lcf::EngineVersion::e2k;
+	bool res = lcf::LSD_Reader::Save(os, CreateSaveData(slot_id, prepare_save), lcf_engine, Player::encoding);
+
+	DynRpg::Save(slot_id);
+	AsyncHandler::SaveFilesystem();
+
+	return res;
+}
+
+lcf::rpg::Save Scene_Save::CreateSaveData(int slot_id, bool prepare_save) {
 	lcf::rpg::Save save;
 	auto& title = save.title;
 	// TODO: Maybe find a better place to setup the save file?
@@ -153,13 +166,8 @@ bool Scene_Save::Save(std::ostream& os, int slot_id, bool prepare_save) {
 			sme.map_id = 0;
 		}
 	}
-	auto lcf_engine = Player::IsRPG2k3() ? lcf::EngineVersion::e2k3 : lcf::EngineVersion::e2k;
-	bool res = lcf::LSD_Reader::Save(os, save, lcf_engine, Player::encoding);
 
-	DynRpg::Save(slot_id);
-	AsyncHandler::SaveFilesystem();
-
-	return res;
+	return save;
 }
 
 bool Scene_Save::IsSlotValid(int) {
@@ -19,7 +19,9 @@
 #define EP_SCENE_SAVE_H
 
 // Headers
+#include <functional>
 #include <vector>
+#include <lcf/rpg/save.h>
 #include "scene.h"
 #include "scene_file.h"
 
@@ -40,8 +42,25 @@ public:
 	bool IsSlotValid(int index) override;
 
 	static std::string GetSaveFilename(const FilesystemView& tree, int slot_id);
-	static bool Save(const FilesystemView& tree, int slot_id, bool prepare_save = true);
+
+	/**
+	 * Saves the game. The game state is copied immediately, the file is
+	 * written in the background by the SaveWriter.
+	 *
+	 * @param tree save directory
+	 * @param slot_id save slot
+	 * @param prepare_save whether to update the save metadata (timestamp, save count)
+	 * @param on_done invoked on the main thread with the result after the file was written
+	 */
+	static void Save(const FilesystemView& tree, int slot_id, bool prepare_save = true, std::function<void(bool)> on_done = {});
 	static bool Save(std::ostream& os, int slot_id, bool prepare_save = true);
+
+	/**
+	 * @param slot_id save slot
+	 * @param prepare_save whether to update the save metadata (timestamp, save count)
+	 * @return snapshot of the game state
+	 */
+	static lcf::rpg::Save CreateSaveData(int slot_id, bool prepare_save);
 };
 
 #endif
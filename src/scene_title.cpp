@@ -36,6 +36,7 @@
 #include "meta.h"
 #include "output.h"
 #include "player.h"
+#include "save_writer.h"
 #include "translation.h"
 #include "scene_battle.h"
 #include "scene_import.h"
@@ -195,6 +196,7 @@ void Scene_Title::vUpdate() {
 
 void Scene_Title::Refresh() {
 	// Enable load game if available
+	SaveWriter::Flush();
 	continue_enabled = FileFinder::HasSavegame();
 	if (continue_enabled) {
 		command_window->SetIndex(1);
@@ -0,0 +1,45 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Headers
+#include "screen_tone.h"
+#include "bitmap.h"
+#include "drawable_mgr.h"
+
+ScreenTone::ScreenTone() : Drawable(Priority_Weather - 1)
+{
+	DrawableMgr::Register(this);
+}
+
+void ScreenTone::Draw(Bitmap& dst) {
+	if (tone == Tone()) {
+		return;
+	}
+
+	Rect dst_rect = dst.GetRect();
+	if (rect != Rect()) {
+		dst_rect = rect;
+		dst_rect.Adjust(dst.GetWidth(), dst.GetHeight());
+	}
+
+	if (dst_rect.width <= 0 || dst_rect.height <= 0) {
+		return;
+	}
+
+	// Tints the image in place
+	dst.ToneBlit(dst_rect.x, dst_rect.y, dst, dst_rect, tone, Opacity::Opaque());
+}
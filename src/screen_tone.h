@@ -0,0 +1,87 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_SCREEN_TONE_H
+#define EP_SCREEN_TONE_H
+
+// Headers
+#include "drawable.h"
+#include "rect.h"
+#include "tone.h"
+
+class Bitmap;
+
+/**
+ * A drawable that tints everything below it in a single pass.
+ *
+ * While the screen tint fades the map uses this instead of handing the
+ * tone to the tilemap, the panorama and every sprite. Those would create
+ * new tinted copies of their graphics every frame.
+ * Only a tone that scales the color channels down (red, green and blue
+ * <= 128, no saturation change) gives the same result when the composited
+ * image is tinted instead of every layer before blending, up to rounding.
+ *
+ * The z index is directly below the weather, which tints itself.
+ */
+class ScreenTone : public Drawable {
+public:
+	ScreenTone();
+
+	void Draw(Bitmap& dst) override;
+
+	/**
+	 * @param tone tone to apply
+	 * @return Whether tinting the composited image matches tinting every layer
+	 */
+	static bool IsComposable(const Tone& tone);
+
+	Tone GetTone() const;
+	void SetTone(Tone tone);
+
+	/** @return area that is tinted, empty for the whole screen */
+	Rect GetRect() const;
+	void SetRect(const Rect& rect);
+
+private:
+	Tone tone;
+	Rect rect;
+};
+
+inline bool ScreenTone::IsComposable(const Tone& tone) {
+	// Hard light with a source <= 128 multiplies the color, which commutes
+	// with alpha blending and keeps black areas where nothing is drawn black.
+	// Saturation depends on the luminance of every single layer.
+	return tone.red <= 128 && tone.green <= 128 && tone.blue <= 128 && tone.gray == 128;
+}
+
+inline Tone ScreenTone::GetTone() const {
+	return tone;
+}
+
+inline void ScreenTone::SetTone(Tone tone) {
+	this->tone = tone;
+}
+
+inline Rect ScreenTone::GetRect() const {
+	return rect;
+}
+
+inline void ScreenTone::SetRect(const Rect& rect) {
+	this->rect = rect;
+}
+
+#endif
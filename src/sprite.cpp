@@ -16,6 +16,9 @@
  */
 
 // Headers
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <string>
 #include "sprite.h"
 #include "player.h"
@@ -37,18 +40,110 @@ void Sprite::Draw(Bitmap& dst) {
 	BlitScreen(dst);
 }
 
+Drawable::Bounds Sprite::GetBounds(const Bitmap&) {
+	Bounds bounds;
+	bounds.known = true;
+
+	if (GetWidth() <= 0 || GetHeight() <= 0 || !bitmap || (opacity_top_effect <= 0 && opacity_bottom_effect <= 0)) {
+		// Draws nothing
+		return bounds;
+	}
+
+	const int w = GetWidth();
+	const int h = GetHeight();
+	const int draw_ox = ox - GetRenderOx();
+	const int draw_oy = oy - GetRenderOy();
+
+	const bool rotate = angle_effect != 0.0;
+	const bool scale = zoom_x_effect != 1.0 || zoom_y_effect != 1.0;
+	const bool waver = waver_effect_depth != 0;
+
+	if (rotate) {
+		// Circle around the rotation center containing every corner
+		double dx = std::max(std::abs(draw_ox), std::abs(w - draw_ox)) * std::abs(zoom_x_effect);
+		double dy = std::max(std::abs(draw_oy), std::abs(h - draw_oy)) * std::abs(zoom_y_effect);
+		int r = static_cast<int>(std::ceil(std::sqrt(dx * dx + dy * dy))) + 1;
+		bounds.rect = Rect(x - r, y - r, 2 * r, 2 * r);
+		return bounds;
+	}
+
+	int left = x - static_cast<int>(std::floor(draw_ox * zoom_x_effect));
+	int top = y - static_cast<int>(std::floor(draw_oy * zoom_y_effect));
+	int width = static_cast<int>(std::ceil(w * zoom_x_effect));
+	int height = static_cast<int>(std::ceil(h * zoom_y_effect));
+
+	if (waver) {
+		// Lines are shifted horizontally by up to the waver depth
+		bounds.rect = Rect(left - waver_effect_depth - 1, top, width + 2 * waver_effect_depth + 2, height);
+		return bounds;
+	}
+
+	bounds.rect = Rect(left, top, width, height);
+
+	// Only a plain copy of an opaque image replaces every pixel of the rect
+	const bool full_opacity = opacity_top_effect >= 255 && (bush_effect <= 0 || opacity_bottom_effect >= 255);
+	const auto blend_mode = static_cast<Bitmap::BlendMode>(blend_type_effect);
+	const bool plain_blend = blend_mode == Bitmap::BlendMode::Default || blend_mode == Bitmap::BlendMode::Normal;
+	const bool inside_bitmap = src_rect.x >= 0 && src_rect.y >= 0 &&
+		src_rect.x + w <= bitmap->GetWidth() && src_rect.y + h <= bitmap->GetHeight();
+
+	if (!scale && full_opacity && plain_blend && inside_bitmap &&
+			src_rect_effect.GetSubRect(src_rect) == src_rect &&
+			bitmap->GetImageOpacity() == ImageOpacity::Opaque) {
+		bounds.opacity = ImageOpacity::Opaque;
+	}
+
+	return bounds;
+}
+
 void Sprite::BlitScreen(Bitmap& dst) {
-	if (!bitmap || (opacity_top_effect <= 0 && opacity_bottom_effect <= 0))
+	BitmapRef draw_bitmap;
+	Rect rect;
+	if (!PrepareBlit(draw_bitmap, rect)) {
 		return;
+	}
 
-	BitmapRef draw_bitmap = Refresh(src_rect_effect);
+	BlitScreenIntern(dst, *draw_bitmap, rect);
+}
+
+bool Sprite::GetPlainBlit(BatchBlit& blit) {
+	if (zoom_x_effect != 1.0 || zoom_y_effect != 1.0 || angle_effect != 0.0 || waver_effect_depth != 0) {
+		return false;
+	}
+
+	if (bush_effect > 0 && opacity_top_effect != opacity_bottom_effect) {
+		return false;
+	}
+
+	blit = {};
+
+	BitmapRef draw_bitmap;
+	Rect rect;
+	if (GetWidth() <= 0 || GetHeight() <= 0 || !PrepareBlit(draw_bitmap, rect)) {
+		return true;
+	}
+
+	blit.src = draw_bitmap.get();
+	blit.src_rect = rect;
+	blit.x = x - (ox - GetRenderOx());
+	blit.y = y - (oy - GetRenderOy());
+	blit.opacity = opacity_top_effect;
+	blit.blend_mode = blend_type_effect;
+	return true;
+}
+
+bool Sprite::PrepareBlit(BitmapRef& draw_bitmap, Rect& rect) {
+	if (!bitmap || (opacity_top_effect <= 0 && opacity_bottom_effect <= 0))
+		return false;
+
+	draw_bitmap = Refresh(src_rect_effect);
 	if (!draw_bitmap) {
-		return;
+		return false;
 	}
 
 	bitmap_changed = false;
 
-	Rect rect = src_rect_effect.GetSubRect(src_rect);
+	rect = src_rect_effect.GetSubRect(src_rect);
 	if (draw_bitmap == bitmap_effects) {
 		// When a "sprite rect" (src_rect_effect) is used bitmap_effects
 		// only has the size of this subrect instead of the whole bitmap
@@ -64,7 +159,7 @@ void Sprite::BlitScreen(Bitmap& dst) {
 		}
 	}
 
-	BlitScreenIntern(dst, *draw_bitmap, rect);
+	return true;
 }
 
 void Sprite::BlitScreenIntern(Bitmap& dst, Bitmap const& draw_bitmap, Rect const& src_rect) const
@@ -34,6 +34,12 @@ public:
 
 	void Draw(Bitmap& dst) override;
 
+	/**
+	 * Computes the bounds from the current state of the sprite.
+	 * Subclasses which change the sprite in Draw must override this.
+	 */
+	Bounds GetBounds(const Bitmap& dst) override;
+
 	virtual int GetWidth() const;
 	virtual int GetHeight() const;
 
@@ -103,6 +109,16 @@ public:
 	 */
 	void SetFlashEffect(const Color &color);
 
+protected:
+	/**
+	 * Describes the drawing as a plain blit when no zoom, rotation, waver
+	 * or bush depth is active. Subclasses can use this for GetBatchBlit.
+	 *
+	 * @param blit receives the blit when returning true
+	 * @return false when the sprite must be drawn with Draw
+	 */
+	bool GetPlainBlit(BatchBlit& blit);
+
 private:
 	BitmapRef bitmap;
 
@@ -139,6 +155,7 @@ private:
 	bool bitmap_changed = true;
 
 	void BlitScreen(Bitmap& dst);
+	bool PrepareBlit(BitmapRef& draw_bitmap, Rect& rect);
 	void BlitScreenIntern(Bitmap& dst, Bitmap const& draw_bitmap,
 							Rect const& src_rect) const;
 	BitmapRef Refresh(Rect& rect);
@@ -55,6 +55,18 @@ void Sprite_AirshipShadow::RecreateShadow() {
 }
 
 void Sprite_AirshipShadow::Draw(Bitmap &dst) {
+	UpdateDrawState();
+
+	Sprite::Draw(dst);
+}
+
+Drawable::Bounds Sprite_AirshipShadow::GetBounds(const Bitmap& dst) {
+	UpdateDrawState();
+
+	return Sprite::GetBounds(dst);
+}
+
+void Sprite_AirshipShadow::UpdateDrawState() {
 	Game_Vehicle* airship = Game_Map::GetVehicle(Game_Vehicle::Airship);
 	const int altitude = airship->GetAltitude();
 	const int max_altitude = TILE_SIZE;
@@ -63,8 +75,6 @@ void Sprite_AirshipShadow::Draw(Bitmap &dst) {
 
 	SetX(Main_Data::game_player->GetScreenX() + x_offset);
 	SetY(Main_Data::game_player->GetScreenY() + y_offset + Main_Data::game_player->GetJumpHeight());
-
-	Sprite::Draw(dst);
 }
 
 void Sprite_AirshipShadow::Update() {
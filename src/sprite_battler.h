@@ -63,6 +63,9 @@ public:
 	 */
 	virtual void ResetZ();
 
+	/** Unknown, the sprite is changed in Draw */
+	Bounds GetBounds(const Bitmap& dst) override { return Drawable::GetBounds(dst); }
+
 protected:
 	Game_Battler* battler = nullptr;
 	int battle_index = 0;
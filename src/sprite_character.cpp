@@ -36,6 +36,24 @@ Sprite_Character::Sprite_Character(Game_Character* character, int x_offset, int
 }
 
 void Sprite_Character::Draw(Bitmap &dst) {
+	UpdateDrawState();
+
+	Sprite::Draw(dst);
+}
+
+Drawable::Bounds Sprite_Character::GetBounds(const Bitmap& dst) {
+	UpdateDrawState();
+
+	return Sprite::GetBounds(dst);
+}
+
+bool Sprite_Character::GetBatchBlit(BatchBlit& blit) {
+	UpdateDrawState();
+
+	return GetPlainBlit(blit);
+}
+
+void Sprite_Character::UpdateDrawState() {
 	if (UsesCharset()) {
 		int row = character->GetFacing();
 		auto frame = character->GetAnimFrame();
@@ -52,8 +70,6 @@ void Sprite_Character::Draw(Bitmap &dst) {
 
 	int bush_split = 4 - character->GetBushDepth();
 	SetBushDepth(bush_split > 3 ? 0 : GetHeight() / bush_split);
-
-	Sprite::Draw(dst);
 }
 
 void Sprite_Character::Update() {
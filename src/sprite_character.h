@@ -43,6 +43,10 @@ public:
 
 	void Draw(Bitmap& dst) override;
 
+	Bounds GetBounds(const Bitmap& dst) override;
+
+	bool GetBatchBlit(BatchBlit& blit) override;
+
 	/**
 	 * Updates sprite state.
 	 */
@@ -95,6 +99,9 @@ private:
 	int y_offset = 0;
 	bool refresh_bitmap = false;
 
+	/** Applies the current state of the character to the sprite. */
+	void UpdateDrawState();
+
 	void OnTileSpriteReady(FileRequestResult*);
 	void OnCharSpriteReady(FileRequestResult*);
 
@@ -77,9 +77,8 @@ void Sprite_Enemy::OnMonsterSpriteReady(FileRequestResult* result) {
 
 	bool hue_change = hue != 0;
 	if (hue_change) {
-		BitmapRef new_graphic = Bitmap::Create(graphic->GetWidth(), graphic->GetHeight());
-		new_graphic->HueChangeBlit(0, 0, *graphic, graphic->GetRect(), hue);
-		graphic = new_graphic;
+		// Shared by all enemies of the troop with the same graphic and hue
+		graphic = Cache::HueChange(graphic, hue);
 	}
 
 	SetBitmap(graphic);
@@ -77,10 +77,35 @@ void Sprite_Picture::Draw(Bitmap& dst) {
 		window.window->Draw(*bitmap.get());
 	}
 
+	if (UpdateDrawState()) {
+		Sprite::Draw(dst);
+	}
+}
+
+Drawable::Bounds Sprite_Picture::GetBounds(const Bitmap& dst) {
+	if (!UpdateDrawState()) {
+		Bounds bounds;
+		bounds.known = true;
+		return bounds;
+	}
+
+	return Sprite::GetBounds(dst);
+}
+
+bool Sprite_Picture::UpdateDrawState() {
+	const auto& pic = Main_Data::game_pictures->GetPicture(pic_id);
+	const auto& data = pic.data;
+
+	auto& bitmap = GetBitmap();
+
+	if (!bitmap) {
+		return false;
+	}
+
 	const bool is_battle = Game_Battle::IsBattleRunning();
 
 	if (is_battle ? !pic.IsOnBattle() : !pic.IsOnMap()) {
-		return;
+		return false;
 	}
 
 	// RPG Maker 2k3 1.12: Spritesheets
@@ -166,10 +191,7 @@ void Sprite_Picture::Draw(Bitmap& dst) {
 	SetBlendType(data.easyrpg_blend_mode);
 
 	// Don't draw anything if zoom is at zero, helps avoid a glitchy rotated sprite in the top left corner
-	if (GetZoomX() <= 0.0 || GetZoomY() <= 0.0) {
-		return;
-	}
-	Sprite::Draw(dst);
+	return GetZoomX() > 0.0 && GetZoomY() > 0.0;
 }
 
 int Sprite_Picture::GetFrameWidth() const {
@@ -38,6 +38,9 @@ public:
 protected:
 	void Draw(Bitmap& dst) override;
 
+	/** Unknown, the sprite is changed in Draw */
+	Bounds GetBounds(const Bitmap& dst) override { return Drawable::GetBounds(dst); }
+
 	int which = 0;
 
 	Rect digits[5];
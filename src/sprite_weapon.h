@@ -54,6 +54,9 @@ public:
 
 	void Draw(Bitmap& dst) override;
 
+	/** Unknown, the sprite is changed in Draw */
+	Bounds GetBounds(const Bitmap& dst) override { return Drawable::GetBounds(dst); }
+
 protected:
 	void CreateSprite();
 	void OnBattleWeaponReady(FileRequestResult* result, int32_t weapon_index);
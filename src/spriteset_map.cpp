@@ -26,6 +26,7 @@
 #include "game_character.h"
 #include "game_player.h"
 #include "game_vehicle.h"
+#include "game_pictures.h"
 #include "game_screen.h"
 #include "bitmap.h"
 #include "player.h"
@@ -39,6 +40,7 @@ Spriteset_Map::Spriteset_Map() {
 	timer2 = std::make_unique<Sprite_Timer>(1);
 
 	screen = std::make_unique<Screen>();
+	screen_tone = std::make_unique<ScreenTone>();
 
 	if (Player::IsRPG2k3()) {
 		frame = std::make_unique<Frame>();
@@ -83,20 +85,15 @@ void Spriteset_Map::Refresh() {
 
 // Update
 void Spriteset_Map::Update() {
-	Tone new_tone = Main_Data::game_screen->GetTone();
-
 	tilemap->SetOx(Game_Map::GetDisplayX() / (SCREEN_TILE_SIZE / TILE_SIZE));
 	tilemap->SetOy(Game_Map::GetDisplayY() / (SCREEN_TILE_SIZE / TILE_SIZE));
-	tilemap->SetTone(new_tone);
 
 	for (const auto& character_sprite : character_sprites) {
 		character_sprite->Update();
-		character_sprite->SetTone(new_tone);
 	}
 
 	panorama->SetOx(Game_Map::Parallax::GetX());
 	panorama->SetOy(Game_Map::Parallax::GetY());
-	panorama->SetTone(new_tone);
 
 	Game_Vehicle* vehicle;
 	int map_id = Game_Map::GetMapId();
@@ -110,10 +107,33 @@ void Spriteset_Map::Update() {
 	}
 
 	for (auto& shadow : airship_shadows) {
-		shadow->SetTone(new_tone);
 		shadow->Update();
 	}
 
+	// The tone is set after the update, the pass depends on the graphics that are drawn
+	Tone new_tone = Main_Data::game_screen->GetTone();
+
+	if (UseScreenTonePass()) {
+		// Keep the area outside of small maps black
+		bool covers_screen = !panorama_name.empty() || Game_Map::LoopHorizontal() || Game_Map::LoopVertical();
+		screen_tone->SetRect(covers_screen ? Rect() : Rect{ map_render_ox, map_render_oy, map_tiles_x, map_tiles_y });
+		screen_tone->SetTone(new_tone);
+		new_tone = Tone();
+	} else {
+		screen_tone->SetTone(Tone());
+	}
+
+	tilemap->SetTone(new_tone);
+	panorama->SetTone(new_tone);
+
+	for (const auto& character_sprite : character_sprites) {
+		character_sprite->SetTone(new_tone);
+	}
+
+	for (auto& shadow : airship_shadows) {
+		shadow->SetTone(new_tone);
+	}
+
 	DynRpg::Update();
 }
 
@@ -207,6 +227,54 @@ bool Spriteset_Map::RequireClear(DrawableList& drawable_list) {
 	return true;
 }
 
+bool Spriteset_Map::UseScreenTonePass() const {
+	// A constant tone is cached by the tilemap and the sprites.
+	// Only the fade creates new tinted graphics every frame.
+	if (!Main_Data::game_screen->IsTintFading()) {
+		return false;
+	}
+
+	if (!ScreenTone::IsComposable(Main_Data::game_screen->GetTone())) {
+		return false;
+	}
+
+	// A flash is blended over the tinted graphic and must not be tinted
+	if (Main_Data::game_screen->GetFlashColor().alpha > 0) {
+		return false;
+	}
+
+	// The tone of a graphic with semi-transparent pixels is weighted by the alpha.
+	// Bitmaps that were not analyzed (e.g. tile events) are assumed to have them.
+	auto has_partial_alpha = [](const BitmapRef& bitmap) {
+		return bitmap && bitmap->GetImageOpacity() == ImageOpacity::Alpha_8Bit;
+	};
+
+	if (has_partial_alpha(tilemap->GetChipset())) {
+		return false;
+	}
+	if (!panorama_name.empty() && has_partial_alpha(panorama->GetBitmap())) {
+		return false;
+	}
+
+	for (const auto& character_sprite : character_sprites) {
+		if (character_sprite->GetCharacter()->GetFlashColor().alpha > 0) {
+			return false;
+		}
+		if (character_sprite->IsVisible() && has_partial_alpha(character_sprite->GetBitmap())) {
+			return false;
+		}
+	}
+
+	for (const auto& shadow : airship_shadows) {
+		if (shadow->IsVisible() && has_partial_alpha(shadow->GetBitmap())) {
+			return false;
+		}
+	}
+
+	// Pictures on map layers have their own tone and must not be tinted again
+	return !Main_Data::game_pictures->HasPictureBelow(screen_tone->GetZ());
+}
+
 void Spriteset_Map::CreateSprite(Game_Character* character, bool create_x_clone, bool create_y_clone) {
 	auto add_sprite = [&](auto&& chara) {
 		chara->SetRenderOx(map_render_ox);
@@ -24,6 +24,7 @@
 #include "frame.h"
 #include "plane.h"
 #include "screen.h"
+#include "screen_tone.h"
 #include "sprite_airshipshadow.h"
 #include "sprite_character.h"
 #include "sprite_timer.h"
@@ -101,9 +102,15 @@ protected:
 	std::unique_ptr<Sprite_Timer> timer1;
 	std::unique_ptr<Sprite_Timer> timer2;
 	std::unique_ptr<Screen> screen;
+	std::unique_ptr<ScreenTone> screen_tone;
 	std::unique_ptr<Frame> frame;
 
 	void CreateSprite(Game_Character* character, bool create_x_clone, bool create_y_clone);
+
+	/**
+	 * @return Whether the screen tone is applied to the composited map instead of every graphic
+	 */
+	bool UseScreenTonePass() const;
 	void CreateAirshipShadowSprite(bool create_x_clone, bool create_y_clone);
 
 	void OnTilemapSpriteReady(FileRequestResult*);
@@ -27,118 +27,291 @@
 
 #include <cctype>
 #include <iterator>
+#include <list>
+#include <unordered_map>
+
+namespace {
+	/** Pre-rendered text which is drawn with a single blit */
+	struct TextRun {
+		/** Rendered pixels, nullptr when nothing is visible */
+		BitmapRef bitmap;
+		/** Position of the bitmap relative to the drawing position */
+		Point offset;
+		/** Width reported by Text::GetSize, used for the alignment */
+		int width = 0;
+		/** Return value of Text::Draw */
+		Point advance;
+	};
+
+	struct RunKey {
+		uint32_t font = 0;
+		uint32_t exfont = 0;
+		Font::Style style;
+		std::string system;
+		int color = 0;
+		bool is_exfont = false;
+		std::string text;
+
+		bool operator==(const RunKey& o) const {
+			return font == o.font && exfont == o.exfont && color == o.color && is_exfont == o.is_exfont &&
+				style.size == o.style.size && style.bold == o.style.bold && style.italic == o.style.italic &&
+				style.draw_shadow == o.style.draw_shadow && style.draw_gradient == o.style.draw_gradient &&
+				style.color_offset == o.style.color_offset && style.letter_spacing == o.style.letter_spacing &&
+				text == o.text && system == o.system;
+		}
+	};
+
+	struct RunKeyHash {
+		size_t operator()(const RunKey& k) const {
+			size_t h = std::hash<std::string>()(k.text);
+			auto combine = [&](size_t v) { h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2); };
+			combine(k.font);
+			combine(std::hash<std::string>()(k.system));
+			combine(static_cast<size_t>(k.color));
+			combine(static_cast<size_t>(k.style.size));
+			return h;
+		}
+	};
 
-Point Text::Draw(Bitmap& dest, int x, int y, const Font& font, const Bitmap& system, int color, char32_t glyph, bool is_exfont) {
-	if (is_exfont) {
-		if (!font.IsStyleApplied()) {
-			return Font::exfont->Render(dest, x, y, system, color, glyph);
-		} else {
-			auto style = font.GetCurrentStyle();
-			auto style_guard = Font::exfont->ApplyStyle(style);
-			return Font::exfont->Render(dest, x, y, system, color, glyph);
+	struct RunEntry {
+		TextRun run;
+		std::list<const RunKey*>::iterator lru;
+	};
+
+	// Menus redraw the same strings and messages the same glyphs all the time
+	constexpr size_t max_run_bytes = 4 * 1024 * 1024;
+
+	std::unordered_map<RunKey, RunEntry, RunKeyHash> runs;
+	// Most recently used first
+	std::list<const RunKey*> runs_lru;
+	size_t run_bytes = 0;
+
+	size_t RunBytes(const TextRun& run) {
+		return run.bitmap ? run.bitmap->GetWidth() * run.bitmap->GetHeight() * 4 : 0;
+	}
+
+	/**
+	 * @return key for the text or false when the system graphic cannot be
+	 * identified
+	 */
+	bool MakeRunKey(RunKey& key, const Font& font, const Bitmap& system, int color, bool is_exfont) {
+		if (system.GetId().empty()) {
+			return false;
 		}
-	} else {
-		return font.Render(dest, x, y, system, color, glyph);
+
+		key.font = font.GetUniqueId();
+		key.exfont = Font::exfont ? Font::exfont->GetUniqueId() : 0;
+		key.style = font.GetCurrentStyle();
+		key.system = ToString(system.GetId());
+		key.color = color;
+		key.is_exfont = is_exfont;
+		return true;
 	}
-}
 
-Point Text::Draw(Bitmap& dest, int x, int y, const Font& font, Color color, char32_t glyph, bool is_exfont) {
-	if (is_exfont) {
-		if (!font.IsStyleApplied()) {
-			return Font::exfont->Render(dest, x, y, color, glyph);
-		} else {
-			auto style = font.GetCurrentStyle();
-			auto style_guard = Font::exfont->ApplyStyle(style);
-			return Font::exfont->Render(dest, x, y, color, glyph);
+	const TextRun* FindRun(const RunKey& key) {
+		auto it = runs.find(key);
+		if (it == runs.end()) {
+			return nullptr;
 		}
-	} else {
-		return font.Render(dest, x, y, color, glyph);
+
+		runs_lru.splice(runs_lru.begin(), runs_lru, it->second.lru);
+		return &it->second.run;
 	}
-}
 
-Point Text::Draw(Bitmap& dest, const int x, const int y, const Font& font, const Bitmap& system, const int color, StringView text, const Text::Alignment align) {
-	if (text.length() == 0) return { 0, 0 };
+	/**
+	 * Renders the text once and adds it to the cache.
+	 *
+	 * @param key cache key
+	 * @param size size of the text as reported by Text::GetSize
+	 * @param render draws the text at the passed position and returns the advance
+	 * @return the new run
+	 */
+	template <typename F>
+	const TextRun& AddRun(RunKey key, Rect size, F&& render) {
+		TextRun run;
+		run.width = size.width;
+
+		// Shadow and glyph offsets can exceed the reported size
+		const int pad = std::max(size.height, 12) + 2;
+		auto canvas = Bitmap::Create(size.width + pad * 2, size.height + pad * 2, true);
+		run.advance = render(*canvas, pad, pad);
+
+		auto rect = canvas->ComputeVisibleRect();
+		if (!rect.IsEmpty()) {
+			run.bitmap = Bitmap::Create(*canvas, rect, true);
+			run.offset = { rect.x - pad, rect.y - pad };
+		}
 
-	Rect dst_rect = Text::GetSize(font, text);
+		run_bytes += RunBytes(run);
 
-	const int ih = dst_rect.height;
+		auto ins = runs.emplace(std::move(key), RunEntry{ std::move(run), {} }).first;
+		runs_lru.push_front(&ins->first);
+		ins->second.lru = runs_lru.begin();
+
+		while (run_bytes > max_run_bytes && runs_lru.size() > 1) {
+			auto old = runs.find(*runs_lru.back());
+			run_bytes -= RunBytes(old->second.run);
+			runs_lru.pop_back();
+			runs.erase(old);
+		}
 
-	switch (align) {
-	case Text::AlignCenter:
-		dst_rect.x = x - dst_rect.width / 2; break;
-	case Text::AlignRight:
-		dst_rect.x = x - dst_rect.width; break;
-	case Text::AlignLeft:
-		dst_rect.x = x; break;
-	default: assert(false);
+		return ins->second.run;
 	}
 
-	dst_rect.y = y;
-	dst_rect.width += 1; dst_rect.height += 1; // Need place for shadow
+	void DrawRun(Bitmap& dest, int x, int y, const TextRun& run) {
+		if (run.bitmap) {
+			dest.Blit(x + run.offset.x, y + run.offset.y, *run.bitmap, run.bitmap->GetRect(), Opacity::Opaque());
+		}
+	}
 
-	const int iy = dst_rect.y;
-	const int ix = dst_rect.x;
+	Point DrawGlyph(Bitmap& dest, int x, int y, const Font& font, const Bitmap& system, int color, char32_t glyph, bool is_exfont) {
+		if (is_exfont) {
+			if (!font.IsStyleApplied()) {
+				return Font::exfont->Render(dest, x, y, system, color, glyph);
+			} else {
+				auto style = font.GetCurrentStyle();
+				auto style_guard = Font::exfont->ApplyStyle(style);
+				return Font::exfont->Render(dest, x, y, system, color, glyph);
+			}
+		} else {
+			return font.Render(dest, x, y, system, color, glyph);
+		}
+	}
 
-	// Where to draw the next glyph (x pos)
-	int next_glyph_pos = 0;
+	Point DrawText(Bitmap& dest, const int ix, const int iy, const Font& font, const Bitmap& system, const int color, StringView text) {
+		// Where to draw the next glyph (x pos)
+		int next_glyph_pos = 0;
 
-	// This loops always renders a single char, color blends it and then puts
-	// it onto the text_surface (including the drop shadow)
-	auto iter = text.data();
-	const auto end = iter + text.size();
+		// This loops always renders a single char, color blends it and then puts
+		// it onto the text_surface (including the drop shadow)
+		auto iter = text.data();
+		const auto end = iter + text.size();
 
-	if (font.CanShape()) {
-		// Collect all glyphs until ExFont or end of string and then shape and render
-		std::u32string text32;
-		while (iter != end) {
-			auto ret = Utils::TextNext(iter, end, 0);
+		if (font.CanShape()) {
+			// Collect all glyphs until ExFont or end of string and then shape and render
+			std::u32string text32;
+			while (iter != end) {
+				auto ret = Utils::TextNext(iter, end, 0);
 
-			iter = ret.next;
-			if (EP_UNLIKELY(!ret)) {
-				continue;
-			}
+				iter = ret.next;
+				if (EP_UNLIKELY(!ret)) {
+					continue;
+				}
 
-			if (EP_UNLIKELY(Utils::IsControlCharacter(ret.ch))) {
-				next_glyph_pos += Draw(dest, ix + next_glyph_pos, iy, font, system, color, ret.ch, ret.is_exfont).x;
-				continue;
-			}
+				if (EP_UNLIKELY(Utils::IsControlCharacter(ret.ch))) {
+					next_glyph_pos += DrawGlyph(dest, ix + next_glyph_pos, iy, font, system, color, ret.ch, ret.is_exfont).x;
+					continue;
+				}
 
-			if (ret.is_exfont) {
-				if (!text32.empty()) {
-					auto shape_ret = font.Shape(text32);
-					text32.clear();
+				if (ret.is_exfont) {
+					if (!text32.empty()) {
+						auto shape_ret = font.Shape(text32);
+						text32.clear();
 
-					for (const auto& ch: shape_ret) {
-						next_glyph_pos += font.Render(dest, ix + next_glyph_pos, iy, system, color, ch).x;
+						for (const auto& ch: shape_ret) {
+							next_glyph_pos += font.Render(dest, ix + next_glyph_pos, iy, system, color, ch).x;
+						}
 					}
+
+					next_glyph_pos += DrawGlyph(dest, ix + next_glyph_pos, iy, font, system, color, ret.ch, true).x;
+					continue;
 				}
 
-				next_glyph_pos += Draw(dest, ix + next_glyph_pos, iy, font, system, color, ret.ch, true).x;
-				continue;
+				text32 += ret.ch;
 			}
 
-			text32 += ret.ch;
-		}
+			if (!text32.empty()) {
+				auto shape_ret = font.Shape(text32);
 
-		if (!text32.empty()) {
-			auto shape_ret = font.Shape(text32);
+				for (const auto& ch: shape_ret) {
+					next_glyph_pos += font.Render(dest, ix + next_glyph_pos, iy, system, color, ch).x;
+				}
+			}
+		} else {
+			while (iter != end) {
+				auto ret = Utils::TextNext(iter, end, 0);
 
-			for (const auto& ch: shape_ret) {
-				next_glyph_pos += font.Render(dest, ix + next_glyph_pos, iy, system, color, ch).x;
+				iter = ret.next;
+				if (EP_UNLIKELY(!ret)) {
+					continue;
+				}
+				next_glyph_pos += DrawGlyph(dest, ix + next_glyph_pos, iy, font, system, color, ret.ch, ret.is_exfont).x;
 			}
 		}
-	} else {
-		while (iter != end) {
-			auto ret = Utils::TextNext(iter, end, 0);
 
-			iter = ret.next;
-			if (EP_UNLIKELY(!ret)) {
-				continue;
-			}
-			next_glyph_pos += Text::Draw(dest, ix + next_glyph_pos, iy, font, system, color, ret.ch, ret.is_exfont).x;
+		return { next_glyph_pos, 0 };
+	}
+
+	int AlignX(int x, int width, Text::Alignment align) {
+		switch (align) {
+		case Text::AlignCenter:
+			return x - width / 2;
+		case Text::AlignRight:
+			return x - width;
+		case Text::AlignLeft:
+			return x;
+		default: assert(false);
+		}
+		return x;
+	}
+}
+
+Point Text::Draw(Bitmap& dest, int x, int y, const Font& font, const Bitmap& system, int color, char32_t glyph, bool is_exfont) {
+	RunKey key;
+	if (EP_UNLIKELY(Utils::IsControlCharacter(glyph)) || !MakeRunKey(key, font, system, color, is_exfont)) {
+		return DrawGlyph(dest, x, y, font, system, color, glyph, is_exfont);
+	}
+
+	key.text = Utils::EncodeUTF(std::u32string(1, glyph));
+
+	const auto* run = FindRun(key);
+	if (!run) {
+		run = &AddRun(std::move(key), GetSize(font, glyph, is_exfont), [&](Bitmap& canvas, int cx, int cy) {
+			return DrawGlyph(canvas, cx, cy, font, system, color, glyph, is_exfont);
+		});
+	}
+
+	DrawRun(dest, x, y, *run);
+	return run->advance;
+}
+
+Point Text::Draw(Bitmap& dest, int x, int y, const Font& font, Color color, char32_t glyph, bool is_exfont) {
+	if (is_exfont) {
+		if (!font.IsStyleApplied()) {
+			return Font::exfont->Render(dest, x, y, color, glyph);
+		} else {
+			auto style = font.GetCurrentStyle();
+			auto style_guard = Font::exfont->ApplyStyle(style);
+			return Font::exfont->Render(dest, x, y, color, glyph);
 		}
+	} else {
+		return font.Render(dest, x, y, color, glyph);
+	}
+}
+
+Point Text::Draw(Bitmap& dest, const int x, const int y, const Font& font, const Bitmap& system, const int color, StringView text, const Text::Alignment align) {
+	if (text.length() == 0) return { 0, 0 };
+
+	RunKey key;
+	if (!MakeRunKey(key, font, system, color, false)) {
+		Rect size = Text::GetSize(font, text);
+		Point advance = DrawText(dest, AlignX(x, size.width, align), y, font, system, color, text);
+		return { advance.x, size.height };
+	}
+
+	key.text = ToString(text);
+
+	const auto* run = FindRun(key);
+	if (!run) {
+		Rect size = Text::GetSize(font, text);
+		run = &AddRun(std::move(key), size, [&](Bitmap& canvas, int cx, int cy) {
+			Point advance = DrawText(canvas, cx, cy, font, system, color, text);
+			return Point(advance.x, size.height);
+		});
 	}
-	return { next_glyph_pos, ih };
+
+	DrawRun(dest, AlignX(x, run->width, align), y, *run);
+	return run->advance;
 }
 
 Point Text::Draw(Bitmap& dest, const int x, const int y, const Font& font, const Color color, StringView text) {
@@ -267,3 +440,9 @@ Rect Text::GetSize(const Font& font, char32_t glyph, bool is_exfont) {
 		return font.GetSize(glyph);
 	}
 }
+
+void Text::ClearCache() {
+	runs_lru.clear();
+	runs.clear();
+	run_bytes = 0;
+}
@@ -126,5 +126,12 @@ namespace Text {
 	 * @return Rect describing the rendered string boundary
 	 */
 	Rect GetSize(const Font& font, char32_t glyph, bool is_exfont);
+
+	/**
+	 * Removes all pre-rendered text.
+	 * Text drawn with a system graphic is cached by font, style, color, id of
+	 * the system graphic and text.
+	 */
+	void ClearCache();
 }
 #endif
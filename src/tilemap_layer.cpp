@@ -683,6 +683,15 @@ TilemapSubLayer::TilemapSubLayer(TilemapLayer* tilemap, Drawable::Z_t z) :
 	DrawableMgr::Register(this);
 }
 
+Drawable::Bounds TilemapSubLayer::GetBounds(const Bitmap& dst) {
+	Bounds bounds;
+	bounds.known = true;
+	if (tilemap->GetChipset()) {
+		bounds.rect = dst.GetRect();
+	}
+	return bounds;
+}
+
 void TilemapSubLayer::Draw(Bitmap& dst) {
 	if (!tilemap->GetChipset()) {
 		return;
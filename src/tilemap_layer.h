@@ -41,6 +41,8 @@ public:
 
 	void Draw(Bitmap& dst) override;
 
+	Bounds GetBounds(const Bitmap& dst) override;
+
 private:
 	TilemapLayer* tilemap = nullptr;
 
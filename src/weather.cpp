@@ -41,6 +41,15 @@ Weather::Weather() :
 void Weather::Update() {
 }
 
+Drawable::Bounds Weather::GetBounds(const Bitmap& dst) {
+	Bounds bounds;
+	bounds.known = true;
+	if (Main_Data::game_screen->GetWeatherType() != Game_Screen::Weather_None) {
+		bounds.rect = dst.GetRect();
+	}
+	return bounds;
+}
+
 void Weather::Draw(Bitmap& dst) {
 	SetTone(Main_Data::game_screen->GetTone());
 
@@ -33,6 +33,7 @@ public:
 	Weather();
 
 	void Draw(Bitmap& dst) override;
+	Bounds GetBounds(const Bitmap& dst) override;
 	void Update();
 
 	Tone GetTone() const;
@@ -22,6 +22,7 @@
 #include "game_party.h"
 #include "bitmap.h"
 #include "font.h"
+#include "player.h"
 
 Window_GameList::Window_GameList(int ix, int iy, int iwidth, int iheight) :
 	Window_Selectable(ix, iy, iwidth, iheight) {
@@ -35,6 +36,7 @@ bool Window_GameList::Refresh(FilesystemView filesystem_base, bool show_dotdot)
 	}
 
 	game_directories.clear();
+	scanner.reset();
 
 	this->show_dotdot = show_dotdot;
 
@@ -68,6 +70,10 @@ bool Window_GameList::Refresh(FilesystemView filesystem_base, bool show_dotdot)
 				  return strcmp(Utils::LowerCase(s).c_str(), Utils::LowerCase(s2).c_str()) <= 0;
 			  });
 
+	game_infos.clear();
+	game_infos.resize(game_directories.size());
+	scanner = std::make_unique<GameScanner>(base_fs, game_directories);
+
 	if (show_dotdot) {
 		game_directories.insert(game_directories.begin(), "..");
 	}
@@ -98,6 +104,26 @@ bool Window_GameList::Refresh(FilesystemView filesystem_base, bool show_dotdot)
 	return true;
 }
 
+void Window_GameList::Update() {
+	Window_Selectable::Update();
+
+	if (!scanner) {
+		return;
+	}
+
+	bool done = scanner->Update([this](int index, const GameScanner::GameInfo& info) {
+		game_infos[index] = info;
+
+		if (HasValidEntry()) {
+			DrawItem(index + (show_dotdot ? 1 : 0));
+		}
+	});
+
+	if (done) {
+		scanner.reset();
+	}
+}
+
 void Window_GameList::DrawItem(int index) {
 	Rect rect = GetItemRect(index);
 	contents->ClearRect(rect);
@@ -108,6 +134,17 @@ void Window_GameList::DrawItem(int index) {
 		text = game_directories[index];
 	}
 
+	const auto* info = GetGameInfo(index);
+	if (info && info->status == GameScanner::GameInfo::Status::Game) {
+		StringView engine = "RPG Maker";
+		if ((info->engine & Player::EngineRpg2k3) == Player::EngineRpg2k3) {
+			engine = "RPG Maker 2003";
+		} else if ((info->engine & Player::EngineRpg2k) == Player::EngineRpg2k) {
+			engine = "RPG Maker 2000";
+		}
+		contents->TextDraw(rect, Font::ColorDisabled, engine, Text::AlignRight);
+	}
+
 	contents->TextDraw(rect.x, rect.y, Font::ColorDefault, game_directories[index]);
 }
 
@@ -157,3 +194,14 @@ bool Window_GameList::HasValidEntry() {
 std::pair<FilesystemView, std::string> Window_GameList::GetGameFilesystem() const {
 	return { base_fs.Create(game_directories[GetIndex()]), game_directories[GetIndex()] };
 }
+
+const GameScanner::GameInfo* Window_GameList::GetGameInfo(int index) const {
+	if (show_dotdot) {
+		--index;
+	}
+
+	if (index < 0 || index >= static_cast<int>(game_infos.size())) {
+		return nullptr;
+	}
+	return &game_infos[index];
+}
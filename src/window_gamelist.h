@@ -19,10 +19,12 @@
 #define EP_WINDOW_GAMELIST_H
 
 // Headers
+#include <memory>
 #include <vector>
 #include "window_help.h"
 #include "window_selectable.h"
 #include "filefinder.h"
+#include "game_scanner.h"
 
 /**
  * Window_GameList class.
@@ -40,6 +42,12 @@ public:
 	 */
 	bool Refresh(FilesystemView filesystem_base, bool show_dotdot);
 
+	/**
+	 * Updates the window and redraws entries whose game information
+	 * became available.
+	 */
+	void Update() override;
+
 	/**
 	 * Draws an item together with the quantity.
 	 *
@@ -59,9 +67,17 @@ public:
 	 */
 	std::pair<FilesystemView, std::string> GetGameFilesystem() const;
 
+	/**
+	 * @param index index of the entry
+	 * @return information about the game in the entry, nullptr for ".."
+	 */
+	const GameScanner::GameInfo* GetGameInfo(int index) const;
+
 private:
 	FilesystemView base_fs;
 	std::vector<std::string> game_directories;
+	std::vector<GameScanner::GameInfo> game_infos;
+	std::unique_ptr<GameScanner> scanner;
 
 	bool show_dotdot = false;
 };
@@ -283,6 +283,7 @@ void Window_Settings::RefreshVideo() {
 	AddOption(cfg.scaling_mode, [this](){ DisplayUi->SetScalingMode(static_cast<ConfigEnum::ScalingMode>(GetCurrentOption().current_value)); });
 	AddOption(cfg.pause_when_focus_lost, [cfg]() mutable { DisplayUi->SetPauseWhenFocusLost(cfg.pause_when_focus_lost.Toggle()); });
 	AddOption(cfg.touch_ui, [](){ DisplayUi->ToggleTouchUi(); });
+	AddOption(cfg.direct_render, [](){ DisplayUi->ToggleDirectRender(); });
 	AddOption(cfg.game_resolution, [this]() { DisplayUi->SetGameResolution(static_cast<ConfigEnum::GameResolution>(GetCurrentOption().current_value)); });
 }
 
@@ -423,6 +424,8 @@ void Window_Settings::RefreshEngine() {
 	AddOption(cfg.settings_autosave, [&cfg](){ cfg.settings_autosave.Toggle(); });
 	AddOption(cfg.settings_in_title, [&cfg](){ cfg.settings_in_title.Toggle(); });
 	AddOption(cfg.settings_in_menu, [&cfg](){ cfg.settings_in_menu.Toggle(); });
+	AddOption(cfg.directory_index, [&cfg](){ cfg.directory_index.Toggle(); });
+	AddOption(cfg.parallel_common_events, [&cfg](){ cfg.parallel_common_events.Toggle(); });
 }
 
 void Window_Settings::RefreshEngineFont(bool mincho) {
@@ -601,6 +604,7 @@ void Window_Settings::RefreshInput() {
 	AddOption(cfg.gamepad_swap_dpad_with_buttons, [&cfg](){ cfg.gamepad_swap_dpad_with_buttons.Toggle(); Input::ResetTriggerKeys(); });
 	AddOption(cfg.speed_modifier_a, [this, &cfg](){ auto tmp = GetCurrentOption().current_value; Player::speed_modifier_a = tmp; cfg.speed_modifier_a.Set(tmp); });
 	AddOption(cfg.speed_modifier_b, [this, &cfg](){ auto tmp = GetCurrentOption().current_value; Player::speed_modifier_b = tmp; cfg.speed_modifier_b.Set(tmp); });
+	AddOption(cfg.speed_modifier_turbo, [&cfg](){ Player::speed_modifier_turbo = cfg.speed_modifier_turbo.Toggle(); });
 }
 
 void Window_Settings::RefreshButtonCategory() {
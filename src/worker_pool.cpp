@@ -0,0 +1,186 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "worker_pool.h"
+#include "output.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#ifdef HAVE_THREADS
+#  include <condition_variable>
+#  include <mutex>
+#  include <thread>
+#endif
+
+namespace {
+	// Enough to hide latency of IO and to split the battle calculations.
+	// More threads only steal time from the audio thread.
+	constexpr int max_workers = 4;
+
+	// Amount of workers set by SetNumWorkers, -1 picks it from the CPU cores
+	int num_workers_override = -1;
+
+#ifdef HAVE_THREADS
+	struct Pool {
+		std::vector<std::thread> threads;
+		std::deque<WorkerPool::Task> queue;
+		std::mutex mutex;
+		std::condition_variable cv;
+		bool started = false;
+		bool stop = false;
+	};
+
+	Pool pool;
+
+	void WorkerMain() {
+		while (true) {
+			WorkerPool::Task task;
+			{
+				std::unique_lock<std::mutex> lk(pool.mutex);
+				pool.cv.wait(lk, [] { return pool.stop || !pool.queue.empty(); });
+				if (pool.stop) {
+					return;
+				}
+				task = std::move(pool.queue.front());
+				pool.queue.pop_front();
+			}
+			task();
+		}
+	}
+
+	void StartWorkers() {
+		std::lock_guard<std::mutex> lk(pool.mutex);
+		if (pool.started) {
+			return;
+		}
+		pool.started = true;
+		pool.stop = false;
+
+		// One core stays reserved for the main thread
+		int num_workers = std::min<int>(max_workers, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+		if (num_workers_override >= 0) {
+			num_workers = num_workers_override;
+		}
+		for (int i = 0; i < num_workers; ++i) {
+			pool.threads.emplace_back(WorkerMain);
+		}
+		Output::Debug("WorkerPool: Started {} worker threads", pool.threads.size());
+	}
+#endif
+}
+
+int WorkerPool::GetNumWorkers() {
+#ifdef HAVE_THREADS
+	StartWorkers();
+	return static_cast<int>(pool.threads.size());
+#else
+	return 0;
+#endif
+}
+
+void WorkerPool::Submit(Task task) {
+	if (GetNumWorkers() == 0) {
+		task();
+		return;
+	}
+
+#ifdef HAVE_THREADS
+	{
+		std::lock_guard<std::mutex> lk(pool.mutex);
+		pool.queue.push_back(std::move(task));
+	}
+	pool.cv.notify_one();
+#endif
+}
+
+void WorkerPool::ParallelFor(int count, const std::function<void(int)>& fn, int min_parallel) {
+	const int num_workers = GetNumWorkers();
+	if (num_workers == 0 || count < std::max(min_parallel, 2)) {
+		for (int i = 0; i < count; ++i) {
+			fn(i);
+		}
+		return;
+	}
+
+#ifdef HAVE_THREADS
+	// Shared with the helper tasks, which may start after this function returned
+	struct State {
+		std::atomic<int> next { 0 };
+		std::atomic<int> done { 0 };
+		int count = 0;
+		const std::function<void(int)>* fn = nullptr;
+		std::mutex mutex;
+		std::condition_variable cv;
+	};
+	auto state = std::make_shared<State>();
+	state->count = count;
+	state->fn = &fn;
+
+	auto work = [](State& st) {
+		int finished = 0;
+		for (int i = st.next++; i < st.count; i = st.next++) {
+			(*st.fn)(i);
+			++finished;
+		}
+		if (finished > 0 && (st.done += finished) == st.count) {
+			std::lock_guard<std::mutex> lk(st.mutex);
+			st.cv.notify_all();
+		}
+	};
+
+	const int helpers = std::min(num_workers, count - 1);
+	for (int i = 0; i < helpers; ++i) {
+		Submit([state, work]() { work(*state); });
+	}
+
+	work(*state);
+
+	std::unique_lock<std::mutex> lk(state->mutex);
+	state->cv.wait(lk, [&]() { return state->done == count; });
+#endif
+}
+
+int WorkerPool::SetNumWorkers(int count) {
+	Quit();
+	const int previous = num_workers_override;
+	num_workers_override = std::max(count, -1);
+	return previous;
+}
+
+void WorkerPool::Quit() {
+#ifdef HAVE_THREADS
+	{
+		std::lock_guard<std::mutex> lk(pool.mutex);
+		if (!pool.started) {
+			return;
+		}
+		pool.stop = true;
+		pool.queue.clear();
+	}
+	pool.cv.notify_all();
+
+	for (auto& thread: pool.threads) {
+		thread.join();
+	}
+	pool.threads.clear();
+	pool.started = false;
+#endif
+}
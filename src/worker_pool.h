@@ -0,0 +1,77 @@
+/*
+ * This file is part of EasyRPG Player.
+ *
+ * EasyRPG Player is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * EasyRPG Player is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with EasyRPG Player. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EP_WORKER_POOL_H
+#define EP_WORKER_POOL_H
+
+#include <functional>
+
+/**
+ * A small pool of worker threads for work which can be split into independent
+ * tasks or which can be done in the background.
+ *
+ * The workers are started on first use. When the Player is built without
+ * thread support (HAVE_THREADS) or the pool has no workers all tasks run
+ * synchronously on the calling thread.
+ *
+ * Tasks must not touch the scene graph, audio or any other state that is
+ * modified by the main thread while they run.
+ */
+namespace WorkerPool {
+	using Task = std::function<void()>;
+
+	/** @return amount of worker threads, 0 when everything runs on the main thread */
+	int GetNumWorkers();
+
+	/**
+	 * Queues a task for execution on a worker thread.
+	 * Without workers the task is executed immediately.
+	 *
+	 * @param task the task to run
+	 */
+	void Submit(Task task);
+
+	/**
+	 * Calls fn(i) for every i in [0, count) and blocks until all calls returned.
+	 * The calling thread takes part in the work, which makes it safe to call
+	 * this from inside a task.
+	 *
+	 * @param count number of work items
+	 * @param fn function to invoke per work item
+	 * @param min_parallel only use the workers when count is at least this value
+	 */
+	void ParallelFor(int count, const std::function<void(int)>& fn, int min_parallel = 2);
+
+	/**
+	 * Sets the amount of worker threads, also more than the CPU has cores.
+	 * The workers are stopped and started again with the new amount when they
+	 * are used next time. Useful for testing.
+	 *
+	 * @param count amount of workers, 0 runs everything on the main thread,
+	 * -1 picks the amount from the CPU cores
+	 * @return the previous setting
+	 */
+	int SetNumWorkers(int count);
+
+	/**
+	 * Stops all workers. Queued tasks which did not start yet are discarded.
+	 * Blocks until the running tasks finished.
+	 */
+	void Quit();
+}
+
+#endif
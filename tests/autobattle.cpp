@@ -1,5 +1,6 @@
 #include "test_mock_actor.h"
 #include "autobattle.h"
+#include "game_battlealgorithm.h"
 #include "rand.h"
 #include "doctest.h"
 
@@ -57,5 +58,85 @@ TEST_CASE("NormalAttackTargetRank") {
 }
 
 
+// The autobattle selection before the ranking used the worker pool
+static std::pair<const lcf::rpg::Skill*, const Game_Battler*> SelectSerial(const Game_Actor& source) {
+	const auto cond = lcf::rpg::System::BattleCondition_none;
+	double skill_rank = 0.0;
+	const lcf::rpg::Skill* skill = nullptr;
+	for (auto& skill_id: source.GetSkills()) {
+		const auto& candidate_skill = lcf::Data::skills[skill_id - 1];
+		const auto rank = AutoBattle::CalcSkillAutoBattleRank(source, candidate_skill, cond, false, false);
+		if (rank > skill_rank) {
+			skill_rank = rank;
+			skill = &candidate_skill;
+		}
+	}
+
+	double normal_attack_rank = AutoBattle::CalcNormalAttackAutoBattleRank(source, Game_Battler::WeaponAll, cond, false, false);
+
+	double best_target_rank = 0.0;
+	const Game_Battler* best_target = nullptr;
+	for (auto* target: Main_Data::game_enemyparty->GetEnemies()) {
+		const auto target_rank = (skill != nullptr && normal_attack_rank < skill_rank)
+			? AutoBattle::CalcSkillDmgAutoBattleTargetRank(source, *target, *skill, cond, false, false)
+			: AutoBattle::CalcNormalAttackAutoBattleTargetRank(source, *target, Game_Battler::WeaponAll, cond, false, false);
+		if (target_rank > best_target_rank) {
+			best_target_rank = target_rank;
+			best_target = target;
+		}
+	}
+	if (skill != nullptr && normal_attack_rank >= skill_rank) {
+		skill = nullptr;
+	}
+	return { skill, best_target };
+}
+
+TEST_CASE("SelectActionSameRandomNumbers") {
+	const MockBattle m(1, 4);
+
+	for (int i = 1; i <= 4; ++i) {
+		MakeDBEnemy(i, 300 + i * 50, 0, 10, 10, 10, 10);
+	}
+	Main_Data::game_enemyparty->ResetBattle(1);
+
+	auto& source = *Main_Data::game_party->GetActors()[0];
+	source.SetBaseMaxHp(500);
+	source.SetHp(source.GetMaxHp());
+	source.SetBaseMaxSp(500);
+	source.SetSp(source.GetMaxSp());
+	source.SetBaseAtk(60);
+	source.SetBaseSpi(60);
+
+	// Enough skills for the ranking to use the workers
+	for (int i = 1; i <= 12; ++i) {
+		auto* skill = MakeDBSkill(i, 100, 20 + i * 7, 5, 5, 4);
+		skill->scope = lcf::rpg::Skill::Scope_enemy;
+		skill->sp_cost = i * 3;
+		source.LearnSkill(i, nullptr);
+	}
+
+	for (int seed: { 1, 42, 1234, 99999 }) {
+		CAPTURE(seed);
+
+		Rand::SeedRandomNumberGenerator(seed);
+		const auto expected = SelectSerial(source);
+		const auto expected_next = Rand::GetRandomNumber(0, INT32_MAX - 1);
+
+		Rand::SeedRandomNumberGenerator(seed);
+		AutoBattle::SelectAutoBattleAction(source, Game_Battler::WeaponAll, lcf::rpg::System::BattleCondition_none, true, false, false, false);
+		REQUIRE_EQ(Rand::GetRandomNumber(0, INT32_MAX - 1), expected_next);
+
+		const auto* algo = source.GetBattleAlgorithm().get();
+		REQUIRE(algo != nullptr);
+		if (expected.first) {
+			REQUIRE(algo->GetType() == Game_BattleAlgorithm::Type::Skill);
+			REQUIRE_EQ(static_cast<const Game_BattleAlgorithm::Skill*>(algo)->GetSkill().ID, expected.first->ID);
+		} else {
+			REQUIRE(algo->GetType() == Game_BattleAlgorithm::Type::Normal);
+		}
+		REQUIRE(algo->GetOriginalTargets()[0] == expected.second);
+		source.SetBattleAlgorithm(nullptr);
+	}
+}
 
 TEST_SUITE_END();
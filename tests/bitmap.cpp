@@ -0,0 +1,44 @@
+#include "bitmap.h"
+#include "pixel_format.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("Bitmap");
+
+// 3x1 RGBA PNG: (255, 0, 0, 255), (200, 100, 50, 128), (10, 20, 30, 0)
+static const uint8_t rgba_png[] = {
+	0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x01, 0x08, 0x06, 0x00, 0x00, 0x00, 0x1B, 0xE0, 0x14,
+	0xB4, 0x00, 0x00, 0x00, 0x15, 0x49, 0x44, 0x41, 0x54, 0x78, 0x9C, 0x63, 0xF8, 0xCF, 0xC0, 0xF0,
+	0xFF, 0x44, 0x8A, 0x51, 0x03, 0x97, 0x88, 0x1C, 0x03, 0x00, 0x22, 0x40, 0x04, 0x19, 0x2B, 0x92,
+	0xAD, 0xA1, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82
+};
+
+TEST_CASE("DecodePNGTransparent") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+
+	auto bitmap = Bitmap::Create(rgba_png, sizeof(rgba_png), true);
+	REQUIRE(bitmap);
+	REQUIRE_EQ(bitmap->GetWidth(), 3);
+	REQUIRE_EQ(bitmap->GetHeight(), 1);
+
+	// Stored premultiplied
+	CHECK_EQ(bitmap->GetColorAt(0, 0), Color(255, 0, 0, 255));
+	CHECK_EQ(bitmap->GetColorAt(1, 0), Color(100, 50, 25, 128));
+	CHECK_EQ(bitmap->GetColorAt(2, 0), Color(0, 0, 0, 0));
+}
+
+TEST_CASE("DecodePNGOpaque") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+
+	// The alpha is dropped after premultiplying, like the RGBA conversion with pixman
+	auto bitmap = Bitmap::Create(rgba_png, sizeof(rgba_png), false);
+	REQUIRE(bitmap);
+	REQUIRE_EQ(bitmap->GetWidth(), 3);
+	REQUIRE_EQ(bitmap->GetHeight(), 1);
+
+	CHECK_EQ(bitmap->GetColorAt(0, 0), Color(255, 0, 0, 255));
+	CHECK_EQ(bitmap->GetColorAt(1, 0), Color(100, 50, 25, 255));
+	CHECK_EQ(bitmap->GetColorAt(2, 0), Color(0, 0, 0, 255));
+}
+
+TEST_SUITE_END();
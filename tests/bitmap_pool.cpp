@@ -0,0 +1,48 @@
+#include <cstring>
+#include "bitmap_pool.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("BitmapPool");
+
+TEST_CASE("Reuse") {
+	BitmapPool::Clear();
+	const size_t bytes = 320 * 240 * 4;
+
+	auto* data = static_cast<uint8_t*>(BitmapPool::Allocate(bytes));
+	REQUIRE(data != nullptr);
+	memset(data, 0xFF, bytes);
+	BitmapPool::Free(data);
+
+	auto stats = BitmapPool::GetStats();
+	CHECK(stats.cached_buffers == 1);
+	CHECK(stats.cached_bytes >= bytes);
+
+	// A slightly smaller buffer falls into the same size class
+	auto* data2 = static_cast<uint8_t*>(BitmapPool::Allocate(bytes - 64));
+	CHECK(data2 == data);
+	CHECK(BitmapPool::GetStats().reused == stats.reused + 1);
+	CHECK(BitmapPool::GetStats().cached_buffers == 0);
+
+	// Memory is cleared when reused
+	bool zero = true;
+	for (size_t i = 0; i < bytes - 64; ++i) {
+		zero &= (data2[i] == 0);
+	}
+	CHECK(zero);
+
+	BitmapPool::Free(data2);
+	BitmapPool::Clear();
+	CHECK(BitmapPool::GetStats().cached_bytes == 0);
+}
+
+TEST_CASE("SmallNotPooled") {
+	BitmapPool::Clear();
+
+	auto* data = BitmapPool::Allocate(16 * 16 * 4);
+	REQUIRE(data != nullptr);
+	BitmapPool::Free(data);
+
+	CHECK(BitmapPool::GetStats().cached_buffers == 0);
+}
+
+TEST_SUITE_END();
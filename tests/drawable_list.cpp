@@ -22,6 +22,39 @@ class TestFrame : public Drawable {
 		void Draw(Bitmap&) override {}
 };
 
+class TestBounds : public Drawable {
+	public:
+		TestBounds(Drawable::Z_t z, Rect rect, ImageOpacity opacity = ImageOpacity::Alpha_8Bit)
+			: Drawable(z, Drawable::Flags::Global) {
+			bounds.rect = rect;
+			bounds.known = true;
+			bounds.opacity = opacity;
+		}
+		void Draw(Bitmap&) override { ++draws; }
+		Bounds GetBounds(const Bitmap&) override { return bounds; }
+
+		Bounds bounds;
+		int draws = 0;
+};
+
+class TestBatch : public Drawable {
+	public:
+		TestBatch(Drawable::Z_t z, const Bitmap* src, int opacity = 255)
+			: Drawable(z, Drawable::Flags::Global), src(src), opacity(opacity) {}
+		void Draw(Bitmap&) override { ++draws; }
+		bool GetBatchBlit(BatchBlit& blit) override {
+			blit.src = src;
+			blit.src_rect = Rect(0, 0, 24, 32);
+			blit.x = static_cast<int>(GetZ()) * 24;
+			blit.opacity = opacity;
+			return true;
+		}
+
+		const Bitmap* src;
+		int opacity;
+		int draws = 0;
+};
+
 }
 
 TEST_CASE("Default") {
@@ -350,4 +383,82 @@ TEST_CASE("TakeFromPred") {
 	REQUIRE(list2.IsDirty());
 }
 
+TEST_CASE("DrawCulling") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	Bitmap bitmap(320, 240, false);
+
+	TestSprite unknown(1);
+	TestBounds below(2, Rect(10, 10, 50, 50));
+	TestBounds offscreen(3, Rect(320, 0, 16, 16));
+	TestBounds partly_covered(4, Rect(90, 90, 20, 20));
+	TestBounds opaque(5, Rect(0, 0, 100, 100), ImageOpacity::Opaque);
+	TestBounds above(6, Rect(0, 0, 320, 240));
+	TestBounds invisible(7, Rect(0, 0, 320, 240), ImageOpacity::Opaque);
+	invisible.SetVisible(false);
+
+	DrawableList list;
+	list.Append(&unknown);
+	list.Append(&below);
+	list.Append(&offscreen);
+	list.Append(&partly_covered);
+	list.Append(&opaque);
+	list.Append(&above);
+	list.Append(&invisible);
+
+	list.Draw(bitmap);
+
+	REQUIRE_EQ(below.draws, 0);
+	REQUIRE_EQ(offscreen.draws, 0);
+	REQUIRE_EQ(partly_covered.draws, 1);
+	REQUIRE_EQ(opaque.draws, 1);
+	REQUIRE_EQ(above.draws, 1);
+	REQUIRE_EQ(invisible.draws, 0);
+
+	auto& stats = list.GetDrawStats();
+	REQUIRE_EQ(stats.drawn, 4);
+	REQUIRE_EQ(stats.offscreen, 1);
+	REQUIRE_EQ(stats.occluded, 1);
+
+	// Occluders outside of the z range do not hide anything
+	list.Draw(bitmap, 0, 4);
+	REQUIRE_EQ(below.draws, 1);
+	REQUIRE_EQ(list.GetDrawStats().drawn, 3);
+	REQUIRE_EQ(list.GetDrawStats().occluded, 0);
+}
+
+TEST_CASE("DrawBatch") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	Bitmap bitmap(320, 240, false);
+	Bitmap charset1(72, 128, true);
+	Bitmap charset2(72, 128, true);
+
+	TestBatch a(1, &charset1);
+	TestBatch b(2, &charset1);
+	TestBatch c(3, &charset1, 128);
+	TestBatch d(4, &charset2);
+	TestSprite e(5);
+	TestBatch f(6, &charset2);
+	TestBatch g(7, &charset2);
+
+	DrawableList list;
+	list.Append(&a);
+	list.Append(&b);
+	list.Append(&c);
+	list.Append(&d);
+	list.Append(&e);
+	list.Append(&f);
+	list.Append(&g);
+
+	list.Draw(bitmap);
+
+	REQUIRE_EQ(a.draws, 0);
+	REQUIRE_EQ(g.draws, 0);
+
+	// a+b, c, d, f+g
+	auto& stats = list.GetDrawStats();
+	REQUIRE_EQ(stats.drawn, 7);
+	REQUIRE_EQ(stats.batched, 6);
+	REQUIRE_EQ(stats.batches, 4);
+}
+
 TEST_SUITE_END();
@@ -1,7 +1,12 @@
 #include <lcf/data.h>
 #include "doctest.h"
+#include "bitmap.h"
 #include "dynrpg.h"
+#include "dynrpg_textplugin.h"
+#include "font.h"
 #include "game_variables.h"
+#include "pixel_format.h"
+#include "text.h"
 #include "test_mock_actor.h"
 
 TEST_SUITE_BEGIN("DynRPG");
@@ -183,6 +188,22 @@ TEST_CASE("easyrpg dynrpg invoke") {
 	DynRpg::Invoke("@unknownfunc 1, 2, 3");
 }
 
+TEST_CASE("Cached invoke resolves references") {
+	const MockActor m;
+
+	std::vector<int32_t> vars = {0, 10};
+	Main_Data::game_variables->SetData(vars);
+	Main_Data::game_variables->SetWarning(0);
+
+	DynRpg::Invoke("@easyrpg_add 1, V2, 4");
+	CHECK(Main_Data::game_variables->Get(1) == 14);
+
+	// Same command text, the variable is read again
+	Main_Data::game_variables->Set(2, 20);
+	DynRpg::Invoke("@easyrpg_add 1, V2, 4");
+	CHECK(Main_Data::game_variables->Get(1) == 24);
+}
+
 TEST_CASE("Incompatible changes") {
 	const MockActor m; // disable log
 
@@ -204,4 +225,56 @@ TEST_CASE("Incompatible changes") {
 	CHECK(args[0] == "4");
 }
 
+static bool HasPixels(const Bitmap& bitmap, const Rect& rect) {
+	for (int y = rect.y; y < rect.y + rect.height; ++y) {
+		for (int x = rect.x; x < rect.x + rect.width; ++x) {
+			if (bitmap.GetColorAt(x, y).alpha != 0) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+TEST_CASE("Text plugin renders changed lines") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	const int line_height = Text::GetSize(*Font::Default(), "a").height + 2;
+
+	DynRpg::TextBitmap canvas;
+	CHECK(canvas.Render({ "abc", "de", "f" }, 0) == std::vector<int>{ 0, 1, 2 });
+	const auto bitmap = canvas.GetBitmap();
+	REQUIRE(bitmap);
+	CHECK(canvas.GetRect() == Rect(0, 0, Text::GetSize(*Font::Default(), "abc").width, line_height * 3));
+	CHECK(HasPixels(*bitmap, { 0, line_height * 2, bitmap->width(), line_height }));
+
+	// Nothing changed
+	CHECK(canvas.Render({ "abc", "de", "f" }, 0).empty());
+
+	// Only the changed line is drawn
+	CHECK(canvas.Render({ "abc", "xy", "f" }, 0) == std::vector<int>{ 1 });
+	CHECK(canvas.GetBitmap() == bitmap);
+
+	// A removed line is cleared
+	CHECK(canvas.Render({ "abc", "xy" }, 0).empty());
+	CHECK(canvas.GetBitmap() == bitmap);
+	CHECK(canvas.GetRect().height == line_height * 2);
+	CHECK(!HasPixels(*bitmap, { 0, line_height * 2, bitmap->width(), line_height }));
+	CHECK(HasPixels(*bitmap, { 0, 0, bitmap->width(), line_height * 2 }));
+
+	// A line which fits into the bitmap is drawn into it
+	CHECK(canvas.Render({ "abc", "xy", "g" }, 0) == std::vector<int>{ 2 });
+	CHECK(canvas.GetBitmap() == bitmap);
+	CHECK(HasPixels(*bitmap, { 0, line_height * 2, bitmap->width(), line_height }));
+
+	// A longer text needs a larger bitmap, all lines are drawn again
+	CHECK(canvas.Render({ "abc", "xy", "g", "h" }, 0) == std::vector<int>{ 0, 1, 2, 3 });
+	CHECK(canvas.GetBitmap() != bitmap);
+	CHECK(canvas.GetBitmap()->height() >= line_height * 4);
+	CHECK(canvas.Render({ "abcdefgh", "xy", "g", "h" }, 0) == std::vector<int>{ 0, 1, 2, 3 });
+	CHECK(canvas.GetBitmap()->width() >= Text::GetSize(*Font::Default(), "abcdefgh").width);
+
+	// A different color draws all lines
+	CHECK(canvas.Render({ "abcdefgh", "xy", "g", "h" }, 1) == std::vector<int>{ 0, 1, 2, 3 });
+}
+
 TEST_SUITE_END();
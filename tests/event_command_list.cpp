@@ -0,0 +1,127 @@
+#include "event_command_list.h"
+#include "doctest.h"
+
+#include <algorithm>
+#include <random>
+
+using Cmd = lcf::rpg::EventCommand::Code;
+
+TEST_SUITE_BEGIN("EventCommandList");
+
+static lcf::rpg::EventCommand MakeCommand(Cmd code, int indent, std::vector<int32_t> params = {}) {
+	lcf::rpg::EventCommand com;
+	com.code = static_cast<int>(code);
+	com.indent = indent;
+	com.parameters = lcf::DBArray<int32_t>(params.begin(), params.end());
+	return com;
+}
+
+TEST_CASE("FindNextBranch") {
+	EventCommandList list({
+		MakeCommand(Cmd::ConditionalBranch, 0),
+		MakeCommand(Cmd::ConditionalBranch, 1),
+		MakeCommand(Cmd::Wait, 2),
+		MakeCommand(Cmd::ElseBranch, 1),
+		MakeCommand(Cmd::EndBranch, 1),
+		MakeCommand(Cmd::Wait, 1),
+		MakeCommand(Cmd::ElseBranch, 0),
+		MakeCommand(Cmd::Wait, 1),
+		MakeCommand(Cmd::EndBranch, 0),
+	});
+
+	CHECK_EQ(list.FindNext(0, { Cmd::ElseBranch, Cmd::EndBranch }, 0), 6);
+	CHECK_EQ(list.FindNext(1, { Cmd::ElseBranch, Cmd::EndBranch }, 1), 3);
+	CHECK_EQ(list.FindNext(3, { Cmd::EndBranch }, 1), 4);
+	CHECK_EQ(list.FindNext(6, { Cmd::EndBranch }, 0), 8);
+	CHECK_EQ(list.FindNext(8, { Cmd::EndBranch }, 0), 9);
+	CHECK_EQ(list.FindNext(0, { Cmd::Loop }, 0), 9);
+}
+
+TEST_CASE("FindLabel") {
+	EventCommandList list({
+		MakeCommand(Cmd::Label, 0, { 2 }),
+		MakeCommand(Cmd::Wait, 0),
+		MakeCommand(Cmd::Label, 1, { 5 }),
+		MakeCommand(Cmd::Label, 0, { 2 }),
+	});
+
+	CHECK_EQ(list.FindLabel(2), 0);
+	CHECK_EQ(list.FindLabel(5), 2);
+	CHECK_EQ(list.FindLabel(1), -1);
+}
+
+TEST_CASE("FindLoopBegin") {
+	EventCommandList list({
+		MakeCommand(Cmd::Loop, 0),
+		MakeCommand(Cmd::Loop, 1),
+		MakeCommand(Cmd::Wait, 2),
+		MakeCommand(Cmd::EndLoop, 1),
+		MakeCommand(Cmd::EndLoop, 0),
+		MakeCommand(Cmd::ConditionalBranch, 0),
+		MakeCommand(Cmd::EndLoop, 1),
+		MakeCommand(Cmd::EndBranch, 0),
+	});
+
+	CHECK_EQ(list.FindLoopBegin(3, 1), 1);
+	CHECK_EQ(list.FindLoopBegin(4, 0), 0);
+	// Blocked by the branch
+	CHECK_EQ(list.FindLoopBegin(6, 1), -1);
+	// Other commands are scanned the same way
+	CHECK_EQ(list.FindLoopBegin(2, 2), -1);
+
+	EventCommandList no_loop({
+		MakeCommand(Cmd::Wait, 0),
+		MakeCommand(Cmd::EndLoop, 0),
+	});
+	CHECK_EQ(no_loop.FindLoopBegin(1, 0), 1);
+}
+
+TEST_CASE("FindNextRandom") {
+	std::mt19937 rng(42);
+
+	for (int n = 0; n < 20; ++n) {
+		std::vector<lcf::rpg::EventCommand> commands;
+		int indent = 0;
+		for (int i = 0; i < 200; ++i) {
+			indent = std::max(0, indent + static_cast<int>(rng() % 3) - 1);
+			auto code = (rng() % 4 == 0) ? Cmd::EndBranch : Cmd::Wait;
+			commands.push_back(MakeCommand(code, indent));
+		}
+		EventCommandList list(commands);
+
+		for (int i = 0; i < static_cast<int>(commands.size()); ++i) {
+			for (int d = 0; d < 4; ++d) {
+				int expected = i + 1;
+				for (; expected < static_cast<int>(commands.size()); ++expected) {
+					if (commands[expected].indent <= d && static_cast<Cmd>(commands[expected].code) == Cmd::EndBranch) {
+						break;
+					}
+				}
+				REQUIRE_EQ(list.FindNext(i, { Cmd::EndBranch }, d), expected);
+			}
+		}
+	}
+}
+
+TEST_CASE("GetSlot") {
+	EventCommandList list({
+		MakeCommand(Cmd::Wait, 0),
+		MakeCommand(Cmd::ControlVars, 0),
+		MakeCommand(Cmd::Wait, 0),
+	});
+	EventCommandList other({
+		MakeCommand(Cmd::ControlVars, 0),
+		MakeCommand(static_cast<Cmd>(65535), 0),
+	});
+
+	CHECK_EQ(list.GetSlot(0), list.GetSlot(2));
+	CHECK_NE(list.GetSlot(0), list.GetSlot(1));
+	CHECK_EQ(list.GetSlot(1), other.GetSlot(0));
+	CHECK_NE(other.GetSlot(1), list.GetSlot(0));
+	CHECK_NE(other.GetSlot(1), list.GetSlot(1));
+
+	CHECK_EQ(EventCommandList::GetCodeSlot(static_cast<int>(Cmd::Wait)), list.GetSlot(0));
+	CHECK_EQ(EventCommandList::GetCodeSlot(65535), other.GetSlot(1));
+}
+
+TEST_SUITE_END();
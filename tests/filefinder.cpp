@@ -1,9 +1,14 @@
 #include <cassert>
 #include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "cmdline_parser.h"
 #include "filefinder.h"
+#include "game_config.h"
 #include "player.h"
 #include "main_data.h"
 #include "doctest.h"
+#include "test_temp_dir.h"
 
 TEST_SUITE_BEGIN("FileFinder");
 
@@ -114,4 +119,95 @@ TEST_CASE("GetPathAndFilename") {
 	Player::escape_symbol = "";
 }
 
+TEST_CASE("DirectoryIndex") {
+	namespace stdfs = std::filesystem;
+
+	TestTempDir tmp("filefinder_index");
+	const std::string game = tmp.GetPath("game");
+	stdfs::create_directories(tmp.GetPath("game/sub"));
+	std::ofstream(tmp.GetPath("game/a.txt"));
+	std::ofstream(tmp.GetPath("game/sub/b.txt"));
+
+	// Recently modified directories are not indexed
+	for (const auto& dir : { game, tmp.GetPath("game/sub") }) {
+		stdfs::last_write_time(dir, stdfs::last_write_time(dir) - std::chrono::hours(1));
+	}
+
+	CmdlineParser cp({ "testapp", "--config-path", tmp.GetPath("config") });
+	Game_Config::Create(cp);
+	Player::player_config.directory_index.Set(true);
+
+	auto names = [](const FilesystemView& fs, StringView dir) {
+		std::vector<std::string> result;
+		for (const auto& e : *fs.ListDirectory(dir)) {
+			result.push_back(e.second.name);
+		}
+		return result;
+	};
+	auto index_path = [&]() {
+		return stdfs::directory_iterator(tmp.GetPath("config/DirectoryIndex"))->path();
+	};
+	auto read_index = [&]() {
+		std::ifstream is(index_path());
+		std::stringstream ss;
+		ss << is.rdbuf();
+		return ss.str();
+	};
+	auto write_index = [&](const std::string& index) {
+		std::ofstream(index_path()) << index;
+	};
+	auto start = [&]() {
+		FileFinder::Quit();
+		auto fs = FileFinder::Root().Create(game);
+		FileFinder::LoadDirectoryIndex(fs);
+		return fs;
+	};
+
+	// No index: Written on shutdown, including directories listed before the
+	// index was loaded
+	FileFinder::Quit();
+	auto fs = FileFinder::Root().Create(game);
+	CHECK(names(fs, "") == std::vector<std::string>{ "a.txt", "sub" });
+	FileFinder::LoadDirectoryIndex(fs);
+	CHECK(names(fs, "") == std::vector<std::string>{ "a.txt", "sub" });
+	CHECK(names(fs, "sub") == std::vector<std::string>{ "b.txt" });
+	FileFinder::SaveDirectoryIndexes();
+
+	const std::string index = read_index();
+	REQUIRE(index.find("a.txt") != std::string::npos);
+	REQUIRE(index.find("b.txt") != std::string::npos);
+
+	// Fresh index: The listing comes from the index
+	auto modified = index;
+	modified.replace(modified.find("b.txt"), 5, "c.txt");
+	write_index(modified);
+	fs = start();
+	CHECK(names(fs, "sub") == std::vector<std::string>{ "c.txt" });
+
+	// Stale index: Same modification time but a different size
+	auto resized = modified;
+	auto size_pos = resized.find(' ', resized.rfind("> ", resized.find("c.txt")) + 2) + 1;
+	auto size_len = resized.find(' ', size_pos) - size_pos;
+	resized.replace(size_pos, size_len, std::to_string(std::stoll(resized.substr(size_pos, size_len)) + 1));
+	write_index(resized);
+	fs = start();
+	CHECK(names(fs, "sub") == std::vector<std::string>{ "b.txt" });
+
+	// Stale index: The directory was modified, it is too recent for the next index
+	write_index(modified);
+	std::ofstream(tmp.GetPath("game/sub/d.txt"));
+	fs = start();
+	CHECK(names(fs, "") == std::vector<std::string>{ "a.txt", "sub" });
+	CHECK(names(fs, "sub") == std::vector<std::string>{ "b.txt", "d.txt" });
+	FileFinder::SaveDirectoryIndexes();
+
+	const std::string new_index = read_index();
+	CHECK(new_index.find("a.txt") != std::string::npos);
+	CHECK(new_index.find("b.txt") == std::string::npos);
+	CHECK(new_index.find("d.txt") == std::string::npos);
+
+	Player::player_config.directory_index.Set(false);
+	FileFinder::Quit();
+}
+
 TEST_SUITE_END();
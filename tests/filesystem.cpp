@@ -1,8 +1,10 @@
 #include "filesystem.h"
 #include "filefinder.h"
+#include "filesystem_native.h"
 #include "main_data.h"
 #include "doctest.h"
 #include "player.h"
+#include <sstream>
 
 TEST_SUITE_BEGIN("Filesystem");
 
@@ -88,4 +90,59 @@ TEST_CASE("FindFile") {
 	Player::escape_symbol = "";
 }
 
+TEST_CASE("DirectoryIndex") {
+	auto native = std::make_shared<NativeFilesystem>("", FilesystemView());
+	const std::string root = EP_TEST_PATH "/game";
+	const std::string charset = root + "/Charset";
+
+	// Without an index file the listings below root are remembered
+	auto tree = DirectoryTree::Create(*native);
+	std::istringstream empty;
+	CHECK(!tree->LoadIndex(empty, root));
+
+	std::ostringstream os;
+	CHECK(tree->ListDirectory(root)->size() == 4);
+	CHECK(tree->ListDirectory(charset)->size() == 1);
+	tree->WriteIndex(os, root);
+	const std::string index = os.str();
+	REQUIRE(index.find("chara1.png") != std::string::npos);
+
+	// An unchanged directory is taken from the index
+	auto modified = index;
+	modified.replace(modified.find("chara1.png"), 10, "chara2.png");
+	tree = DirectoryTree::Create(*native);
+	std::istringstream is(modified);
+	CHECK(tree->LoadIndex(is, root));
+	auto* list = tree->ListDirectory(charset);
+	REQUIRE(list->size() == 1);
+	CHECK((*list)[0].second.name == "chara2.png");
+
+	// A directory with a different size is read again
+	auto size_pos = modified.find(' ', modified.rfind("> ", modified.find("chara2.png")) + 2) + 1;
+	auto size_len = modified.find(' ', size_pos) - size_pos;
+	auto resized = modified;
+	resized.replace(size_pos, size_len, std::to_string(std::stoll(modified.substr(size_pos, size_len)) + 1));
+	tree = DirectoryTree::Create(*native);
+	is = std::istringstream(resized);
+	CHECK(tree->LoadIndex(is, root));
+	list = tree->ListDirectory(charset);
+	REQUIRE(list->size() == 1);
+	CHECK((*list)[0].second.name == "chara1.png");
+
+	// A changed directory is read again
+	auto mtime_pos = modified.rfind("> ", modified.find("chara2.png")) + 2;
+	modified.replace(mtime_pos, modified.find(' ', mtime_pos) - mtime_pos, "1");
+	tree = DirectoryTree::Create(*native);
+	is = std::istringstream(modified);
+	CHECK(tree->LoadIndex(is, root));
+	list = tree->ListDirectory(charset);
+	REQUIRE(list->size() == 1);
+	CHECK((*list)[0].second.name == "chara1.png");
+
+	// Index for a different root
+	tree = DirectoryTree::Create(*native);
+	is = std::istringstream(index);
+	CHECK(!tree->LoadIndex(is, charset));
+}
+
 TEST_SUITE_END();
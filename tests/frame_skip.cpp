@@ -0,0 +1,62 @@
+#include "frame_skip.h"
+#include "doctest.h"
+
+using namespace std::chrono_literals;
+
+TEST_SUITE_BEGIN("FrameSkip");
+
+static Game_Clock::duration ms(int v) {
+	return std::chrono::duration_cast<Game_Clock::duration>(std::chrono::milliseconds(v));
+}
+
+TEST_CASE("NoMeasurement") {
+	FrameSkip fs;
+	REQUIRE_EQ(fs.GetStepsPerFrame(1.0f), 2);
+	REQUIRE_EQ(fs.GetStepsPerFrame(10.0f), 20);
+}
+
+TEST_CASE("FastDevice") {
+	FrameSkip fs;
+	fs.AddStepTime(std::chrono::duration_cast<Game_Clock::duration>(100us));
+	fs.AddDrawTime(std::chrono::duration_cast<Game_Clock::duration>(10us));
+
+	// Drawing is cheap, the speed factor decides
+	REQUIRE_EQ(fs.GetStepsPerFrame(3.0f), 6);
+	REQUIRE_EQ(fs.GetStepsPerFrame(10.0f), 20);
+}
+
+TEST_CASE("SlowDraw") {
+	FrameSkip fs;
+	fs.AddStepTime(ms(1));
+	fs.AddDrawTime(ms(10));
+
+	// Drawing may only take a tenth of the time
+	REQUIRE_EQ(fs.GetStepsPerFrame(3.0f), 91);
+}
+
+TEST_CASE("MaxFrameTime") {
+	FrameSkip fs;
+	fs.AddStepTime(ms(5));
+	fs.AddDrawTime(ms(100));
+
+	// A frame is drawn at least every 100ms
+	REQUIRE_EQ(fs.GetStepsPerFrame(3.0f), 20);
+
+	// Unless the speed requires more steps
+	REQUIRE_EQ(fs.GetStepsPerFrame(20.0f), 40);
+}
+
+TEST_CASE("Average") {
+	FrameSkip fs;
+	fs.AddStepTime(ms(8));
+	REQUIRE_EQ(fs.GetStepTime(), ms(8));
+
+	fs.AddStepTime(ms(16));
+	REQUIRE_EQ(fs.GetStepTime(), ms(9));
+
+	fs.Reset();
+	REQUIRE_EQ(fs.GetStepTime(), Game_Clock::duration());
+	REQUIRE_EQ(fs.GetDrawTime(), Game_Clock::duration());
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,154 @@
+#include "game_commonevent.h"
+#include "game_map.h"
+#include "game_variables.h"
+#include "main_data.h"
+#include "player.h"
+#include "scene.h"
+#include "worker_pool.h"
+#include "doctest.h"
+#include <lcf/data.h>
+
+#include "mock_game.h"
+
+using Cmd = lcf::rpg::EventCommand::Code;
+
+TEST_SUITE_BEGIN("Game_CommonEvent");
+
+static lcf::rpg::EventCommand MakeCommand(Cmd code, std::vector<int32_t> params = {}) {
+	lcf::rpg::EventCommand com;
+	com.code = static_cast<int>(code);
+	com.parameters = lcf::DBArray<int32_t>(params.begin(), params.end());
+	return com;
+}
+
+TEST_CASE("AnalyzeAccessVariables") {
+	auto access = Game_CommonEvent::AnalyzeAccess({
+		MakeCommand(Cmd::ConditionalBranch, { 0, 7, 0 }),
+		// var[3] += var[4]
+		MakeCommand(Cmd::ControlVars, { 0, 3, 3, 1, 1, 4 }),
+		MakeCommand(Cmd::ElseBranch),
+		// var[2] = 10
+		MakeCommand(Cmd::ControlVars, { 0, 2, 2, 0, 0, 10 }),
+		MakeCommand(Cmd::EndBranch),
+		// var[5] >= var[1]
+		MakeCommand(Cmd::ConditionalBranch, { 1, 5, 1, 1, 1 }),
+		MakeCommand(Cmd::EndBranch),
+		MakeCommand(Cmd::Wait, { 1 }),
+		MakeCommand(Cmd::END),
+	});
+
+	REQUIRE(access.independent);
+	REQUIRE_EQ(access.switch_reads, std::vector<int>{ 7 });
+	REQUIRE_EQ(access.var_reads, std::vector<int>{ 1, 4, 5 });
+	REQUIRE_EQ(access.var_writes, std::vector<int>{ 2, 3 });
+}
+
+TEST_CASE("AnalyzeAccessUnsupported") {
+	// Switches are written
+	REQUIRE_FALSE(Game_CommonEvent::AnalyzeAccess({ MakeCommand(Cmd::ControlSwitches, { 0, 1, 1, 0 }) }).independent);
+	// Range of variables
+	REQUIRE_FALSE(Game_CommonEvent::AnalyzeAccess({ MakeCommand(Cmd::ControlVars, { 1, 1, 5, 0, 0, 1 }) }).independent);
+	// Target in a variable
+	REQUIRE_FALSE(Game_CommonEvent::AnalyzeAccess({ MakeCommand(Cmd::ControlVars, { 2, 1, 1, 0, 0, 1 }) }).independent);
+	// Random number
+	REQUIRE_FALSE(Game_CommonEvent::AnalyzeAccess({ MakeCommand(Cmd::ControlVars, { 0, 1, 1, 0, 3, 1, 10 }) }).independent);
+	// Game state
+	REQUIRE_FALSE(Game_CommonEvent::AnalyzeAccess({ MakeCommand(Cmd::ConditionalBranch, { 3, 100, 0 }) }).independent);
+	// Waits for a key
+	REQUIRE_FALSE(Game_CommonEvent::AnalyzeAccess({ MakeCommand(Cmd::Wait, { 0, 1 }) }).independent);
+	// Other events
+	REQUIRE_FALSE(Game_CommonEvent::AnalyzeAccess({ MakeCommand(Cmd::CallEvent, { 0, 1 }) }).independent);
+	// Invalid ID
+	REQUIRE_FALSE(Game_CommonEvent::AnalyzeAccess({ MakeCommand(Cmd::ControlVars, { 0, 0, 0, 0, 0, 1 }) }).independent);
+
+	auto comment = MakeCommand(Cmd::Comment);
+	comment.string = "@dynrpg";
+	REQUIRE_FALSE(Game_CommonEvent::AnalyzeAccess({ comment }).independent);
+
+	comment.string = "Clock";
+	REQUIRE(Game_CommonEvent::AnalyzeAccess({ comment }).independent);
+}
+
+static lcf::rpg::CommonEvent MakeParallelEvent(int id, std::vector<lcf::rpg::EventCommand> commands) {
+	lcf::rpg::CommonEvent ce;
+	ce.ID = id;
+	ce.trigger = lcf::rpg::EventPage::Trigger_parallel;
+	commands.push_back(MakeCommand(Cmd::END));
+	ce.event_commands = std::move(commands);
+	return ce;
+}
+
+struct CommonEventsResult {
+	std::vector<int> vars;
+	bool page_active = false;
+};
+
+static CommonEventsResult RunCommonEvents(bool parallel) {
+	lcf::Data::commonevents = {
+		// var[1] += 1
+		MakeParallelEvent(1, { MakeCommand(Cmd::ControlVars, { 0, 1, 1, 1, 0, 1 }) }),
+		// var[2] += var[1], depends on the write before
+		MakeParallelEvent(2, { MakeCommand(Cmd::ControlVars, { 0, 2, 2, 1, 1, 1 }) }),
+		// var[3] += 2
+		MakeParallelEvent(3, { MakeCommand(Cmd::ControlVars, { 0, 3, 3, 1, 0, 2 }) }),
+		// var[4] += var[3], depends on the write before
+		MakeParallelEvent(4, { MakeCommand(Cmd::ControlVars, { 0, 4, 4, 1, 1, 3 }) }),
+		// var[9] += 1, the map event page depends on it
+		MakeParallelEvent(5, { MakeCommand(Cmd::ControlVars, { 0, 9, 9, 1, 0, 1 }) }),
+		// var[5] += var[9]
+		MakeParallelEvent(6, { MakeCommand(Cmd::ControlVars, { 0, 5, 5, 1, 1, 9 }) }),
+		// var[2] += 100, writes the same variable as event 2
+		MakeParallelEvent(7, { MakeCommand(Cmd::ControlVars, { 0, 2, 2, 1, 0, 100 }) }),
+	};
+
+	auto map = MakeMockMap(MockMap::ePass40x30);
+	auto& condition = map->events[0].pages[0].condition;
+	condition.flags.variable = true;
+	condition.variable_id = 9;
+	condition.variable_value = 2;
+
+	const MockGame mg(std::move(map));
+	Scene::instance = std::make_shared<Scene>();
+	Main_Data::game_variables->Set(9, 0);
+
+	const bool parallel_config = Player::player_config.parallel_common_events.Get();
+	Player::player_config.parallel_common_events.Set(parallel);
+	const int num_workers = WorkerPool::SetNumWorkers(parallel ? 2 : 0);
+
+	for (auto& ce: Game_Map::GetCommonEvents()) {
+		REQUIRE(ce.CanUpdateConcurrently());
+	}
+
+	for (int i = 0; i < 3; ++i) {
+		MapUpdateAsyncContext actx;
+		REQUIRE(Game_Map::UpdateCommonEvents(actx));
+		if (Game_Map::GetNeedRefresh()) {
+			Game_Map::Refresh();
+		}
+	}
+
+	WorkerPool::SetNumWorkers(num_workers);
+	Player::player_config.parallel_common_events.Set(parallel_config);
+
+	CommonEventsResult result;
+	for (int i = 1; i <= 9; ++i) {
+		result.vars.push_back(Main_Data::game_variables->Get(i));
+	}
+	result.page_active = MockGame::GetEvent(1)->GetActivePage() != nullptr;
+
+	Scene::instance.reset();
+	lcf::Data::commonevents.clear();
+	return result;
+}
+
+TEST_CASE("UpdateParallel") {
+	const auto serial = RunCommonEvents(false);
+	REQUIRE_EQ(serial.vars, std::vector<int>{ 3, 306, 6, 12, 6, 0, 0, 0, 3 });
+	REQUIRE(serial.page_active);
+
+	const auto parallel = RunCommonEvents(true);
+	REQUIRE_EQ(parallel.vars, serial.vars);
+	REQUIRE(parallel.page_active);
+}
+
+TEST_SUITE_END();
@@ -5,6 +5,8 @@
 #include "main_data.h"
 #include <climits>
 
+#include "mock_game.h"
+
 TEST_SUITE_BEGIN("Game_Event");
 
 TEST_CASE("IdName") {
@@ -28,4 +30,72 @@ TEST_CASE("IdName") {
 	}
 }
 
+TEST_CASE("IdleStationary") {
+	const MockGame mg(MockMap::ePass40x30);
+	auto& ch = *MockGame::GetEvent(1);
+
+	// The step animation has to settle before the event becomes idle
+	int frames = 0;
+	while (!ch.IsIdle() && frames < 255) {
+		ForceUpdate(ch);
+		++frames;
+	}
+	REQUIRE(ch.IsIdle());
+	REQUIRE_EQ(frames, Game_Character::GetStationaryAnimFrames(ch.GetMoveSpeed()) - 1);
+
+	const auto anim_count = ch.GetAnimCount();
+	const auto anim_frame = ch.GetAnimFrame();
+	const auto stop_count = ch.GetStopCount();
+	for (int i = 1; i <= 10; ++i) {
+		ForceUpdate(ch);
+		REQUIRE(ch.IsProcessed());
+		REQUIRE_EQ(ch.GetStopCount(), stop_count + i);
+		REQUIRE_EQ(ch.GetAnimCount(), anim_count);
+		REQUIRE_EQ(ch.GetAnimFrame(), anim_frame);
+	}
+
+	ch.SetProcessed(false);
+	ch.Flash(31, 31, 31, 31, 10);
+	REQUIRE(!ch.IsIdle());
+
+	ch.SetFlashLevel(0);
+	ch.SetFlashTimeLeft(0);
+	REQUIRE(ch.IsIdle());
+
+	ch.SetAnimationType(lcf::rpg::EventPage::AnimType_spin);
+	REQUIRE(!ch.IsIdle());
+
+	ch.SetAnimationType(lcf::rpg::EventPage::AnimType_non_continuous);
+	lcf::rpg::MoveRoute mr;
+	mr.move_commands.push_back({ int(lcf::rpg::MoveCommand::Code::turn_180_degree) });
+	ch.ForceMoveRoute(mr, 3);
+	REQUIRE(!ch.IsIdle());
+}
+
+TEST_CASE("DestroyKeepsSharedMap") {
+	auto writable = MakeMockMap(MockMap::ePass40x30);
+	writable->events.push_back(writable->events.back());
+	writable->events.back().ID = 2;
+	writable->events.back().name = "B";
+	std::shared_ptr<const lcf::rpg::Map> map = std::move(writable);
+
+	const MockGame mg(map);
+	REQUIRE_EQ(&Game_Map::GetMap(), map.get());
+
+	// Without a scene, the references are updated like CloneMapEvent does
+	Game_Map::DestroyMapEvent(1, true);
+	Game_Map::UpdateUnderlyingEventReferences();
+
+	// The map was copied, the shared map is unchanged
+	REQUIRE_NE(&Game_Map::GetMap(), map.get());
+	REQUIRE_EQ(map->events.size(), 2);
+	REQUIRE_EQ(Game_Map::GetMap().events.size(), 1);
+	REQUIRE_EQ(MockGame::GetEvent(1), nullptr);
+
+	// The events refer to the copy
+	auto* ev = MockGame::GetEvent(2);
+	REQUIRE_NE(ev, nullptr);
+	REQUIRE_EQ(ev->GetName().data(), Game_Map::GetMap().events[0].name.data());
+}
+
 TEST_SUITE_END();
@@ -0,0 +1,129 @@
+#include "game_interpreter_map.h"
+#include "game_commonevent.h"
+#include "game_event.h"
+#include "game_map.h"
+#include "doctest.h"
+#include <lcf/data.h>
+
+#include "mock_game.h"
+
+using Cmd = lcf::rpg::EventCommand::Code;
+
+TEST_SUITE_BEGIN("Game_Interpreter");
+
+static lcf::rpg::EventCommand MakeCommand(Cmd code, std::vector<int32_t> params = {}) {
+	lcf::rpg::EventCommand com;
+	com.code = static_cast<int>(code);
+	com.parameters = lcf::DBArray<int32_t>(params.begin(), params.end());
+	return com;
+}
+
+static std::vector<lcf::rpg::EventCommand> MakeCommands(int wait) {
+	return { MakeCommand(Cmd::Wait, { wait }), MakeCommand(Cmd::END) };
+}
+
+static MockGame MakeGame() {
+	lcf::Data::commonevents.resize(1);
+	lcf::Data::commonevents[0].ID = 1;
+	lcf::Data::commonevents[0].event_commands = MakeCommands(2);
+
+	auto map = MakeMockMap(MockMap::ePass40x30);
+	map->events[0].pages[0].event_commands = MakeCommands(1);
+	return MockGame(std::move(map));
+}
+
+TEST_CASE("FramesShareCommands") {
+	const auto mg = MakeGame();
+	auto* ev = MockGame::GetEvent(1);
+	auto& ce = Game_Map::GetCommonEvents()[0];
+
+	Game_Interpreter_Map interp;
+	interp.Push(ev, ev->GetPage(1), false);
+	interp.Push(ev, ev->GetPage(1), false);
+	interp.Push(&ce);
+	interp.Push(MakeCommands(3), 0);
+
+	REQUIRE_EQ(interp.GetState().stack.size(), 4);
+	for (auto& frame: interp.GetState().stack) {
+		REQUIRE(frame.commands.empty());
+	}
+
+	// Frames of the same page use the same list
+	REQUIRE_EQ(&interp.GetFrameCommands(0), &interp.GetFrameCommands(1));
+	REQUIRE_EQ(&interp.GetFrameCommands(0), &ev->GetSharedList(ev->GetPage(1))->GetCommands());
+	REQUIRE_EQ(&interp.GetFrameCommands(2), &ce.GetSharedList()->GetCommands());
+	REQUIRE_EQ(interp.GetFrameCommands(3), MakeCommands(3));
+
+	lcf::Data::commonevents.clear();
+}
+
+TEST_CASE("SaveStateCommands") {
+	const auto mg = MakeGame();
+	auto* ev = MockGame::GetEvent(1);
+	auto& ce = Game_Map::GetCommonEvents()[0];
+
+	Game_Interpreter_Map interp;
+	interp.Push(ev, ev->GetPage(1), false);
+	interp.Push(&ce);
+	interp.Push(MakeCommands(3), 0);
+
+	auto save = interp.GetSaveState();
+	REQUIRE_EQ(save.stack.size(), 3);
+	REQUIRE_EQ(save.stack[0].commands, MakeCommands(1));
+	REQUIRE_EQ(save.stack[1].commands, MakeCommands(2));
+	REQUIRE_EQ(save.stack[2].commands, MakeCommands(3));
+
+	// The interpreter state is unchanged
+	for (auto& frame: interp.GetState().stack) {
+		REQUIRE(frame.commands.empty());
+	}
+
+	lcf::Data::commonevents.clear();
+}
+
+TEST_CASE("SetStateSharesCommands") {
+	const auto mg = MakeGame();
+	auto* ev = MockGame::GetEvent(1);
+	auto& ce = Game_Map::GetCommonEvents()[0];
+
+	Game_Interpreter_Map interp;
+	interp.Push(ev, ev->GetPage(1), false);
+	interp.Push(ev, ev->GetPage(1), false);
+	interp.Push(&ce);
+	interp.Push(MakeCommands(3), 0);
+	interp.Push(ev, ev->GetPage(1), false);
+
+	auto save = interp.GetSaveState();
+	// Commands of the event changed since the save was written
+	save.stack[1].commands.insert(save.stack[1].commands.begin(), MakeCommand(Cmd::Wait, { 4 }));
+	// Commands of an event on a different map
+	save.stack[4].event_id = 0;
+
+	Game_Interpreter_Map loaded;
+	loaded.SetState(save);
+
+	for (auto& frame: loaded.GetState().stack) {
+		REQUIRE(frame.commands.empty());
+	}
+
+	// Unchanged commands are shared again
+	REQUIRE_EQ(&loaded.GetFrameCommands(0), &ev->GetSharedList(ev->GetPage(1))->GetCommands());
+	REQUIRE_EQ(&loaded.GetFrameCommands(2), &ce.GetSharedList()->GetCommands());
+
+	// Other commands are private copies
+	REQUIRE_NE(&loaded.GetFrameCommands(1), &loaded.GetFrameCommands(0));
+	REQUIRE_EQ(loaded.GetFrameCommands(1), save.stack[1].commands);
+	REQUIRE_EQ(loaded.GetFrameCommands(3), MakeCommands(3));
+	REQUIRE_NE(&loaded.GetFrameCommands(4), &loaded.GetFrameCommands(0));
+	REQUIRE_EQ(loaded.GetFrameCommands(4), MakeCommands(1));
+
+	// Saving again gives the same commands
+	auto resave = loaded.GetSaveState();
+	for (size_t i = 0; i < save.stack.size(); ++i) {
+		REQUIRE_EQ(resave.stack[i].commands, save.stack[i].commands);
+	}
+
+	lcf::Data::commonevents.clear();
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,50 @@
+#include "game_scanner.h"
+#include "filefinder.h"
+#include "player.h"
+#include "main_data.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("GameScanner");
+
+TEST_CASE("Probe") {
+	Main_Data::Init();
+
+	Player::escape_symbol = "\\";
+
+	auto info = GameScanner::Probe(FileFinder::Root().Subtree(EP_TEST_PATH "/game"));
+	CHECK(info.status == GameScanner::GameInfo::Status::Game);
+	CHECK(info.title.empty());
+
+	info = GameScanner::Probe(FileFinder::Root().Subtree(EP_TEST_PATH "/notagame"));
+	CHECK(info.status == GameScanner::GameInfo::Status::NoGame);
+
+	Player::escape_symbol = "";
+}
+
+TEST_CASE("Update") {
+	Main_Data::Init();
+
+	Player::escape_symbol = "\\";
+
+	GameScanner::ClearCache();
+
+	std::vector<GameScanner::GameInfo> infos(2);
+	GameScanner scanner(FileFinder::Root().Subtree(EP_TEST_PATH), { "game", "notagame" });
+
+	int reported = 0;
+	while (!scanner.Update([&](int index, const GameScanner::GameInfo& info) {
+		REQUIRE(index >= 0);
+		REQUIRE(index < 2);
+		CHECK(infos[index].status == GameScanner::GameInfo::Status::Pending);
+		infos[index] = info;
+		++reported;
+	})) {}
+
+	CHECK(reported == 2);
+	CHECK(infos[0].status == GameScanner::GameInfo::Status::Game);
+	CHECK(infos[1].status == GameScanner::GameInfo::Status::NoGame);
+
+	Player::escape_symbol = "";
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,118 @@
+#include "game_strings.h"
+#include "game_variables.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("Game_Strings");
+
+namespace {
+	Game_Strings::Str_Params Params(int id) {
+		Game_Strings::Str_Params params;
+		params.string_id = id;
+		return params;
+	}
+
+	Game_Variables MakeVariables() {
+		lcf::Data::variables.resize(10);
+		Game_Variables v(Game_Variables::min_2k3, Game_Variables::max_2k3);
+		v.SetLowerLimit(10);
+		v.SetWarning(0);
+		return v;
+	}
+}
+
+TEST_CASE("AsgGet") {
+	Game_Strings s;
+	REQUIRE_EQ(s.Get(1), "");
+
+	s.Asg(Params(1), "abc");
+	REQUIRE_EQ(s.Get(1), "abc");
+
+	s.Asg(Params(Game_Strings::max_dense_id + 100), "sparse");
+	REQUIRE_EQ(s.Get(Game_Strings::max_dense_id + 100), "sparse");
+	REQUIRE_EQ(s.Get(Game_Strings::max_dense_id + 101), "");
+
+	s.Cat(Params(1), "def");
+	REQUIRE_EQ(s.Get(1), "abcdef");
+}
+
+TEST_CASE("ToNumUnassigned") {
+	Game_Strings s;
+	auto v = MakeVariables();
+	v.Set(1, 5);
+
+	// Assigning a higher id must not make lower ids exist
+	s.Asg(Params(3), "1");
+	REQUIRE_EQ(s.ToNum(Params(2), 1, v), 0);
+	REQUIRE_EQ(v.Get(1), 5);
+
+	REQUIRE_EQ(s.ToNum(Params(3), 1, v), 1);
+	REQUIRE_EQ(v.Get(1), 1);
+}
+
+TEST_CASE("PopLine") {
+	Game_Strings s;
+	s.Asg(Params(1), "one\ntwo\r\nthree\rfour");
+
+	REQUIRE_EQ(s.PopLine(Params(1), 0, 2), "one");
+	REQUIRE_EQ(s.Get(1), "two\r\nthree\rfour");
+
+	REQUIRE_EQ(s.PopLine(Params(1), 1, 2), "three");
+	REQUIRE_EQ(s.Get(1), "four");
+
+	REQUIRE_EQ(s.PopLine(Params(1), 0, 2), "four");
+	REQUIRE_EQ(s.Get(1), "");
+
+	REQUIRE_EQ(s.PopLine(Params(1), 0, 2), "");
+	REQUIRE_EQ(s.Get(1), "");
+}
+
+TEST_CASE("PopLineEmptyLines") {
+	Game_Strings s;
+	s.Asg(Params(1), "\n\nx\n");
+
+	REQUIRE_EQ(s.PopLine(Params(1), 0, 2), "");
+	REQUIRE_EQ(s.PopLine(Params(1), 0, 2), "");
+	REQUIRE_EQ(s.PopLine(Params(1), 0, 2), "x");
+	REQUIRE_EQ(s.Get(1), "");
+}
+
+TEST_CASE("PopLinePastEnd") {
+	Game_Strings s;
+	s.Asg(Params(1), "a\nb");
+
+	REQUIRE_EQ(s.PopLine(Params(1), 5, 2), "");
+	REQUIRE_EQ(s.Get(1), "");
+}
+
+TEST_CASE("PopLineMany") {
+	Game_Strings s;
+	std::string text;
+	for (int i = 0; i < 1000; ++i) {
+		text += std::to_string(i) + "\n";
+	}
+	s.Asg(Params(1), text);
+
+	for (int i = 0; i < 1000; ++i) {
+		REQUIRE_EQ(s.PopLine(Params(1), 0, 2), std::to_string(i));
+		REQUIRE_EQ(s.Get(1).substr(0, 1), i < 999 ? std::to_string(i + 1).substr(0, 1) : "");
+	}
+}
+
+TEST_CASE("Split") {
+	Game_Strings s;
+	auto v = MakeVariables();
+	s.Asg(Params(1), "a,bb,,c");
+
+	REQUIRE_EQ(s.Split(Params(1), ",", 2, 1, v), 3);
+	REQUIRE_EQ(v.Get(1), 3);
+	REQUIRE_EQ(s.Get(2), "a");
+	REQUIRE_EQ(s.Get(3), "bb");
+	REQUIRE_EQ(s.Get(4), "");
+	REQUIRE_EQ(s.Get(5), "c");
+
+	s.Asg(Params(1), "abc");
+	REQUIRE_EQ(s.Split(Params(1), ",", 2, 1, v), 1);
+	REQUIRE_EQ(s.Get(2), "abc");
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,121 @@
+#include "game_windows.h"
+#include "bitmap.h"
+#include "pixel_format.h"
+#include "doctest.h"
+#include <algorithm>
+
+using Window_User = Game_Windows::Window_User;
+
+TEST_SUITE_BEGIN("Game_Windows");
+
+static Window_User::DrawnText MakeText(const std::string& text, Rect rect) {
+	Window_User::DrawnText drawn;
+	drawn.text.text = lcf::DBString(text);
+	drawn.text.position_x = rect.x;
+	drawn.text.position_y = rect.y;
+	drawn.lines = { text };
+	drawn.rect = rect;
+	return drawn;
+}
+
+static std::vector<Window_User::DrawnText> MakeTexts() {
+	return {
+		MakeText("A", { 0, 0, 40, 16 }),
+		MakeText("B", { 30, 10, 40, 16 }),
+		MakeText("C", { 0, 40, 40, 16 }),
+		MakeText("D", { 60, 20, 40, 16 })
+	};
+}
+
+TEST_CASE("DirtyTextsFullRedraw") {
+	const auto texts = MakeTexts();
+
+	// Nothing is drawn yet
+	std::vector<Rect> cleared;
+	CHECK(Window_User::FindDirtyTexts({}, texts, cleared) == std::vector<bool>{ true, true, true, true });
+}
+
+TEST_CASE("DirtyTextsUnchanged") {
+	const auto texts = MakeTexts();
+
+	std::vector<Rect> cleared;
+	CHECK(Window_User::FindDirtyTexts(texts, texts, cleared) == std::vector<bool>{ false, false, false, false });
+	CHECK(cleared.empty());
+}
+
+TEST_CASE("DirtyTextsChanged") {
+	const auto drawn = MakeTexts();
+
+	// Only the changed text is redrawn
+	auto texts = drawn;
+	texts[2] = MakeText("X", { 0, 40, 40, 16 });
+	std::vector<Rect> cleared;
+	CHECK(Window_User::FindDirtyTexts(drawn, texts, cleared) == std::vector<bool>{ false, false, true, false });
+	CHECK(cleared == std::vector<Rect>{ { 0, 40, 40, 16 }, { 0, 40, 40, 16 } });
+
+	// A different font is a change
+	texts = drawn;
+	texts[2].font = Font::Default();
+	cleared.clear();
+	CHECK(Window_User::FindDirtyTexts(drawn, texts, cleared) == std::vector<bool>{ false, false, true, false });
+}
+
+TEST_CASE("DirtyTextsOverlapping") {
+	const auto drawn = MakeTexts();
+
+	// A overlaps B, B overlaps D: all of them are cleared and redrawn
+	auto texts = drawn;
+	texts[0] = MakeText("X", { 0, 0, 40, 16 });
+	std::vector<Rect> cleared;
+	CHECK(Window_User::FindDirtyTexts(drawn, texts, cleared) == std::vector<bool>{ true, true, false, true });
+
+	// The new area of a moved text overlaps C
+	texts = drawn;
+	texts[1] = MakeText("B", { 30, 30, 40, 16 });
+	cleared.clear();
+	CHECK(Window_User::FindDirtyTexts(drawn, texts, cleared) == std::vector<bool>{ true, true, true, true });
+}
+
+TEST_CASE("DirtyTextsAddRemove") {
+	const auto drawn = MakeTexts();
+
+	// An added text is drawn
+	auto texts = drawn;
+	texts.push_back(MakeText("E", { 100, 60, 40, 16 }));
+	std::vector<Rect> cleared;
+	CHECK(Window_User::FindDirtyTexts(drawn, texts, cleared) == std::vector<bool>{ false, false, false, false, true });
+
+	// The area of a removed text is cleared and the texts overlapping it are redrawn
+	texts = drawn;
+	texts.pop_back();
+	cleared.clear();
+	CHECK(Window_User::FindDirtyTexts(drawn, texts, cleared) == std::vector<bool>{ true, true, false });
+	CHECK(std::find(cleared.begin(), cleared.end(), Rect(60, 20, 40, 16)) != cleared.end());
+	CHECK(std::find(cleared.begin(), cleared.end(), Rect(0, 40, 40, 16)) == cleared.end());
+}
+
+TEST_CASE("SameWindow") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	lcf::rpg::SaveEasyRpgWindow drawn;
+	drawn.width = 160;
+	drawn.height = 80;
+	auto system = Bitmap::Create(160, 80, false);
+
+	auto data = drawn;
+	data.texts.push_back(MakeText("A", { 0, 0, 40, 16 }).text);
+	CHECK(Window_User::IsSameWindow(drawn, system, data, system));
+
+	data = drawn;
+	data.width = 320;
+	CHECK(!Window_User::IsSameWindow(drawn, system, data, system));
+
+	data = drawn;
+	data.flags.draw_frame = !drawn.flags.draw_frame;
+	CHECK(!Window_User::IsSameWindow(drawn, system, data, system));
+
+	// A different system graphic needs a new window
+	CHECK(!Window_User::IsSameWindow(drawn, system, drawn, Bitmap::Create(160, 80, false)));
+	CHECK(!Window_User::IsSameWindow(drawn, system, drawn, nullptr));
+}
+
+TEST_SUITE_END();
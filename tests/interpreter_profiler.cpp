@@ -0,0 +1,74 @@
+#include <chrono>
+#include <sstream>
+#include "interpreter_profiler.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("InterpreterProfiler");
+
+namespace {
+	using Frame = InterpreterProfiler::Frame;
+
+	Frame MakeFrame(Frame::Type type, int id, int page_id, int command_index, int code) {
+		Frame frame;
+		frame.type = type;
+		frame.map_id = 1;
+		frame.id = id;
+		frame.page_id = page_id;
+		frame.command_index = command_index;
+		frame.code = code;
+		return frame;
+	}
+}
+
+TEST_CASE("Stats") {
+	InterpreterProfiler::Reset();
+
+	auto ev = MakeFrame(Frame::Type::MapEvent, 5, 1, 3, 12330);
+	auto ce = MakeFrame(Frame::Type::CommonEvent, 2, 0, 0, 10110);
+
+	InterpreterProfiler::Record({ ce }, std::chrono::microseconds(10));
+	InterpreterProfiler::Record({ ev, ce }, std::chrono::microseconds(100));
+	InterpreterProfiler::Record({ ev }, std::chrono::microseconds(5));
+
+	auto stats = InterpreterProfiler::GetStats();
+	REQUIRE_EQ(stats.size(), 2);
+
+	// Same command through different call stacks is merged
+	REQUIRE_EQ(stats[0].frame.id, 2);
+	REQUIRE_EQ(stats[0].count, 2);
+	REQUIRE(stats[0].time == std::chrono::microseconds(110));
+
+	REQUIRE_EQ(stats[1].frame.id, 5);
+	REQUIRE_EQ(stats[1].count, 1);
+
+	InterpreterProfiler::Reset();
+	REQUIRE(InterpreterProfiler::GetStats().empty());
+}
+
+TEST_CASE("FrameName") {
+	REQUIRE_EQ(InterpreterProfiler::GetFrameName(MakeFrame(Frame::Type::MapEvent, 5, 1, 0, 0)), "EV0005[1]");
+	REQUIRE_EQ(InterpreterProfiler::GetFrameName(MakeFrame(Frame::Type::MapEvent, 5, 0, 0, 0)), "EV0005");
+	REQUIRE_EQ(InterpreterProfiler::GetFrameName(MakeFrame(Frame::Type::CommonEvent, 12, 0, 0, 0)), "CE0012");
+	REQUIRE_EQ(InterpreterProfiler::GetFrameName(MakeFrame(Frame::Type::BattleEvent, 3, 2, 0, 0)), "TR0003[2]");
+}
+
+TEST_CASE("Output") {
+	InterpreterProfiler::Reset();
+
+	auto ev = MakeFrame(Frame::Type::MapEvent, 5, 1, 3, 12330);
+	auto ce = MakeFrame(Frame::Type::CommonEvent, 2, 0, 0, 10110);
+	InterpreterProfiler::Record({ ev, ce }, std::chrono::microseconds(100));
+
+	std::stringstream csv;
+	InterpreterProfiler::WriteCsv(csv);
+	REQUIRE_EQ(csv.str(), "map_id,type,id,page_id,command_index,code,count,time_us\n"
+		"1,common_event,2,0,0,10110,1,100\n");
+
+	std::stringstream folded;
+	InterpreterProfiler::WriteFolded(folded);
+	REQUIRE_EQ(folded.str(), "Map0001;EV0005[1];cmd12330@3;CE0002;cmd10110@0 100\n");
+
+	InterpreterProfiler::Reset();
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,79 @@
+#include "map_file_cache.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("MapFileCache");
+
+namespace {
+	MapFileCache::MapPtr MakeMap(int chipset_id) {
+		auto map = std::make_shared<lcf::rpg::Map>();
+		map->chipset_id = chipset_id;
+		return map;
+	}
+}
+
+TEST_CASE("PutGet") {
+	MapFileCache::Clear();
+
+	MapFileCache::Key key = { "Map0001.lmu", 100, "" };
+	REQUIRE(MapFileCache::Get(key) == nullptr);
+	REQUIRE(!MapFileCache::IsCachedOrPending(key));
+
+	MapFileCache::Put(key, MakeMap(1));
+	auto map = MapFileCache::Get(key);
+	REQUIRE(map != nullptr);
+	REQUIRE_EQ(map->chipset_id, 1);
+	REQUIRE(MapFileCache::IsCachedOrPending(key));
+
+	MapFileCache::Clear();
+	REQUIRE(MapFileCache::Get(key) == nullptr);
+}
+
+TEST_CASE("KeyMismatch") {
+	MapFileCache::Clear();
+
+	MapFileCache::Put({ "Map0001.lmu", 100, "" }, MakeMap(1));
+
+	REQUIRE(MapFileCache::Get({ "Map0001.lmu", 101, "" }) == nullptr);
+	REQUIRE(MapFileCache::Get({ "Map0001.lmu", 100, "German" }) == nullptr);
+	REQUIRE(MapFileCache::Get({ "Map0002.lmu", 100, "" }) == nullptr);
+
+	MapFileCache::Put({ "Map0001.lmu", 100, "German" }, MakeMap(2));
+	REQUIRE_EQ(MapFileCache::Get({ "Map0001.lmu", 100, "" })->chipset_id, 1);
+	REQUIRE_EQ(MapFileCache::Get({ "Map0001.lmu", 100, "German" })->chipset_id, 2);
+
+	MapFileCache::Clear();
+}
+
+TEST_CASE("EvictLeastRecentlyUsed") {
+	MapFileCache::Clear();
+
+	auto key = [](int i) { return MapFileCache::Key{ "Map" + std::to_string(i), 1, "" }; };
+
+	MapFileCache::Put(key(0), MakeMap(0));
+	for (int i = 1; i < 100; ++i) {
+		MapFileCache::Put(key(i), MakeMap(i));
+		// Keeps map 0 alive
+		REQUIRE(MapFileCache::Get(key(0)) != nullptr);
+	}
+
+	REQUIRE(MapFileCache::Get(key(1)) == nullptr);
+	REQUIRE(MapFileCache::Get(key(99)) != nullptr);
+
+	MapFileCache::Clear();
+}
+
+TEST_CASE("NotPrefetched") {
+	MapFileCache::Clear();
+
+	MapFileCache::Key key = { "Map0001.lmu", 100, "" };
+	REQUIRE(!MapFileCache::TakePrefetched(key));
+
+	// Parsed maps are not handed out as file content
+	MapFileCache::Put(key, MakeMap(1));
+	REQUIRE(!MapFileCache::TakePrefetched(key));
+	REQUIRE(MapFileCache::Get(key) != nullptr);
+
+	MapFileCache::Clear();
+}
+
+TEST_SUITE_END();
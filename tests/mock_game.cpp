@@ -16,7 +16,10 @@ static lcf::rpg::Chipset MakeChipset() {
 	return chipset;
 }
 
-MockGame::MockGame(MockMap maptag) {
+MockGame::MockGame(MockMap maptag) : MockGame(MakeMockMap(maptag)) {
+}
+
+MockGame::MockGame(std::shared_ptr<const lcf::rpg::Map> map) {
 	Input::ResetKeys();
 
 	lcf::Data::terrains.push_back(MakeTerrain());
@@ -44,7 +47,7 @@ MockGame::MockGame(MockMap maptag) {
 	Main_Data::game_player = std::make_unique<Game_Player>();
 	Main_Data::game_player->SetMapId(1);
 
-	Game_Map::Setup(MakeMockMap(maptag));
+	Game_Map::Setup(std::move(map));
 }
 
 Game_Player* MockGame::GetPlayer() {
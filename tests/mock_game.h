@@ -30,6 +30,7 @@ std::unique_ptr<lcf::rpg::Map> MakeMockMap(MockMap maptag);
 class MockGame {
 public:
 	explicit MockGame(MockMap maptag);
+	explicit MockGame(std::shared_ptr<const lcf::rpg::Map> map);
 
 	MockGame(const MockGame&) = delete;
 	MockGame& operator=(const MockGame&) = delete;
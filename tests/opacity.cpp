@@ -0,0 +1,38 @@
+#include "opacity.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("Opacity");
+
+TEST_CASE("OpacitySpansEmpty") {
+	OpacitySpans spans;
+	CHECK(spans.Empty());
+
+	spans.AddRow();
+	CHECK(!spans.Empty());
+	CHECK(spans.RowBegin(0) == spans.RowEnd(0));
+}
+
+TEST_CASE("OpacitySpansRows") {
+	OpacitySpans spans;
+
+	spans.AddRow();
+	spans.Add(2, 3);
+	spans.Add(8, 1);
+	spans.AddRow();
+	spans.AddRow();
+	spans.Add(0, 10);
+
+	REQUIRE(spans.RowEnd(0) - spans.RowBegin(0) == 2);
+	CHECK(spans.RowBegin(0)[0].x == 2);
+	CHECK(spans.RowBegin(0)[0].width == 3);
+	CHECK(spans.RowBegin(0)[1].x == 8);
+	CHECK(spans.RowBegin(0)[1].width == 1);
+
+	CHECK(spans.RowBegin(1) == spans.RowEnd(1));
+
+	REQUIRE(spans.RowEnd(2) - spans.RowBegin(2) == 1);
+	CHECK(spans.RowBegin(2)->x == 0);
+	CHECK(spans.RowBegin(2)->width == 10);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,44 @@
+#include "regex_cache.h"
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("RegexCache");
+
+TEST_CASE("Reuse") {
+	RegexCache::Clear();
+
+	auto r1 = RegexCache::Get("a+b");
+	REQUIRE(r1 != nullptr);
+	REQUIRE(std::regex_match("aaab", *r1));
+
+	auto r2 = RegexCache::Get("a+b");
+	REQUIRE_EQ(r1, r2);
+
+	auto r3 = RegexCache::Get("a+b", std::regex::ECMAScript | std::regex::icase);
+	REQUIRE(r3 != nullptr);
+	REQUIRE_NE(r1, r3);
+	REQUIRE(std::regex_match("AAB", *r3));
+}
+
+TEST_CASE("Invalid") {
+	RegexCache::Clear();
+
+	REQUIRE(RegexCache::Get("a(b") == nullptr);
+	REQUIRE(RegexCache::Get("[") == nullptr);
+}
+
+TEST_CASE("Eviction") {
+	RegexCache::Clear();
+
+	auto first = RegexCache::Get("x0");
+	for (int i = 1; i <= 64; ++i) {
+		RegexCache::Get("x" + std::to_string(i));
+	}
+
+	// Still usable after being evicted, a new instance is compiled
+	REQUIRE(std::regex_match("x0", *first));
+	REQUIRE_NE(RegexCache::Get("x0"), first);
+
+	RegexCache::Clear();
+}
+
+TEST_SUITE_END();
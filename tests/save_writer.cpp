@@ -0,0 +1,124 @@
+#include "save_writer.h"
+#include "filefinder.h"
+#include "graphics.h"
+#include "worker_pool.h"
+#include "doctest.h"
+#include "test_temp_dir.h"
+#include <fstream>
+#include <vector>
+#include <lcf/lsd/reader.h>
+
+namespace {
+	lcf::rpg::Save MakeSave(int save_count) {
+		lcf::rpg::Save save;
+		save.system.save_count = save_count;
+		return save;
+	}
+
+	int ReadSaveCount(const std::string& path) {
+		std::ifstream is(path, std::ios_base::binary);
+		auto save = lcf::LSD_Reader::Load(is);
+		return save ? save->system.save_count : -1;
+	}
+
+	bool Exists(const std::string& path) {
+		return std::filesystem::exists(path);
+	}
+}
+
+TEST_SUITE_BEGIN("SaveWriter");
+
+TEST_CASE("WithoutWorkers") {
+	const int num_workers = WorkerPool::SetNumWorkers(0);
+	TestTempDir tmp("save_writer_sync");
+
+	bool result = false;
+	SaveWriter::Write(FileFinder::Root().Create(tmp.GetPath()), "Save01.lsd", MakeSave(1), [&](bool success) { result = success; });
+
+	// Written before Write returns
+	CHECK(result);
+	CHECK(!SaveWriter::IsPending());
+	CHECK(ReadSaveCount(tmp.GetPath("Save01.lsd")) == 1);
+
+	WorkerPool::SetNumWorkers(num_workers);
+}
+
+TEST_CASE("Order") {
+	TestTempDir tmp("save_writer_order");
+	auto fs = FileFinder::Root().Create(tmp.GetPath());
+
+	std::vector<int> finished;
+	for (int i = 1; i <= 5; ++i) {
+		SaveWriter::Write(fs, "Save01.lsd", MakeSave(i), [&finished, i](bool success) {
+			CHECK(success);
+			finished.push_back(i);
+		});
+	}
+	SaveWriter::Write(fs, "Save02.lsd", MakeSave(6), [&finished](bool success) {
+		CHECK(success);
+		finished.push_back(6);
+	});
+	SaveWriter::Flush();
+
+	CHECK(!SaveWriter::IsPending());
+	CHECK(finished == std::vector<int>{ 1, 2, 3, 4, 5, 6 });
+	CHECK(ReadSaveCount(tmp.GetPath("Save01.lsd")) == 5);
+	CHECK(ReadSaveCount(tmp.GetPath("Save02.lsd")) == 6);
+	CHECK(!Exists(tmp.GetPath("Save01.lsd.tmp")));
+	CHECK(!Exists(tmp.GetPath("Save02.lsd.tmp")));
+}
+
+TEST_CASE("NativeWriteFails") {
+	Graphics::Init();
+	TestTempDir tmp("save_writer_fail");
+	auto fs = FileFinder::Root().Create(tmp.GetPath());
+
+	// The temporary file cannot be created: The main thread writes the saves
+	// and the newest save wins
+	std::filesystem::create_directories(tmp.GetPath("Save01.lsd.tmp/blocked"));
+	std::vector<bool> results;
+	for (int i = 1; i <= 3; ++i) {
+		SaveWriter::Write(fs, "Save01.lsd", MakeSave(i), [&results](bool success) { results.push_back(success); });
+	}
+	SaveWriter::Flush();
+
+	CHECK(results == std::vector<bool>{ true, true, true });
+	CHECK(ReadSaveCount(tmp.GetPath("Save01.lsd")) == 3);
+
+	// The save cannot replace a directory: No temporary file is left behind
+	std::filesystem::create_directories(tmp.GetPath("Save02.lsd/blocked"));
+	bool result = true;
+	SaveWriter::Write(fs, "Save02.lsd", MakeSave(4), [&result](bool success) { result = success; });
+	SaveWriter::Flush();
+
+	CHECK(!result);
+	CHECK(!Exists(tmp.GetPath("Save02.lsd.tmp")));
+
+	// The failures do not affect later saves
+	SaveWriter::Write(fs, "Save03.lsd", MakeSave(5), [&result](bool success) { result = success; });
+	SaveWriter::Flush();
+
+	CHECK(result);
+	CHECK(ReadSaveCount(tmp.GetPath("Save03.lsd")) == 5);
+
+	Graphics::Quit();
+}
+
+TEST_CASE("FlushMakesSaveVisible") {
+	TestTempDir tmp("save_writer_visible");
+	auto fs = FileFinder::Root().Create(tmp.GetPath());
+	FileFinder::SetSaveFilesystem(fs);
+
+	// Lists the directory, the save must not be hidden by the cache
+	CHECK(!FileFinder::HasSavegame());
+
+	SaveWriter::Write(fs, "Save01.lsd", MakeSave(1), {});
+	SaveWriter::Flush();
+
+	CHECK(!SaveWriter::IsPending());
+	CHECK(FileFinder::HasSavegame());
+
+	FileFinder::SetSaveFilesystem({});
+}
+
+TEST_SUITE_END();
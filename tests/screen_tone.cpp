@@ -0,0 +1,135 @@
+#include "screen_tone.h"
+#include "bitmap.h"
+#include "drawable_list.h"
+#include "drawable_mgr.h"
+#include "pixel_format.h"
+#include <cstdlib>
+#include "doctest.h"
+
+TEST_SUITE_BEGIN("ScreenTone");
+
+namespace {
+
+constexpr int width = 64;
+constexpr int height = 4;
+
+// Opaque map with a gradient, the top row stays black like an empty map area
+BitmapRef MakeMap() {
+	auto bitmap = Bitmap::Create(width, height, true);
+	for (int y = 1; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			bitmap->FillRect(Rect(x, y, 1, 1), Color(x * 4, 255 - x * 3, (x * 37 + y * 11) % 256, 255));
+		}
+	}
+	return bitmap;
+}
+
+// Character with color key transparency
+BitmapRef MakeCharacter() {
+	auto bitmap = Bitmap::Create(width, height, true);
+	for (int y = 1; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			if ((x + y) % 3 != 0) {
+				bitmap->FillRect(Rect(x, y, 1, 1), Color((x * 53) % 256, x * 2, 200 - x, 255));
+			}
+		}
+	}
+	return bitmap;
+}
+
+// Every layer is tinted before blending like the sprite effect cache does
+BitmapRef DrawPerGraphic(const Tone& tone, Opacity opacity) {
+	auto map = MakeMap();
+	auto chara = MakeCharacter();
+	auto rect = map->GetRect();
+
+	auto map_tone = Bitmap::Create(width, height, true);
+	map_tone->ToneBlit(0, 0, *map, rect, tone, Opacity::Opaque());
+	auto chara_tone = Bitmap::Create(width, height, true);
+	chara_tone->ToneBlit(0, 0, *chara, rect, tone, Opacity::Opaque());
+
+	auto dst = Bitmap::Create(width, height, Color(0, 0, 0, 255));
+	dst->Blit(0, 0, *map_tone, rect, Opacity::Opaque());
+	dst->Blit(0, 0, *chara_tone, rect, opacity);
+	return dst;
+}
+
+// The layers are blended first and tinted by the ScreenTone
+BitmapRef DrawScreenTone(const Tone& tone, Opacity opacity) {
+	auto map = MakeMap();
+	auto chara = MakeCharacter();
+	auto rect = map->GetRect();
+
+	auto dst = Bitmap::Create(width, height, Color(0, 0, 0, 255));
+	dst->Blit(0, 0, *map, rect, Opacity::Opaque());
+	dst->Blit(0, 0, *chara, rect, opacity);
+
+	DrawableList list;
+	DrawableMgr::SetLocalList(&list);
+	{
+		ScreenTone screen_tone;
+		screen_tone.SetTone(tone);
+		screen_tone.Draw(*dst);
+	}
+	DrawableMgr::SetLocalList(nullptr);
+
+	return dst;
+}
+
+int MaxDifference(const Bitmap& a, const Bitmap& b) {
+	int diff = 0;
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			auto ca = a.GetColorAt(x, y);
+			auto cb = b.GetColorAt(x, y);
+			diff = std::max(diff, std::abs(ca.red - cb.red));
+			diff = std::max(diff, std::abs(ca.green - cb.green));
+			diff = std::max(diff, std::abs(ca.blue - cb.blue));
+			diff = std::max(diff, std::abs(ca.alpha - cb.alpha));
+		}
+	}
+	return diff;
+}
+
+}
+
+TEST_CASE("Composable") {
+	CHECK(ScreenTone::IsComposable(Tone()));
+	CHECK(ScreenTone::IsComposable(Tone(0, 0, 0, 128)));
+	CHECK(ScreenTone::IsComposable(Tone(128, 40, 90, 128)));
+
+	CHECK_FALSE(ScreenTone::IsComposable(Tone(129, 128, 128, 128)));
+	CHECK_FALSE(ScreenTone::IsComposable(Tone(128, 128, 200, 128)));
+	CHECK_FALSE(ScreenTone::IsComposable(Tone(128, 128, 128, 0)));
+	CHECK_FALSE(ScreenTone::IsComposable(Tone(100, 100, 100, 200)));
+}
+
+TEST_CASE("SameAsPerGraphic") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+
+	for (auto tone : { Tone(0, 0, 0, 128), Tone(64, 100, 128, 128), Tone(120, 30, 90, 128), Tone(128, 128, 0, 128) }) {
+		REQUIRE(ScreenTone::IsComposable(tone));
+
+		for (auto opacity : { Opacity::Opaque(), Opacity(160), Opacity(255, 96, 2) }) {
+			auto per_graphic = DrawPerGraphic(tone, opacity);
+			auto screen_tone = DrawScreenTone(tone, opacity);
+
+			// Both round after every step
+			CHECK_LE(MaxDifference(*per_graphic, *screen_tone), 2);
+		}
+	}
+}
+
+TEST_CASE("BrighterNotComposable") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+
+	// Nothing is drawn in the top row, the pass would brighten the black
+	Tone tone(200, 128, 128, 128);
+	auto per_graphic = DrawPerGraphic(tone, Opacity::Opaque());
+	auto screen_tone = DrawScreenTone(tone, Opacity::Opaque());
+
+	CHECK_EQ(per_graphic->GetColorAt(0, 0), Color(0, 0, 0, 255));
+	CHECK_NE(screen_tone->GetColorAt(0, 0), Color(0, 0, 0, 255));
+}
+
+TEST_SUITE_END();
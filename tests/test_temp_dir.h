@@ -0,0 +1,40 @@
+#ifndef EP_TEST_TEMP_DIR
+#define EP_TEST_TEMP_DIR
+
+#include <filesystem>
+#include <random>
+#include <string>
+
+/** Empty directory for tests which write files. Removed again when destroyed. */
+class TestTempDir {
+public:
+	explicit TestTempDir(const std::string& name) {
+		std::random_device rd;
+		path = std::filesystem::temp_directory_path() / ("easyrpg_" + name + "_" + std::to_string(rd()));
+		std::filesystem::remove_all(path);
+		std::filesystem::create_directories(path);
+	}
+
+	~TestTempDir() {
+		std::error_code ec;
+		std::filesystem::remove_all(path, ec);
+	}
+
+	TestTempDir(const TestTempDir&) = delete;
+	TestTempDir& operator=(const TestTempDir&) = delete;
+
+	/** @return path of the directory with forward slashes */
+	std::string GetPath() const {
+		return path.generic_string();
+	}
+
+	/** @return path of name inside the directory with forward slashes */
+	std::string GetPath(const std::string& name) const {
+		return (path / name).generic_string();
+	}
+
+private:
+	std::filesystem::path path;
+};
+
+#endif
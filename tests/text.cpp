@@ -3,6 +3,7 @@
 #include "cache.h"
 #include "bitmap.h"
 #include "font.h"
+#include <cstring>
 #include <iostream>
 #include "doctest.h"
 
@@ -31,6 +32,35 @@ TEST_CASE("TextDrawSystemStrReturn") {
 	REQUIRE_EQ(draw(3, 17, "$A $B"), Point(cwf * 2 + cwh, ch));
 }
 
+TEST_CASE("TextDrawSystemCached") {
+	Bitmap::SetFormat(format_R8G8B8A8_a().format());
+	Text::ClearCache();
+	auto font = Font::Default();
+
+	// Text drawn with a system graphic without id is not cached
+	auto system = Bitmap::Create(160, 80, Color(200, 100, 50, 255));
+	auto system_id = Bitmap::Create(160, 80, Color(200, 100, 50, 255));
+	system_id->SetId("TextDrawSystemCached");
+
+	auto check = [&](int x, int y, const auto& text, Text::Alignment align) {
+		auto expected = Bitmap::Create(width, height);
+		auto actual = Bitmap::Create(width, height);
+		auto ret = Text::Draw(*expected, x, y, *font, *system, 1, text, align);
+
+		// The second draw is served from the cache
+		for (int i = 0; i < 2; ++i) {
+			actual->Clear();
+			REQUIRE_EQ(Text::Draw(*actual, x, y, *font, *system_id, 1, text, align), ret);
+			REQUIRE_EQ(memcmp(expected->pixels(), actual->pixels(), expected->GetSize()), 0);
+		}
+	};
+
+	check(0, 0, "abc", Text::AlignLeft);
+	check(100, 20, "abc $A", Text::AlignCenter);
+	check(200, 40, "Hello", Text::AlignRight);
+	check(-4, -3, "clipped", Text::AlignLeft);
+}
+
 TEST_CASE("TextDrawColorStrReturn") {
 	Bitmap::SetFormat(format_R8G8B8A8_a().format());
 	auto font = Font::Default();